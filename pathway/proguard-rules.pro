@@ -1,3 +1,23 @@
 -keepclasseswithmembers class dev.romainguy.graphics.path.** {
     native <methods>;
 }
+
+-keep interface dev.romainguy.graphics.path.RowProvider {
+    void getRow(int, int[]);
+}
+
+-keep class dev.romainguy.graphics.path.TracedContours {
+    <init>(float[], int[], int[], int[], float[]);
+}
+
+-keep class dev.romainguy.graphics.path.PackedPath {
+    <init>(byte[], float[], float[], int);
+}
+
+-keep class dev.romainguy.graphics.path.PackedIntersections {
+    <init>(float[], int[]);
+}
+
+-keep class dev.romainguy.graphics.path.TracedComponents {
+    <init>(dev.romainguy.graphics.path.TracedContours, int[], int[]);
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.core.graphics.applyCanvas
+import androidx.core.graphics.createBitmap
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+import java.nio.ByteBuffer
+
+@RunWith(AndroidJUnit4::class)
+class BatchTest {
+    @Test
+    fun matchesToPaths() {
+        val bitmaps = (1..50).map { i ->
+            createBitmap(10 + i, 10 + i).applyCanvas {
+                drawCircle(5.0f + i / 2.0f, 5.0f + i / 2.0f, i / 3.0f + 2.0f, Paint())
+                drawRect(0.0f, 0.0f, 3.0f, 3.0f, Paint())
+            }
+        }
+
+        val traced = ArrayList<Int>()
+        val results = traceAll(bitmaps.map { TraceRequest(it) }) { index, _ -> traced.add(index) }
+
+        assertEquals(bitmaps.size, results.size)
+        assertEquals((0 until bitmaps.size).toList(), traced.sorted())
+        results.forEachIndexed { index, paths ->
+            val expected = bitmaps[index].toPaths()
+            assertEquals(expected.size, paths.size)
+            expected.zip(paths).forEach { (e, p) -> assertPathEquals(e, p) }
+        }
+    }
+
+    @Test
+    fun mixedRequests() {
+        val opaque = createBitmap(10, 10, Bitmap.Config.ARGB_8888).apply { setHasAlpha(false) }
+        val rgb565 = createBitmap(10, 10, Bitmap.Config.RGB_565)
+        val buffer = ByteBuffer.allocateDirect(20 * 20 * 4)
+        for (y in 5 until 15) {
+            for (x in 5 until 15) buffer.put((y * 20 + x) * 4 + 3, 0xff.toByte())
+        }
+
+        val results = traceAll(
+            listOf(
+                TraceRequest(opaque),
+                TraceRequest(rgb565),
+                TraceRequest(buffer, 20, 20, minAngle = 0.0f)
+            )
+        )
+
+        assertEquals(1, results[0].size)
+        assertEquals(1, results[1].size)
+
+        val expected = createBitmap(20, 20).applyCanvas {
+            drawRect(5.0f, 5.0f, 15.0f, 15.0f, Paint())
+        }.toPaths(minAngle = 0.0f)
+        assertEquals(expected.size, results[2].size)
+        assertPathEquals(expected[0], results[2][0])
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun indirectBuffer() {
+        TraceRequest(ByteBuffer.allocate(16), 2, 2)
+    }
+}
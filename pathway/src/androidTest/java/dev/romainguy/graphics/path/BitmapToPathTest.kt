@@ -17,6 +17,7 @@
 package dev.romainguy.graphics.path
 
 import android.graphics.*
+import android.os.Build
 import androidx.core.graphics.applyCanvas
 import androidx.core.graphics.createBitmap
 import androidx.test.ext.junit.runners.AndroidJUnit4
@@ -75,4 +76,163 @@ class BitmapToPathTest {
         val paths = bitmap.toPaths()
         assertEquals(2, paths.size)
     }
+
+    @Test
+    fun diagonalPixels() {
+        // Pixels touching by a corner along either diagonal, the saddle cases of marching
+        // squares, are traced as separate closed contours
+        for (flip in listOf(false, true)) {
+            val bitmap = createBitmap(6, 6).apply {
+                setPixel(if (flip) 2 else 3, 2, Color.BLACK)
+                setPixel(if (flip) 3 else 2, 3, Color.BLACK)
+            }
+
+            val paths = bitmap.toPaths(minAngle = 0.0f)
+            assertEquals(2, paths.size)
+            for (path in paths) {
+                val segments = path.iterator().asSequence().toList()
+                assertEquals(PathSegment.Type.Move, segments.first().type)
+                assertEquals(segments.first().points[0], segments.last().points.last())
+            }
+        }
+    }
+
+    @Test
+    fun manyPaths() {
+        val bitmap = createBitmap(100, 100).applyCanvas {
+            for (y in 0 until 25) {
+                for (x in 0 until 25) {
+                    drawRect(x * 4.0f, y * 4.0f, x * 4.0f + 2.0f, y * 4.0f + 2.0f, Paint())
+                }
+            }
+        }
+
+        val paths = bitmap.toPaths()
+        assertEquals(625, paths.size)
+        assertPathEquals(bitmap.toPath(), paths.fold(Path()) { path, p ->
+            path.apply { addPath(p) }
+        })
+    }
+
+    @Test
+    fun rowProvider() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawCircle(25.0f, 25.0f, 12.0f, Paint())
+            drawRect(2.0f, 2.0f, 8.0f, 8.0f, Paint())
+        }
+
+        val provider = RowProvider { y, row ->
+            bitmap.getPixels(row, 0, bitmap.width, 0, y, bitmap.width, 1)
+        }
+
+        assertPathEquals(bitmap.toPath(), provider.toPath(bitmap.width, bitmap.height))
+        assertEquals(2, provider.toPaths(bitmap.width, bitmap.height).size)
+    }
+
+    @Test
+    fun rowProviderException() {
+        val provider = RowProvider { y, _ -> if (y == 4) throw IllegalStateException() }
+        assertThrows(IllegalStateException::class.java) { provider.toPath(10, 10) }
+    }
+
+    @Test
+    fun nonArgbBitmap() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawRect(2.0f, 2.0f, 8.0f, 8.0f, Paint())
+            drawRect(20.0f, 20.0f, 28.0f, 28.0f, Paint())
+        }
+
+        assertPathEquals(
+            bitmap.toPath(),
+            bitmap.copy(Bitmap.Config.ALPHA_8, false).toPath()
+        )
+    }
+
+    @Test
+    fun wideAlphaBitmaps() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawRect(2.0f, 2.0f, 30.0f, 30.0f, Paint().apply { alpha = 64 })
+            drawRect(20.0f, 20.0f, 45.0f, 45.0f, Paint())
+        }
+
+        val configs = mutableListOf(Bitmap.Config.ALPHA_8)
+        if (Build.VERSION.SDK_INT >= 26) configs += Bitmap.Config.RGBA_F16
+        if (Build.VERSION.SDK_INT >= 33) configs += Bitmap.Config.RGBA_1010102
+
+        val thresholds = floatArrayOf(0.0f, 0.5f)
+        for (config in configs) {
+            val copy = bitmap.copy(config, false)
+            for (threshold in thresholds) {
+                assertPathEquals(bitmap.toPath(threshold), copy.toPath(threshold))
+            }
+            val levels = copy.toPathLevels(thresholds)
+            for (i in thresholds.indices) {
+                assertPathEquals(bitmap.toPath(thresholds[i]), levels[i])
+            }
+        }
+    }
+
+    @Test
+    fun pathLevels() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawRect(2.0f, 2.0f, 30.0f, 30.0f, Paint().apply { alpha = 64 })
+            drawCircle(25.0f, 25.0f, 12.0f, Paint().apply { alpha = 160 })
+            drawRect(20.0f, 20.0f, 28.0f, 28.0f, Paint())
+        }
+
+        val thresholds = floatArrayOf(0.0f, 0.5f, 0.9f)
+        val levels = bitmap.toPathLevels(thresholds)
+
+        assertEquals(thresholds.size, levels.size)
+        for (i in thresholds.indices) {
+            assertPathEquals(bitmap.toPath(thresholds[i]), levels[i])
+        }
+
+        val provider = RowProvider { y, row ->
+            bitmap.getPixels(row, 0, bitmap.width, 0, y, bitmap.width, 1)
+        }
+        val rowLevels = provider.toPathLevels(bitmap.width, bitmap.height, thresholds)
+        for (i in thresholds.indices) {
+            assertPathEquals(levels[i], rowLevels[i])
+        }
+
+        assertThrows(IllegalArgumentException::class.java) {
+            bitmap.toPathLevels(floatArrayOf(0.5f, 0.0f))
+        }
+    }
+
+    @Test
+    fun borderFollowing() {
+        // Straight borders produce a single segment, even without simplification
+        val opaque = createBitmap(10, 10).applyCanvas { drawColor(0xffff0000.toInt()) }
+        val segments = opaque.toPath(minAngle = 0.0f, method = TracingMethod.BorderFollowing)
+            .iterator().asSequence().toList()
+        assertEquals(5, segments.size)
+        assertEquals(PathSegment.Type.Move, segments[0].type)
+        assertTrue(segments.drop(1).all { it.type == PathSegment.Type.Line })
+
+        val bitmap = createBitmap(100, 100).applyCanvas {
+            for (y in 0 until 10) {
+                for (x in 0 until 10) {
+                    drawCircle(x * 10.0f + 5.0f, y * 10.0f + 5.0f, 3.0f, Paint())
+                }
+            }
+        }
+
+        val marched = bitmap.toPaths(minAngle = 0.0f)
+        val followed = bitmap.toPaths(minAngle = 0.0f, method = TracingMethod.BorderFollowing)
+        assertEquals(100, followed.size)
+        assertEquals(marched.size, followed.size)
+        assertTrue(
+            followed.sumOf { it.iterator().size() } < marched.sumOf { it.iterator().size() }
+        )
+
+        val provider = RowProvider { y, row ->
+            bitmap.getPixels(row, 0, bitmap.width, 0, y, bitmap.width, 1)
+        }
+        assertPathEquals(
+            bitmap.toPath(method = TracingMethod.BorderFollowing),
+            provider.toPath(bitmap.width, bitmap.height, method = TracingMethod.BorderFollowing)
+        )
+    }
 }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class ComplexityTest {
+    @Test
+    fun emptyPath() {
+        val complexity = Path().complexity()
+        assertEquals(0, complexity.verbCount)
+        assertEquals(0, complexity.contourCount)
+        assertEquals(0, complexity.flattenedLineCount)
+        assertTrue(complexity.isFinite)
+        assertTrue(complexity.bounds.isEmpty)
+    }
+
+    @Test
+    fun rectangleAndCircle() {
+        val path = Path().apply {
+            addRect(0.0f, 0.0f, 10.0f, 20.0f, Path.Direction.CW)
+            addCircle(50.0f, 40.0f, 10.0f, Path.Direction.CW)
+        }
+
+        val complexity = path.complexity()
+        assertEquals(2, complexity.moveCount)
+        assertEquals(2, complexity.contourCount)
+        assertEquals(2, complexity.closeCount)
+        assertEquals(4, complexity.conicCount + complexity.cubicCount)
+        assertEquals(0, complexity.emptyContourCount)
+        assertEquals(0, complexity.degenerateSegmentCount)
+        assertTrue(complexity.quadraticsFromConics >= complexity.conicCount)
+        assertTrue(complexity.isFinite)
+
+        // The rectangle gives 4 lines, the circle at least one line per curve
+        assertTrue(complexity.flattenedLineCount > 8)
+
+        val bounds = complexity.bounds
+        assertEquals(0.0f, bounds.left, 1e-4f)
+        assertEquals(0.0f, bounds.top, 1e-4f)
+        assertEquals(60.0f, bounds.right, 1e-4f)
+        assertEquals(50.0f, bounds.bottom, 1e-4f)
+    }
+
+    @Test
+    fun tolerance() {
+        val path = Path().apply { addCircle(0.0f, 0.0f, 100.0f, Path.Direction.CW) }
+        val coarse = path.complexity(1.0f)
+        val fine = path.complexity(0.01f)
+        assertTrue(fine.flattenedLineCount > coarse.flattenedLineCount)
+        assertTrue(fine.quadraticsFromConics >= coarse.quadraticsFromConics)
+    }
+
+    @Test
+    fun degenerateData() {
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            lineTo(10.0f, 0.0f)
+            lineTo(10.0f, 0.0f)
+            moveTo(20.0f, 20.0f)
+            moveTo(30.0f, 30.0f)
+            lineTo(Float.NaN, 40.0f)
+        }
+
+        val complexity = path.complexity()
+        assertEquals(3, complexity.contourCount)
+        assertEquals(1, complexity.emptyContourCount)
+        assertEquals(1, complexity.degenerateSegmentCount)
+        assertEquals(1, complexity.nonFiniteCount)
+        assertFalse(complexity.isFinite)
+        assertEquals(30.0f, complexity.bounds.right, 1e-4f)
+        assertEquals(30.0f, complexity.bounds.bottom, 1e-4f)
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun invalidTolerance() {
+        Path().complexity(0.0f)
+    }
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.core.graphics.applyCanvas
+import androidx.core.graphics.createBitmap
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class ComponentsTest {
+    @Test
+    fun emptyBitmap() {
+        val components = createBitmap(10, 10).toConnectedComponents(labels = true)
+        assertEquals(0, components.size)
+        assertEquals(0, components.tree.size)
+        assertEquals(-1, components.componentAt(5, 5))
+    }
+
+    @Test
+    fun statistics() {
+        val paint = Paint()
+        val clear = Paint().apply { xfermode = PorterDuffXfermode(PorterDuff.Mode.CLEAR) }
+        val bitmap = createBitmap(100, 100).applyCanvas {
+            // A square with a hole, next to a rectangle
+            drawRect(10.0f, 10.0f, 60.0f, 60.0f, paint)
+            drawRect(20.0f, 20.0f, 50.0f, 50.0f, clear)
+            drawRect(70.0f, 10.0f, 90.0f, 40.0f, paint)
+            // A single pixel
+            drawRect(5.0f, 80.0f, 6.0f, 81.0f, paint)
+        }
+
+        val components = bitmap.toConnectedComponents(labels = true)
+        assertEquals(3, components.size)
+        assertEquals(4, components.tree.size)
+
+        val square = components.componentAt(15, 15)
+        assertEquals(50 * 50 - 30 * 30, components.area(square))
+        assertEquals(Rect(10, 10, 60, 60), components.bounds(square))
+        assertEquals(1, components.holes(square).size)
+        assertFalse(components.tree.isHole(components.contour(square)))
+        assertEquals(square, components.componentOf(components.holes(square)[0]))
+
+        val rectangle = components.componentAt(80, 20)
+        assertEquals(20 * 30, components.area(rectangle))
+        assertEquals(Rect(70, 10, 90, 40), components.bounds(rectangle))
+        assertTrue(components.holes(rectangle).isEmpty())
+
+        val pixel = components.componentAt(5, 80)
+        assertEquals(1, components.area(pixel))
+        assertEquals(Rect(5, 80, 6, 81), components.bounds(pixel))
+
+        // Inside the hole, and outside of the image
+        assertEquals(-1, components.componentAt(30, 30))
+        assertEquals(-1, components.componentAt(-1, 15))
+
+        val labels = components.labels!!
+        for (i in 0 until components.size) {
+            assertEquals(components.area(i), labels.count { it == i + 1 })
+            assertEquals(i, components.componentOf(components.contour(i)))
+        }
+
+        val provider = RowProvider { y, row ->
+            bitmap.getPixels(row, 0, bitmap.width, 0, y, bitmap.width, 1)
+        }
+        val rowComponents = provider.toConnectedComponents(bitmap.width, bitmap.height)
+        assertNull(rowComponents.labels)
+        assertEquals(components.size, rowComponents.size)
+        for (i in 0 until components.size) {
+            assertEquals(components.area(i), rowComponents.area(i))
+            assertEquals(components.bounds(i), rowComponents.bounds(i))
+        }
+    }
+
+    @Test
+    fun diagonalPixels() {
+        // Pixels touching by a corner are separate components, like their contours
+        val bitmap = createBitmap(4, 4).apply {
+            setPixel(1, 1, Color.BLACK)
+            setPixel(2, 2, Color.BLACK)
+        }
+
+        val components = bitmap.toConnectedComponents()
+        assertEquals(2, components.size)
+        assertEquals(2, components.tree.size)
+    }
+
+    @Test(expected = IllegalStateException::class)
+    fun labelsNotRequested() {
+        createBitmap(10, 10).toConnectedComponents().componentAt(0, 0)
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.core.graphics.applyCanvas
+import androidx.core.graphics.createBitmap
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class ContourTreeTest {
+    @Test
+    fun emptyBitmap() {
+        val tree = createBitmap(10, 10).toContourTree()
+        assertEquals(0, tree.size)
+        assertTrue(tree.roots.isEmpty())
+    }
+
+    @Test
+    fun opaqueBitmap() {
+        val tree = createBitmap(10, 10, Bitmap.Config.ARGB_8888)
+            .apply { setHasAlpha(false) }
+            .toContourTree()
+        assertEquals(1, tree.size)
+        assertEquals(-1, tree.parent(0))
+        assertEquals(100.0f, -tree.signedArea(0), 1e-3f)
+        assertEquals(Path.Direction.CCW, tree.direction(0))
+    }
+
+    // A square with a hole containing a smaller square, next to another square
+    private fun nestedShapesBitmap(): Bitmap {
+        val paint = Paint()
+        val clear = Paint().apply { xfermode = PorterDuffXfermode(PorterDuff.Mode.CLEAR) }
+        return createBitmap(100, 100).applyCanvas {
+            drawRect(10.0f, 10.0f, 60.0f, 60.0f, paint)
+            drawRect(20.0f, 20.0f, 50.0f, 50.0f, clear)
+            drawRect(30.0f, 30.0f, 40.0f, 40.0f, paint)
+            drawRect(70.0f, 10.0f, 90.0f, 30.0f, paint)
+        }
+    }
+
+    @Test
+    fun nestedShapes() {
+        val bitmap = nestedShapesBitmap()
+
+        val tree = bitmap.toContourTree()
+        assertEquals(4, tree.size)
+        assertEquals(bitmap.toPaths().size, tree.paths.size)
+
+        val roots = tree.roots
+        assertEquals(2, roots.size)
+
+        val outer = roots.first { tree.children(it).isNotEmpty() }
+        val hole = tree.children(outer).single()
+        val inner = tree.children(hole).single()
+
+        assertEquals(0, tree.depth(outer))
+        assertEquals(1, tree.depth(hole))
+        assertEquals(2, tree.depth(inner))
+        assertFalse(tree.isHole(outer))
+        assertTrue(tree.isHole(hole))
+        assertFalse(tree.isHole(inner))
+        assertEquals(outer, tree.parent(hole))
+        assertEquals(hole, tree.parent(inner))
+
+        assertEquals(Path.Direction.CCW, tree.direction(outer))
+        assertEquals(Path.Direction.CW, tree.direction(hole))
+        assertEquals(Path.Direction.CCW, tree.direction(inner))
+        assertTrue(-tree.signedArea(outer) > tree.signedArea(hole))
+        assertTrue(tree.signedArea(hole) > -tree.signedArea(inner))
+
+        val rowProviderTree = RowProvider { y, row ->
+            bitmap.getPixels(row, 0, bitmap.width, 0, y, bitmap.width, 1)
+        }.toContourTree(bitmap.width, bitmap.height)
+        for (i in 0 until tree.size) {
+            assertEquals(tree.parent(i), rowProviderTree.parent(i))
+            assertEquals(tree.signedArea(i), rowProviderTree.signedArea(i), 1e-3f)
+        }
+    }
+
+    @Test
+    fun borderFollowing() {
+        val bitmap = nestedShapesBitmap()
+
+        val marched = bitmap.toContourTree()
+        val followed = bitmap.toContourTree(method = TracingMethod.BorderFollowing)
+        assertEquals(marched.size, followed.size)
+
+        // The contours can be ordered differently, but describe the same shapes
+        val expected = (0 until marched.size)
+            .map { marched.depth(it) to marched.signedArea(it) }
+            .sortedBy { it.second }
+        val actual = (0 until followed.size)
+            .map { followed.depth(it) to followed.signedArea(it) }
+            .sortedBy { it.second }
+        for (i in expected.indices) {
+            assertEquals(expected[i].first, actual[i].first)
+            assertEquals(expected[i].second, actual[i].second, 1e-3f)
+        }
+
+        for (i in 0 until followed.size) {
+            val parent = followed.parent(i)
+            assertEquals(if (parent < 0) 0 else followed.depth(parent) + 1, followed.depth(i))
+            assertEquals(followed.isHole(i), followed.direction(i) == Path.Direction.CW)
+        }
+    }
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Matrix
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertTrue
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.hypot
+
+@RunWith(AndroidJUnit4::class)
+class ConvexHullTest {
+    @Test
+    fun zigzag() {
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            lineTo(10.0f, 20.0f)
+            lineTo(20.0f, 0.0f)
+            lineTo(30.0f, 20.0f)
+            lineTo(40.0f, 0.0f)
+        }
+
+        val hull = path.convexHullPoints()
+        assertEquals(8, hull.size)
+        val expected = setOf(0.0f to 0.0f, 40.0f to 0.0f, 30.0f to 20.0f, 10.0f to 20.0f)
+        for (i in hull.indices step 2) {
+            assertTrue(expected.contains(hull[i] to hull[i + 1]))
+        }
+    }
+
+    @Test
+    fun curves() {
+        // The control point of the quadratic is outside of the hull
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            quadTo(50.0f, 100.0f, 100.0f, 0.0f)
+            close()
+        }
+
+        val hull = path.convexHullPoints(0.01f)
+        var maxY = 0.0f
+        for (i in hull.indices step 2) maxY = maxOf(maxY, hull[i + 1])
+        assertEquals(50.0f, maxY, 0.02f)
+
+        val circle = Path().apply { addCircle(32.0f, 32.0f, 20.0f, Path.Direction.CW) }
+        val points = circle.convexHullPoints(0.01f)
+        for (i in points.indices step 2) {
+            assertEquals(20.0f, hypot(points[i] - 32.0f, points[i + 1] - 32.0f), 0.02f)
+        }
+    }
+
+    @Test
+    fun orientedBoundingBox() {
+        val matrix = Matrix().apply { setRotate(30.0f); postTranslate(50.0f, 60.0f) }
+        val path = Path().apply { addRect(-20.0f, -5.0f, 20.0f, 5.0f, Path.Direction.CW) }
+        path.transform(matrix)
+
+        val box = path.orientedBoundingBox()
+        assertEquals(50.0f, box.centerX, 1e-3f)
+        assertEquals(60.0f, box.centerY, 1e-3f)
+        assertEquals(400.0f, box.width * box.height, 1e-2f)
+
+        // The box is the rotated rectangle
+        val rectangle = floatArrayOf(-20.0f, -5.0f, 20.0f, -5.0f, 20.0f, 5.0f, -20.0f, 5.0f)
+        matrix.mapPoints(rectangle)
+        val corners = box.corners()
+        for (i in corners.indices step 2) {
+            assertTrue((rectangle.indices step 2).any { j ->
+                hypot(corners[i] - rectangle[j], corners[i + 1] - rectangle[j + 1]) < 1e-2f
+            })
+        }
+    }
+
+    @Test
+    fun emptyPath() {
+        assertEquals(0, Path().convexHullPoints().size)
+        assertTrue(Path().convexHull().isEmpty)
+        val box = Path().orientedBoundingBox()
+        assertEquals(0.0f, box.width)
+        assertEquals(0.0f, box.height)
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Color
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.abs
+import kotlin.math.hypot
+import kotlin.math.max
+import kotlin.math.min
+
+@RunWith(AndroidJUnit4::class)
+class DistanceFieldTest {
+    private fun Bitmap.alpha(x: Int, y: Int) = Color.alpha(getPixel(x, y))
+
+    private fun expected(distance: Float, range: Float) =
+        (((distance / (2.0f * range)) + 0.5f).coerceIn(0.0f, 1.0f) * 255.0f + 0.5f).toInt()
+
+    @Test
+    fun circle() {
+        val range = 4.0f
+        val path = Path().apply { addCircle(32.0f, 32.0f, 20.0f, Path.Direction.CW) }
+        val field = path.toDistanceField(64, 64, range)
+
+        assertEquals(Bitmap.Config.ALPHA_8, field.config)
+        for (y in 0 until 64) {
+            for (x in 0 until 64) {
+                val distance = 20.0f - hypot(x + 0.5f - 32.0f, y + 0.5f - 32.0f)
+                assertEquals(expected(distance, range).toFloat(), field.alpha(x, y).toFloat(), 1.0f)
+            }
+        }
+    }
+
+    @Test
+    fun fillTypes() {
+        val path = Path().apply {
+            addRect(8.0f, 8.0f, 56.0f, 56.0f, Path.Direction.CW)
+            addRect(24.0f, 24.0f, 40.0f, 40.0f, Path.Direction.CW)
+        }
+
+        var field = path.toDistanceField(64, 64)
+        assertEquals(255, field.alpha(32, 32))
+        assertEquals(255, field.alpha(16, 32))
+        assertEquals(0, field.alpha(2, 2))
+
+        path.fillType = Path.FillType.EVEN_ODD
+        field = path.toDistanceField(64, 64)
+        assertEquals(0, field.alpha(32, 32))
+        assertEquals(255, field.alpha(16, 32))
+
+        path.fillType = Path.FillType.INVERSE_EVEN_ODD
+        field = path.toDistanceField(64, 64)
+        assertEquals(255, field.alpha(32, 32))
+        assertEquals(0, field.alpha(16, 32))
+        assertEquals(255, field.alpha(2, 2))
+    }
+
+    @Test
+    fun multiChannel() {
+        val range = 4.0f
+        val path = Path().apply {
+            moveTo(8.0f, 8.0f)
+            lineTo(56.0f, 8.0f)
+            cubicTo(40.0f, 24.0f, 40.0f, 40.0f, 56.0f, 56.0f)
+            quadTo(32.0f, 40.0f, 8.0f, 56.0f)
+            close()
+        }
+        val single = path.toDistanceField(64, 64, range)
+        val multi = path.toDistanceField(64, 64, range, DistanceFieldType.MultiChannel)
+
+        assertEquals(Bitmap.Config.ARGB_8888, multi.config)
+        assertFalse(multi.isPremultiplied)
+
+        for (y in 0 until 64) {
+            for (x in 0 until 64) {
+                val color = multi.getPixel(x, y)
+                val r = Color.red(color)
+                val g = Color.green(color)
+                val b = Color.blue(color)
+                val median = max(min(r, g), min(max(r, g), b))
+
+                // The alpha channel is the single-channel field and the median of the
+                // other channels is on the same side of the outline
+                assertEquals(single.alpha(x, y), Color.alpha(color))
+                if (abs(Color.alpha(color) - 128) > 8) {
+                    assertEquals(Color.alpha(color) > 128, median > 128)
+                }
+            }
+        }
+    }
+
+    @Test
+    fun emptyPath() {
+        val field = Path().toDistanceField(16, 16)
+        for (y in 0 until 16) {
+            for (x in 0 until 16) {
+                assertEquals(0, field.alpha(x, y))
+            }
+        }
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun wrongConfig() {
+        val bitmap = Bitmap.createBitmap(16, 16, Bitmap.Config.ARGB_8888)
+        Path().toDistanceField(bitmap, type = DistanceFieldType.SingleChannel)
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertTrue
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.sqrt
+
+@RunWith(AndroidJUnit4::class)
+class IntersectionsTest {
+    @Test
+    fun lines() {
+        val a = Path().apply { moveTo(0.0f, 0.0f); lineTo(10.0f, 10.0f) }
+        val b = Path().apply { moveTo(0.0f, 10.0f); lineTo(10.0f, 0.0f) }
+
+        val intersections = a.intersections(b)
+        assertEquals(1, intersections.size)
+        with(intersections[0]) {
+            assertEquals(5.0f, x, 1e-3f)
+            assertEquals(5.0f, y, 1e-3f)
+            assertEquals(1, segment1)
+            assertEquals(0.5f, t1, 1e-3f)
+            assertEquals(1, segment2)
+            assertEquals(0.5f, t2, 1e-3f)
+        }
+    }
+
+    @Test
+    fun rectangles() {
+        val a = Path().apply { addRect(0.0f, 0.0f, 10.0f, 10.0f, Path.Direction.CW) }
+        val b = Path().apply { addRect(5.0f, 5.0f, 15.0f, 15.0f, Path.Direction.CW) }
+
+        val intersections = a.intersections(b)
+        assertEquals(2, intersections.size)
+        assertEquals(10.0f, intersections[0].x, 1e-3f)
+        assertEquals(5.0f, intersections[0].y, 1e-3f)
+        assertEquals(5.0f, intersections[1].x, 1e-3f)
+        assertEquals(10.0f, intersections[1].y, 1e-3f)
+
+        val c = Path().apply { addRect(20.0f, 20.0f, 30.0f, 30.0f, Path.Direction.CW) }
+        assertTrue(a.intersections(c).isEmpty())
+    }
+
+    @Test
+    fun circles() {
+        val a = Path().apply { addCircle(0.0f, 0.0f, 10.0f, Path.Direction.CW) }
+        val b = Path().apply { addCircle(10.0f, 0.0f, 10.0f, Path.Direction.CW) }
+
+        val intersections = a.intersections(b)
+        assertEquals(2, intersections.size)
+        for (intersection in intersections) {
+            assertEquals(5.0f, intersection.x, 1e-2f)
+            assertEquals(sqrt(75.0f), kotlin.math.abs(intersection.y), 1e-2f)
+        }
+    }
+
+    @Test
+    fun selfIntersections() {
+        val rectangle = Path().apply { addRect(0.0f, 0.0f, 10.0f, 10.0f, Path.Direction.CW) }
+        assertTrue(rectangle.selfIntersections().isEmpty())
+
+        val bowTie = Path().apply {
+            moveTo(0.0f, 0.0f)
+            lineTo(10.0f, 10.0f)
+            lineTo(10.0f, 0.0f)
+            lineTo(0.0f, 10.0f)
+            close()
+        }
+        val intersections = bowTie.selfIntersections()
+        assertEquals(1, intersections.size)
+        with(intersections[0]) {
+            assertEquals(5.0f, x, 1e-3f)
+            assertEquals(5.0f, y, 1e-3f)
+            assertEquals(1, segment1)
+            assertEquals(3, segment2)
+        }
+    }
+
+    @Test
+    fun cubicLoop() {
+        val loop = Path().apply {
+            moveTo(0.0f, 0.0f)
+            cubicTo(30.0f, 30.0f, -20.0f, 30.0f, 10.0f, 0.0f)
+        }
+
+        val intersections = loop.selfIntersections()
+        assertEquals(1, intersections.size)
+        with(intersections[0]) {
+            assertEquals(1, segment1)
+            assertEquals(1, segment2)
+            assertTrue(t1 < t2)
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Matrix
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.PI
+import kotlin.math.abs
+
+@RunWith(AndroidJUnit4::class)
+class MomentsTest {
+    @Test
+    fun rectangles() {
+        val path = Path().apply {
+            addRect(0.0f, 0.0f, 10.0f, 20.0f, Path.Direction.CW)
+            addRect(2.0f, 2.0f, 8.0f, 8.0f, Path.Direction.CCW)
+        }
+
+        val moments = path.contourMoments()
+        assertEquals(2, moments.size)
+        assertEquals(2 * ContourMoments.RecordSize, moments.values.size)
+
+        assertEquals(200.0f, moments.area(0), 1e-3f)
+        assertEquals(5.0f, moments.centroidX(0), 1e-4f)
+        assertEquals(10.0f, moments.centroidY(0), 1e-4f)
+        assertEquals(60.0f, moments.perimeter(0), 1e-4f)
+        assertEquals(10.0f * 10.0f * 10.0f * 20.0f / 12.0f, moments.mu20(0), 1e-2f)
+        assertEquals(10.0f * 20.0f * 20.0f * 20.0f / 12.0f, moments.mu02(0), 1e-2f)
+        assertEquals(0.0f, moments.mu11(0), 1e-2f)
+        assertTrue(moments.isClockwise(0))
+        assertEquals(90.0f, abs(moments.orientation(0)), 1e-3f)
+
+        assertEquals(-36.0f, moments.area(1), 1e-3f)
+        assertEquals(5.0f, moments.centroidX(1), 1e-4f)
+        assertEquals(5.0f, moments.centroidY(1), 1e-4f)
+        assertFalse(moments.isClockwise(1))
+    }
+
+    @Test
+    fun circle() {
+        val path = Path().apply { addCircle(50.0f, 40.0f, 10.0f, Path.Direction.CW) }
+
+        val moments = path.contourMoments()
+        assertEquals(1, moments.size)
+        assertEquals((PI * 100.0).toFloat(), moments.area(0), 1e-2f)
+        assertEquals(50.0f, moments.centroidX(0), 1e-3f)
+        assertEquals(40.0f, moments.centroidY(0), 1e-3f)
+        assertEquals((2.0 * PI * 10.0).toFloat(), moments.perimeter(0), 1e-2f)
+        assertEquals((PI * 10000.0 / 4.0).toFloat(), moments.mu20(0), 1.0f)
+    }
+
+    @Test
+    fun orientation() {
+        val path = Path().apply { addOval(-20.0f, -5.0f, 20.0f, 5.0f, Path.Direction.CW) }
+        path.transform(Matrix().apply { setRotate(30.0f) })
+
+        val moments = path.contourMoments()
+        assertEquals(30.0f, moments.orientation(0), 1e-2f)
+
+        val ccw = Path().apply { addOval(-20.0f, -5.0f, 20.0f, 5.0f, Path.Direction.CCW) }
+        ccw.transform(Matrix().apply { setRotate(30.0f) })
+
+        val ccwMoments = ccw.contourMoments()
+        assertFalse(ccwMoments.isClockwise(0))
+        assertEquals(30.0f, ccwMoments.orientation(0), 1e-2f)
+    }
+
+    @Test
+    fun emptyPath() {
+        assertEquals(0, Path().contourMoments().size)
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class MorphTest {
+    @Test
+    fun compatiblePaths() {
+        val from = Path().apply { addRect(0.0f, 0.0f, 10.0f, 10.0f, Path.Direction.CW) }
+        val to = Path().apply { addRect(10.0f, 10.0f, 30.0f, 30.0f, Path.Direction.CW) }
+
+        val morph = PathMorph(from, to)
+
+        assertPathEquals(from, morph.interpolate(0.0f, Path()))
+        assertPathEquals(to, morph.interpolate(1.0f, Path()))
+        assertPathEquals(
+            Path().apply { addRect(5.0f, 5.0f, 20.0f, 20.0f, Path.Direction.CW) },
+            morph.interpolate(0.5f, Path())
+        )
+    }
+
+    @Test
+    fun packedPoints() {
+        val morph = PathMorph(
+            Path().apply { moveTo(0.0f, 0.0f); lineTo(10.0f, 0.0f) },
+            Path().apply { moveTo(10.0f, 10.0f); lineTo(30.0f, 10.0f) }
+        )
+
+        assertEquals(listOf(PathSegment.Type.Move, PathSegment.Type.Line), morph.types)
+        assertEquals(4, morph.size)
+        assertArrayEquals(
+            floatArrayOf(5.0f, 5.0f, 20.0f, 5.0f),
+            morph.interpolate(0.5f),
+            1e-6f
+        )
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun incompatiblePaths() {
+        PathMorph(
+            Path().apply { moveTo(0.0f, 0.0f); lineTo(10.0f, 0.0f) },
+            Path().apply { moveTo(0.0f, 0.0f); lineTo(10.0f, 0.0f); lineTo(10.0f, 10.0f) }
+        )
+    }
+
+    @Test
+    fun normalizedPaths() {
+        val from = Path().apply { moveTo(0.0f, 0.0f); lineTo(12.0f, 0.0f) }
+        val to = Path().apply { moveTo(0.0f, 0.0f); quadTo(6.0f, 12.0f, 12.0f, 0.0f) }
+
+        assertThrows(IllegalArgumentException::class.java) { PathMorph(from, to) }
+
+        val morph = PathMorph(from, to, normalize = true)
+        assertEquals(listOf(PathSegment.Type.Move, PathSegment.Type.Cubic), morph.types)
+
+        val points = morph.interpolate(1.0f)
+        assertArrayEquals(
+            floatArrayOf(0.0f, 0.0f, 4.0f, 8.0f, 8.0f, 8.0f, 12.0f, 0.0f),
+            points,
+            1e-5f
+        )
+    }
+
+    @Test
+    fun roundRects() {
+        val from = Path().apply {
+            addRoundRect(RectF(0.0f, 0.0f, 64.0f, 64.0f), 8.0f, 8.0f, Path.Direction.CW)
+        }
+        val to = Path().apply {
+            addRoundRect(RectF(0.0f, 0.0f, 128.0f, 32.0f), 16.0f, 16.0f, Path.Direction.CW)
+        }
+
+        val morph = PathMorph(from, to)
+        val result = morph.interpolate(1.0f, Path())
+
+        val bounds = RectF()
+        result.computeBounds(bounds, true)
+        assertEquals(128.0f, bounds.width(), 1e-3f)
+        assertEquals(32.0f, bounds.height(), 1e-3f)
+    }
+}
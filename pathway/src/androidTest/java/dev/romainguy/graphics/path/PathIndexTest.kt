@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class PathIndexTest {
+    private fun createPath() = Path().apply {
+        for (i in 0 until 50) {
+            val x = i * 10.0f
+            moveTo(x, 0.0f)
+            lineTo(x + 5.0f, 2.0f)
+            quadTo(x + 6.0f, 4.0f, x + 7.0f, 6.0f)
+            if (i % 3 == 0) {
+                conicTo(x + 8.0f, 8.0f, x + 9.0f, 9.0f, 0.7f)
+            }
+            cubicTo(x + 1.0f, 10.0f, x + 2.0f, 11.0f, x + 3.0f, 12.0f)
+            if (i % 2 == 0) close()
+        }
+    }
+
+    @Test
+    fun contours() {
+        val path = createPath()
+        val index = PathIndex(path, 8)
+
+        assertEquals(path.iterator(PathIterator.ConicEvaluation.AsConic).rawSize(), index.verbCount)
+        assertEquals(50, index.contourCount)
+
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic)
+        var contour = -1
+        var verb = 0
+        while (iterator.hasNext()) {
+            if (iterator.next().type == PathSegment.Type.Move) {
+                contour++
+                assertEquals(verb, index.contourStart(contour))
+            }
+            assertEquals(contour, index.contourOf(verb))
+            verb++
+        }
+    }
+
+    @Test
+    fun seek() {
+        val path = createPath()
+        val index = PathIndex(path, 8)
+
+        val segments = path.iterator(PathIterator.ConicEvaluation.AsConic).asSequence().toList()
+
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic)
+        for (verb in listOf(0, 1, 7, 8, 9, 100, 57, 3, segments.size - 1)) {
+            iterator.seek(index, verb)
+            assertEquals(segments[verb], iterator.next())
+        }
+
+        iterator.seek(index, index.verbCount)
+        assertFalse(iterator.hasNext())
+
+        for (contour in 0 until index.contourCount) {
+            iterator.seekToContour(index, contour)
+            assertEquals(segments[index.contourStart(contour)], iterator.next())
+            assertEquals(segments[index.contourStart(contour) + 1], iterator.next())
+        }
+    }
+
+    @Test
+    fun seekConverted() {
+        val path = createPath()
+        val index = PathIndex(path)
+
+        // Stop after the first quadratic produced by the conic of the first contour,
+        // seeking must discard the other quadratics
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsQuadratics)
+        repeat(4) { iterator.next() }
+        iterator.seek(index, 0)
+        assertEquals(iterator.size(), iterator.asSequence().count())
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun otherPath() {
+        val index = PathIndex(createPath())
+        createPath().iterator().seek(index, 0)
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun outOfDate() {
+        val path = createPath()
+        val index = PathIndex(path)
+        path.lineTo(0.0f, 0.0f)
+        path.iterator().seek(index, 0)
+    }
+}
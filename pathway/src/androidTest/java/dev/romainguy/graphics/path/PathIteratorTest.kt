@@ -342,6 +342,60 @@ class PathIteratorTest {
         }
     }
 
+    @Test
+    fun conicAsCubics() {
+        val path = Path().apply {
+            addRoundRect(RectF(12.0f, 12.0f, 512.0f, 512.0f), 96.0f, 96.0f, Path.Direction.CW)
+        }
+
+        val cubics = path.iterator(PathIterator.ConicEvaluation.AsCubics)
+        val size = cubics.size()
+        var count = 0
+        for (segment in cubics) {
+            if (segment.type == PathSegment.Type.Conic) fail("Found conic, none expected: $segment")
+            if (segment.type == PathSegment.Type.Quadratic) {
+                fail("Found quadratic, none expected: $segment")
+            }
+            count++
+        }
+
+        assertEquals(size, count)
+        if (Build.VERSION.SDK_INT >= 25) {
+            assertTrue(count < path.iterator(PathIterator.ConicEvaluation.AsQuadratics).size())
+        }
+    }
+
+    @Test
+    fun cubicAsQuadratics() {
+        val path = Path().apply {
+            moveTo(12.0f, 12.0f)
+            cubicTo(512.0f, 12.0f, 12.0f, 512.0f, 512.0f, 512.0f)
+            lineTo(600.0f, 512.0f)
+            cubicTo(700.0f, 400.0f, 800.0f, 600.0f, 900.0f, 512.0f)
+        }
+
+        val iterator = path.iterator(
+            PathIterator.ConicEvaluation.AsQuadratics,
+            0.25f,
+            PathIterator.CubicEvaluation.AsQuadratics
+        )
+        val size = iterator.size()
+        var count = 0
+        var last = PointF()
+        for (segment in iterator) {
+            if (segment.type == PathSegment.Type.Cubic) fail("Found cubic, none expected: $segment")
+            if (segment.type != PathSegment.Type.Move) {
+                assertEquals(last, segment.points[0])
+            }
+            if (segment.points.isNotEmpty()) last = segment.points[segment.points.size - 1]
+            count++
+        }
+
+        assertEquals(size, count)
+        assertTrue(count > 4)
+        assertEquals(PointF(900.0f, 512.0f), last)
+    }
+
     @Test
     fun convertedConics() {
         val path1 = Path().apply {
@@ -407,6 +461,103 @@ class PathIteratorTest {
         assertEquals(10, iterator.rawSize())
         assertEquals(14, iterator.size())
     }
+
+    @Test
+    fun cleanup() {
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            lineTo(10.0f, 0.0f)
+            lineTo(10.0f, 0.0f) // Length 0
+            lineTo(20.0f, 0.05f) // Collinear within the tolerance
+            lineTo(30.0f, 0.0f)
+            quadTo(35.0f, 0.1f, 40.0f, 0.0f) // Flat
+            cubicTo(40.0f, 0.0f, 40.0f, 0.0f, 40.0f, 0.0f) // Collapsed to a point
+            lineTo(40.0f, 10.0f)
+            cubicTo(50.0f, 20.0f, 30.0f, 30.0f, 40.0f, 40.0f)
+            close()
+        }
+
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic, cleanup = true)
+        assertEquals(10, iterator.rawSize())
+        assertEquals(5, iterator.size())
+
+        assertEquals(PathSegment.Type.Move, iterator.next().type)
+
+        var segment = iterator.next()
+        assertEquals(PathSegment.Type.Line, segment.type)
+        assertEquals(PointF(0.0f, 0.0f), segment.points[0])
+        assertEquals(PointF(40.0f, 0.0f), segment.points[1])
+
+        assertEquals(PathSegment.Type.Line, iterator.peek())
+        segment = iterator.next()
+        assertEquals(PointF(40.0f, 10.0f), segment.points[1])
+
+        assertEquals(PathSegment.Type.Cubic, iterator.next().type)
+        assertEquals(PathSegment.Type.Close, iterator.next().type)
+        assertFalse(iterator.hasNext())
+        assertEquals(PathSegment.Type.Done, iterator.peek())
+    }
+
+    @Test
+    fun cleanupPreservesTurns() {
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            lineTo(10.0f, 0.0f)
+            lineTo(5.0f, 0.0f) // Turns back
+            lineTo(5.0f, 10.0f)
+        }
+
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic, cleanup = true)
+        assertEquals(4, iterator.size())
+        assertEquals(4, iterator.asSequence().count())
+    }
+
+    @Test
+    fun monotonic() {
+        val path = Path().apply {
+            moveTo(0.0f, 0.0f)
+            quadTo(10.0f, 10.0f, 20.0f, 0.0f) // Maximum in y
+            conicTo(30.0f, -10.0f, 40.0f, 0.0f, 2.0f) // Minimum in y
+            cubicTo(50.0f, -10.0f, 60.0f, 10.0f, 70.0f, 0.0f) // Minimum and maximum in y
+            lineTo(70.0f, 20.0f)
+        }
+
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic, monotonic = true)
+        assertEquals(5, iterator.rawSize())
+        assertEquals(9, iterator.size())
+
+        val segments = iterator.asSequence().toList()
+        assertEquals(
+            listOf(
+                PathSegment.Type.Move,
+                PathSegment.Type.Quadratic, PathSegment.Type.Quadratic,
+                PathSegment.Type.Conic, PathSegment.Type.Conic,
+                PathSegment.Type.Cubic, PathSegment.Type.Cubic, PathSegment.Type.Cubic,
+                PathSegment.Type.Line
+            ),
+            segments.map { it.type }
+        )
+
+        // The quadratic is split at its maximum, where the tangent is horizontal
+        assertEquals(10.0f, segments[1].points[2].x, 1e-5f)
+        assertEquals(5.0f, segments[1].points[2].y, 1e-5f)
+        assertEquals(5.0f, segments[1].points[1].y, 0.0f)
+        assertEquals(5.0f, segments[2].points[1].y, 0.0f)
+
+        // The halves of a symmetric conic share the same weight
+        assertEquals(segments[3].weight, segments[4].weight, 1e-5f)
+        assertEquals(PointF(40.0f, 0.0f), segments[4].points[2])
+
+        // Every curve is monotonic in x and y
+        for (segment in segments.filter { it.type == PathSegment.Type.Cubic }) {
+            val p = segment.points
+            for (i in 1 until p.size) {
+                assertTrue((p[i].y - p[i - 1].y) * (p[p.size - 1].y - p[0].y) >= 0.0f)
+                assertTrue((p[i].x - p[i - 1].x) * (p[p.size - 1].x - p[0].x) >= 0.0f)
+            }
+        }
+        assertEquals(PointF(70.0f, 0.0f), segments[7].points[3])
+    }
 }
 
 fun argb(alpha: Float, red: Float, green: Float, blue: Float) =
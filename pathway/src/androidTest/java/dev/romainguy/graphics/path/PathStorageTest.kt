@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class PathStorageTest {
+    @Test
+    fun emptyPath() {
+        val storage = Path().storage()
+        assertEquals(0, storage.verbCount)
+        assertEquals(0, storage.pointCount)
+        assertFalse(storage.cursor().hasNext())
+        assertEquals(PathSegment.Type.Done, storage.cursor().next(FloatArray(8)))
+    }
+
+    @Test
+    fun matchesIterator() {
+        val path = Path().apply {
+            moveTo(1.0f, 2.0f)
+            lineTo(3.0f, 4.0f)
+            quadTo(5.0f, 6.0f, 7.0f, 8.0f)
+            cubicTo(9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f)
+            close()
+            addRoundRect(RectF(0.0f, 0.0f, 100.0f, 100.0f), 20.0f, 20.0f, Path.Direction.CW)
+        }
+
+        val storage = path.storage()
+        val iterator = path.iterator(PathIterator.ConicEvaluation.AsConic)
+        assertEquals(iterator.rawSize(), storage.verbCount)
+        assertTrue(storage.conicWeightCount > 0)
+        assertTrue(storage.verbs.isReadOnly)
+
+        val cursor = storage.cursor()
+        val expected = FloatArray(8)
+        val actual = FloatArray(8)
+
+        while (iterator.hasNext()) {
+            assertTrue(cursor.hasNext())
+            assertEquals(iterator.peek(), cursor.peek())
+
+            val type = iterator.next(expected)
+            assertEquals(type, cursor.next(actual))
+            val count = when (type) {
+                PathSegment.Type.Move -> 2
+                PathSegment.Type.Line -> 4
+                PathSegment.Type.Quadratic -> 6
+                PathSegment.Type.Conic, PathSegment.Type.Cubic -> 8
+                else -> 0
+            }
+            assertArrayEquals(expected.copyOf(count), actual.copyOf(count), 0.0f)
+        }
+        assertFalse(cursor.hasNext())
+
+        cursor.reset()
+        assertEquals(PathSegment.Type.Move, cursor.next(actual))
+        assertEquals(1.0f, actual[0])
+        assertEquals(2.0f, actual[1])
+    }
+
+    @Test
+    fun validation() {
+        val path = Path().apply { addRect(0.0f, 0.0f, 10.0f, 10.0f, Path.Direction.CW) }
+        val storage = path.storage(validate = true)
+        assertTrue(storage.isValid())
+
+        val cursor = storage.cursor()
+        cursor.next(FloatArray(8))
+
+        path.lineTo(20.0f, 20.0f)
+        assertFalse(storage.isValid())
+        assertThrows(IllegalStateException::class.java) { cursor.next(FloatArray(8)) }
+    }
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Color
+import android.graphics.Path
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+import kotlin.math.PI
+
+@RunWith(AndroidJUnit4::class)
+class RasterizerTest {
+    private fun Bitmap.alpha(x: Int, y: Int) = Color.alpha(getPixel(x, y))
+
+    @Test
+    fun rectangle() {
+        // Half pixels on every side
+        val path = Path().apply { addRect(8.5f, 8.0f, 23.5f, 24.0f, Path.Direction.CW) }
+        val mask = path.toAlphaMask(32, 32)
+
+        assertEquals(Bitmap.Config.ALPHA_8, mask.config)
+        assertEquals(255, mask.alpha(16, 16))
+        assertEquals(255, mask.alpha(9, 8))
+        assertEquals(128, mask.alpha(8, 16))
+        assertEquals(128, mask.alpha(23, 16))
+        assertEquals(0, mask.alpha(7, 16))
+        assertEquals(0, mask.alpha(16, 24))
+        assertEquals(0, mask.alpha(24, 16))
+    }
+
+    @Test
+    fun circleArea() {
+        val path = Path().apply { addCircle(32.0f, 32.0f, 20.0f, Path.Direction.CW) }
+        val mask = path.toAlphaMask(64, 64)
+
+        var area = 0.0f
+        for (y in 0 until 64) {
+            for (x in 0 until 64) {
+                area += mask.alpha(x, y) / 255.0f
+            }
+        }
+        assertEquals((PI * 20.0 * 20.0).toFloat(), area, 2.0f)
+    }
+
+    @Test
+    fun fillTypes() {
+        val path = Path().apply {
+            addRect(8.0f, 8.0f, 56.0f, 56.0f, Path.Direction.CW)
+            addRect(24.0f, 24.0f, 40.0f, 40.0f, Path.Direction.CW)
+        }
+
+        var mask = path.toAlphaMask(64, 64)
+        assertEquals(255, mask.alpha(32, 32))
+        assertEquals(255, mask.alpha(16, 32))
+        assertEquals(0, mask.alpha(2, 2))
+
+        path.fillType = Path.FillType.EVEN_ODD
+        mask = path.toAlphaMask(64, 64)
+        assertEquals(0, mask.alpha(32, 32))
+        assertEquals(255, mask.alpha(16, 32))
+
+        path.fillType = Path.FillType.INVERSE_EVEN_ODD
+        mask = path.toAlphaMask(64, 64)
+        assertEquals(255, mask.alpha(32, 32))
+        assertEquals(0, mask.alpha(16, 32))
+        assertEquals(255, mask.alpha(2, 2))
+    }
+
+    @Test
+    fun clipping() {
+        // The path extends past every edge of the mask
+        val path = Path().apply {
+            moveTo(-40.0f, -10.0f)
+            lineTo(80.0f, 16.0f)
+            lineTo(-20.0f, 50.0f)
+            close()
+        }
+        val bitmap = path.toAlphaMask(32, 32)
+        val pixels = path.toAlphaMask(ByteArray(40 * 32), 32, 32, stride = 40)
+
+        for (y in 0 until 32) {
+            for (x in 0 until 32) {
+                assertEquals(bitmap.alpha(x, y), pixels[y * 40 + x].toInt() and 0xff)
+            }
+        }
+        assertEquals(255, bitmap.alpha(0, 16))
+        assertEquals(0, bitmap.alpha(31, 0))
+    }
+
+    @Test
+    fun nonFinitePoints() {
+        val rect = Path().apply { addRect(8.0f, 8.0f, 24.0f, 24.0f, Path.Direction.CW) }
+        // Every segment of the second contour has a NaN or infinite end point
+        val path = Path(rect).apply {
+            moveTo(Float.NaN, 4.0f)
+            lineTo(28.0f, Float.NaN)
+            lineTo(Float.POSITIVE_INFINITY, 28.0f)
+            quadTo(4.0f, 28.0f, Float.NaN, Float.NaN)
+            close()
+        }
+
+        val expected = rect.toAlphaMask(ByteArray(32 * 32), 32, 32)
+        val pixels = path.toAlphaMask(ByteArray(32 * 32), 32, 32)
+        assertArrayEquals(expected, pixels)
+    }
+
+    @Test
+    fun emptyPath() {
+        val pixels = Path().toAlphaMask(ByteArray(16 * 16) { 0x7f }, 16, 16)
+        assertTrue(pixels.all { it == 0.toByte() })
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun wrongConfig() {
+        val bitmap = Bitmap.createBitmap(16, 16, Bitmap.Config.ARGB_8888)
+        Path().toAlphaMask(bitmap)
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun arrayTooSmall() {
+        Path().toAlphaMask(ByteArray(16), 16, 16)
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.After
+import org.junit.Assert.*
+import org.junit.Assume.assumeTrue
+import org.junit.Before
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class StatsTest {
+    @Before
+    fun setup() {
+        assumeTrue(PathwayStats.isAvailable)
+        PathwayStats.reset()
+    }
+
+    @After
+    fun teardown() {
+        PathwayStats.enabled = false
+        PathwayStats.reset()
+    }
+
+    @Test
+    fun disabledByDefault() {
+        assertFalse(PathwayStats.enabled)
+
+        Path().apply { addRect(0.0f, 0.0f, 10.0f, 10.0f, Path.Direction.CW) }.iterator().forEach { }
+
+        assertEquals(0L, PathwayStats.snapshot().segmentsIterated)
+    }
+
+    @Test
+    fun pathIterator() {
+        PathwayStats.enabled = true
+
+        val path = Path().apply {
+            addRoundRect(RectF(0.0f, 0.0f, 100.0f, 100.0f), 20.0f, 20.0f, Path.Direction.CW)
+        }
+        val segments = path.iterator().asSequence().count()
+
+        val snapshot = PathwayStats.snapshot()
+        assertEquals(segments.toLong(), snapshot.segmentsIterated)
+        assertTrue(snapshot.conicsConverted > 0)
+        assertEquals(snapshot.conicsConverted, snapshot.quadraticsPerConic.sum())
+        assertEquals(
+            snapshot.quadraticsFromConics,
+            snapshot.quadraticsPerConic.withIndex().sumOf { (i, count) -> count shl i }
+        )
+    }
+
+    @Test
+    fun bitmapTracing() {
+        PathwayStats.enabled = true
+
+        val bitmap = Bitmap.createBitmap(64, 64, Bitmap.Config.ARGB_8888)
+        Canvas(bitmap).drawCircle(32.0f, 32.0f, 20.0f, Paint())
+        bitmap.toPath()
+
+        val snapshot = PathwayStats.snapshot()
+        assertEquals(1L, snapshot.bitmapsTraced)
+        assertTrue(snapshot.traceMarchNanos > 0)
+
+        PathwayStats.reset()
+        assertEquals(0L, PathwayStats.snapshot().bitmapsTraced)
+    }
+}
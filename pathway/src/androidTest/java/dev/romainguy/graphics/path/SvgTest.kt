@@ -21,6 +21,7 @@ import androidx.test.ext.junit.runners.AndroidJUnit4
 import org.junit.Assert.*
 import org.junit.Test
 import org.junit.runner.RunWith
+import java.io.ByteArrayOutputStream
 
 @RunWith(AndroidJUnit4::class)
 class SvgTest {
@@ -129,4 +130,124 @@ class SvgTest {
             donut.toSvg()
         )
     }
+
+    @Test
+    fun conicsAsCubics() {
+        val circle = Path().apply { addCircle(36.0f, 36.0f, 18.0f, Path.Direction.CW) }
+
+        val svg = circle.toSvg(
+            document = false,
+            conicEvaluation = PathIterator.ConicEvaluation.AsCubics
+        )
+
+        assertFalse(svg.contains('Q'))
+        assertTrue(svg.length <= circle.toSvg(document = false).length)
+    }
+
+    @Test
+    fun streaming() {
+        val path = Path().apply {
+            // Enough segments to span several batches and chunks
+            for (i in 0 until 200) {
+                addCircle(i * 4.0f, i * 2.0f, 3.0f + i, Path.Direction.CW)
+                val x = i.toFloat()
+                addRect(x, x, x * 2.0f + 1.0f, x * 3.0f + 1.0f, Path.Direction.CCW)
+            }
+            fillType = Path.FillType.EVEN_ODD
+        }
+
+        for (document in listOf(true, false)) {
+            val expected = path.toSvg(document)
+
+            val builder = StringBuilder()
+            path.toSvg(builder, document)
+            assertEquals(expected, builder.toString())
+
+            val stream = ByteArrayOutputStream()
+            path.toSvg(stream, document)
+            assertEquals(expected, stream.toString("UTF-8"))
+        }
+
+        val stream = ByteArrayOutputStream()
+        Path().toSvg(stream)
+        assertEquals(Path().toSvg(), stream.toString("UTF-8"))
+    }
+
+    @Test
+    fun parseRoundTrip() {
+        val donut = Path().apply {
+            addCircle(36.0f, 36.0f, 18.0f, Path.Direction.CW)
+            addCircle(36.0f, 36.0f, 8.0f, Path.Direction.CW)
+            addRect(2.0f, 4.0f, 8.0f, 16.0f, Path.Direction.CCW)
+        }
+
+        val packed = parseSvgPathData(donut.toSvg(document = false))
+        assertTrue(packed.isValid)
+        assertPathEquals(donut, packed.toPath())
+    }
+
+    @Test
+    fun parseCommands() {
+        val packed = parseSvgPathData(
+            "m1 1 2 2zl1-1H10V5h-1v1.5.5C1 2 3 4 5 6s7 8 9 10Q0 0 1 1t2 2",
+            PathIterator.ConicEvaluation.AsConic
+        )
+        assertTrue(packed.isValid)
+
+        val types = packed.verbs.map { PathSegment.Type.entries[it.toInt()] }
+        assertEquals(
+            listOf(
+                PathSegment.Type.Move, PathSegment.Type.Line, PathSegment.Type.Close,
+                PathSegment.Type.Move, PathSegment.Type.Line, PathSegment.Type.Line,
+                PathSegment.Type.Line, PathSegment.Type.Line, PathSegment.Type.Line,
+                PathSegment.Type.Line, PathSegment.Type.Cubic, PathSegment.Type.Cubic,
+                PathSegment.Type.Quadratic, PathSegment.Type.Quadratic
+            ),
+            types
+        )
+
+        // The relative line after the close starts from the first point of the subpath
+        assertEquals(2.0f, packed.points[6], 0.0f)
+        assertEquals(0.0f, packed.points[7], 0.0f)
+        // v1.5.5 is v1.5 followed by v.5
+        assertEquals(6.5f, packed.points[15], 0.0f)
+        assertEquals(7.0f, packed.points[17], 0.0f)
+        // The shorthand cubic reflects the previous control point
+        assertEquals(7.0f, packed.points[24], 0.0f)
+        assertEquals(8.0f, packed.points[25], 0.0f)
+    }
+
+    @Test
+    fun parseArcs() {
+        val arc = parseSvgPathData("M0 0A10 10 0 0 1 20 0", PathIterator.ConicEvaluation.AsConic)
+        assertTrue(arc.isValid)
+        assertEquals(2, arc.conicWeights.size)
+        assertEquals(0.70710677f, arc.conicWeights[0], 1e-6f)
+        assertEquals(20.0f, arc.points[arc.points.size - 2], 0.0f)
+        assertEquals(0.0f, arc.points[arc.points.size - 1], 0.0f)
+
+        // Flags do not need separators
+        val circle = parseSvgPathData("M0 0a10 10 0 1010 10")
+        assertTrue(circle.isValid)
+        assertTrue(circle.conicWeights.isEmpty())
+        val bounds = RectF()
+        circle.toPath().computeBounds(bounds, true)
+        assertEquals(-10.0f, bounds.left, 0.25f)
+        assertEquals(20.0f, bounds.bottom, 0.25f)
+    }
+
+    @Test
+    fun parseErrors() {
+        assertEquals(0, parseSvgPathData("L1 1").errorIndex)
+
+        val packed = parseSvgPathData("M0 0L1 1 2x")
+        assertFalse(packed.isValid)
+        assertEquals(10, packed.errorIndex)
+        assertEquals(2, packed.verbs.size)
+
+        assertThrows(IllegalStateException::class.java) {
+            parseSvgPathData("M0 0A1 1 0 0 0 2 0", PathIterator.ConicEvaluation.AsConic)
+                .toPath()
+        }
+    }
 }
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.*
+import androidx.core.graphics.applyCanvas
+import androidx.core.graphics.createBitmap
+import androidx.test.ext.junit.runners.AndroidJUnit4
+import org.junit.Assert.*
+import org.junit.Test
+import org.junit.runner.RunWith
+
+@RunWith(AndroidJUnit4::class)
+class TracingSessionTest {
+    @Test
+    fun initialTrace() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawRect(2.0f, 2.0f, 8.0f, 8.0f, Paint())
+            drawCircle(25.0f, 25.0f, 12.0f, Paint())
+        }
+
+        val session = TracingSession(bitmap, tileSize = 8)
+
+        assertSameShape(bitmap.toPath(), session.toPath())
+        assertEquals(2, session.toPaths().size)
+    }
+
+    @Test
+    fun update() {
+        val bitmap = createBitmap(50, 50).applyCanvas {
+            drawRect(2.0f, 2.0f, 8.0f, 8.0f, Paint())
+        }
+
+        val session = TracingSession(bitmap, tileSize = 8)
+
+        // Crosses several tile borders
+        bitmap.applyCanvas { drawRect(10.0f, 10.0f, 40.0f, 30.0f, Paint()) }
+        val path = session.update(Rect(10, 10, 40, 30))
+
+        assertSameShape(bitmap.toPath(), path)
+        assertEquals(2, session.toPaths().size)
+
+        bitmap.applyCanvas {
+            drawRect(0.0f, 0.0f, 9.0f, 9.0f, Paint().apply {
+                xfermode = PorterDuffXfermode(PorterDuff.Mode.CLEAR)
+            })
+        }
+        assertSameShape(bitmap.toPath(), session.update(0, 0, 9, 9))
+        assertEquals(1, session.toPaths().size)
+    }
+
+    @Test(expected = IllegalArgumentException::class)
+    fun nonArgbBitmap() {
+        TracingSession(createBitmap(10, 10, Bitmap.Config.ALPHA_8))
+    }
+
+    private fun assertSameShape(expected: Path, actual: Path) {
+        assertTrue(Path().apply { op(expected, actual, Path.Op.XOR) }.isEmpty)
+    }
+}
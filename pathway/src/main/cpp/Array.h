@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_ARRAY_H
+#define PATHWAY_ARRAY_H
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+// Minimal growable array. The library is built without the C++ runtime (-nostdlib++)
+// so we cannot use std::vector. Only trivially copyable types are supported since
+// storage is managed with realloc() and elements are never constructed/destructed.
+template<typename T>
+class Array {
+    static_assert(std::is_trivially_copyable<T>::value, "Array<T> requires a trivial type");
+
+public:
+    Array() noexcept { }
+
+    ~Array() noexcept { free(mData); }
+
+    Array(const Array&) = delete;
+    Array& operator=(const Array&) = delete;
+
+    int size() const noexcept { return mSize; }
+    bool empty() const noexcept { return mSize == 0; }
+
+    T* data() noexcept { return mData; }
+    const T* data() const noexcept { return mData; }
+
+    T& operator[](int index) noexcept { return mData[index]; }
+    const T& operator[](int index) const noexcept { return mData[index]; }
+
+    T& back() noexcept { return mData[mSize - 1]; }
+    const T& back() const noexcept { return mData[mSize - 1]; }
+
+    void reserve(int capacity) noexcept {
+        if (capacity > mCapacity) {
+            mData = static_cast<T*>(realloc(mData, sizeof(T) * capacity));
+            mCapacity = capacity;
+        }
+    }
+
+    // Appends count uninitialized elements and returns a pointer to the first one
+    T* grow(int count) noexcept {
+        int size = mSize + count;
+        if (size > mCapacity) {
+            reserve(size < 16 ? 16 : size + (size >> 1));
+        }
+        T* p = mData + mSize;
+        mSize = size;
+        return p;
+    }
+
+    void push(const T& value) noexcept { *grow(1) = value; }
+
+    void append(const T* values, int count) noexcept {
+        memcpy(grow(count), values, sizeof(T) * count);
+    }
+
+    void pop() noexcept { mSize--; }
+
+    void resize(int size) noexcept {
+        reserve(size);
+        mSize = size;
+    }
+
+    void clear() noexcept { mSize = 0; }
+
+private:
+    T* mData = nullptr;
+    int mSize = 0;
+    int mCapacity = 0;
+};
+
+#endif //PATHWAY_ARRAY_H
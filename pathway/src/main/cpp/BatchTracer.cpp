@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BatchTracer.h"
+
+#include "Stats.h"
+#include "Tracer.h"
+
+#include <cstdlib>
+#include <new>
+
+#include <unistd.h>
+
+BatchTracer::BatchTracer(int count) noexcept
+        : mCount(count),
+          mItems(static_cast<BatchItem*>(malloc(sizeof(BatchItem) * count))),
+          mCompleted(static_cast<int*>(malloc(sizeof(int) * count))) {
+    for (int i = 0; i < count; i++) {
+        new(&mItems[i]) BatchItem();
+    }
+    pthread_mutex_init(&mLock, nullptr);
+    pthread_cond_init(&mCondition, nullptr);
+}
+
+BatchTracer::~BatchTracer() noexcept {
+    mCancelled.store(true, std::memory_order_relaxed);
+    for (int i = 0; i < mThreadCount; i++) {
+        pthread_join(mThreads[i], nullptr);
+    }
+    free(mThreads);
+
+    pthread_cond_destroy(&mCondition);
+    pthread_mutex_destroy(&mLock);
+
+    for (int i = 0; i < mCount; i++) {
+        mItems[i].~BatchItem();
+    }
+    free(mItems);
+    free(mCompleted);
+}
+
+void BatchTracer::start(int threadCount) noexcept {
+    if (threadCount <= 0) {
+        threadCount = int(sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    if (threadCount > mCount) threadCount = mCount;
+    if (threadCount < 1) threadCount = 1;
+
+    mThreads = static_cast<pthread_t*>(malloc(sizeof(pthread_t) * threadCount));
+    for (int i = 0; i < threadCount; i++) {
+        if (pthread_create(&mThreads[mThreadCount], nullptr, run, this) == 0) {
+            mThreadCount++;
+        }
+    }
+
+    // If no thread could be created, the items are traced by next() on the caller's thread
+}
+
+void* BatchTracer::run(void* tracer_) noexcept {
+    auto* tracer = static_cast<BatchTracer*>(tracer_);
+    while (!tracer->mCancelled.load(std::memory_order_relaxed)) {
+        const int index = tracer->mNextItem.fetch_add(1, std::memory_order_relaxed);
+        if (index >= tracer->mCount) break;
+
+        tracer->trace(tracer->mItems[index]);
+
+        pthread_mutex_lock(&tracer->mLock);
+        tracer->mCompleted[tracer->mCompletedCount++] = index;
+        pthread_cond_signal(&tracer->mCondition);
+        pthread_mutex_unlock(&tracer->mLock);
+    }
+    return nullptr;
+}
+
+void BatchTracer::trace(BatchItem& item) noexcept {
+    PATHWAY_TRACE("pathway::BatchTracer::trace");
+    addStat(Stat::BitmapsTraced, 1);
+
+    Rgba8888Source data = { item.pixels, item.stride, &item.threshold, 1 };
+    RowSource source = { item.width, item.height, &data, Rgba8888Source::readRow };
+
+    if (item.minAngle < 1.0f) {
+        traceContours(source, item.contours);
+        return;
+    }
+
+    // Simplify the contours here rather than on the caller's thread
+    ContourSet contours;
+    traceContours(source, contours);
+    for (int i = 0; i < contours.size(); i++) {
+        const Contour contour = contours[i];
+        Point* points = item.contours.addContour(contour.count);
+        item.contours.truncateLast(simplify(contour, item.minAngle, points));
+    }
+}
+
+int BatchTracer::next() noexcept {
+    if (mReturnedCount == mCount) return -1;
+
+    if (mThreadCount == 0) {
+        const int index = mReturnedCount++;
+        trace(mItems[index]);
+        return index;
+    }
+
+    pthread_mutex_lock(&mLock);
+    while (mReturnedCount == mCompletedCount) {
+        pthread_cond_wait(&mCondition, &mLock);
+    }
+    const int index = mCompleted[mReturnedCount++];
+    pthread_mutex_unlock(&mLock);
+
+    return index;
+}
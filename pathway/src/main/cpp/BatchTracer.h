@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_BATCH_TRACER_H
+#define PATHWAY_BATCH_TRACER_H
+
+#include "Contours.h"
+
+#include <atomic>
+
+#include <pthread.h>
+#include <stdint.h>
+
+// An image to trace as part of a batch, and the contours found in that image
+struct BatchItem {
+    // RGBA_8888 pixels
+    const uint8_t* pixels;
+    uint32_t stride;
+    int width;
+    int height;
+    uint8_t threshold;
+    // Contours are simplified if minAngle is >= 1
+    float minAngle;
+    ContourSet contours;
+};
+
+// Traces a list of images on a pool of threads. Threads pull the next image to trace
+// from a shared counter, which balances the load across threads whether the images
+// are large or tiny, and finished images are handed back in completion order by
+// next(), which lets the caller consume results while other images are still traced.
+class BatchTracer {
+public:
+    explicit BatchTracer(int count) noexcept;
+    // Stops the threads as soon as they finish their current image
+    ~BatchTracer() noexcept;
+
+    BatchTracer(const BatchTracer&) = delete;
+    BatchTracer& operator=(const BatchTracer&) = delete;
+
+    int size() const noexcept { return mCount; }
+
+    // The items must be initialized before calling start()
+    BatchItem& operator[](int index) noexcept { return mItems[index]; }
+
+    // Starts tracing on at most threadCount threads, or one thread per core if
+    // threadCount is <= 0
+    void start(int threadCount) noexcept;
+
+    // Waits until an item is traced and returns its index. Each item is returned once.
+    // Returns -1 when all the items were returned
+    int next() noexcept;
+
+private:
+    static void* run(void* tracer) noexcept;
+    void trace(BatchItem& item) noexcept;
+
+    const int mCount;
+    BatchItem* mItems;
+
+    pthread_t* mThreads = nullptr;
+    int mThreadCount = 0;
+
+    std::atomic<int> mNextItem{0};
+    std::atomic<bool> mCancelled{false};
+
+    pthread_mutex_t mLock;
+    pthread_cond_t mCondition;
+    // Indices of the traced items, in completion order, guarded by mLock
+    int* mCompleted;
+    int mCompletedCount = 0;
+    int mReturnedCount = 0;
+};
+
+#endif //PATHWAY_BATCH_TRACER_H
@@ -0,0 +1,489 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "BorderTracer.h"
+#include "Stats.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// Edges of a cell, the isoline enters and leaves cells through the middle of their edges
+enum Edge : int8_t {
+    Left,
+    Top,
+    Right,
+    Bottom
+};
+
+}
+
+// Edge through which the isoline leaves a cell, indexed by the key of the cell (see
+// quadKey() in Tracer.cpp) and the edge it entered through, or -1. This is the table
+// used by marchCells(), with the segments oriented the same way
+static constexpr int8_t kExits[16][4] = {
+        { -1,     -1,     -1,     -1     }, // 0x0
+        { Top,    -1,     -1,     -1     }, // 0x1
+        { -1,     Right,  -1,     -1     }, // 0x2
+        { Right,  -1,     -1,     -1     }, // 0x3
+        { -1,     -1,     -1,     Left   }, // 0x4
+        { -1,     -1,     -1,     Top    }, // 0x5
+        { -1,     Right,  -1,     Left   }, // 0x6
+        { -1,     -1,     -1,     Right  }, // 0x7
+        { -1,     -1,     Bottom, -1     }, // 0x8
+        { Top,    -1,     Bottom, -1     }, // 0x9
+        { -1,     Bottom, -1,     -1     }, // 0xA
+        { Bottom, -1,     -1,     -1     }, // 0xB
+        { -1,     -1,     Left,   -1     }, // 0xC
+        { -1,     -1,     Top,    -1     }, // 0xD
+        { -1,     Left,   -1,     -1     }, // 0xE
+        { -1,     -1,     -1,     -1     }, // 0xF
+};
+
+static inline int sign(float v) noexcept {
+    return (v > 0.0f) - (v < 0.0f);
+}
+
+static inline float clamp(float v, float maximumValue) noexcept {
+    return v < 0.0f ? 0.0f : (v > maximumValue ? maximumValue : v);
+}
+
+namespace {
+
+// Appends points to a contour, merging collinear steps. Every step of the isoline is
+// horizontal, vertical, or diagonal at 45 degrees, so two steps are collinear if the
+// signs of their coordinates match
+struct Polyline {
+    Array<Point> points;
+    int dx = 0;
+    int dy = 0;
+
+    void start(Point p) noexcept {
+        points.clear();
+        points.push(p);
+        dx = dy = 0;
+    }
+
+    void add(Point p) noexcept {
+        const Point last = points.back();
+        const int sx = sign(p.x - last.x);
+        const int sy = sign(p.y - last.y);
+        // Steps through cells clamped at the edges of the image can be empty
+        if (sx == 0 && sy == 0) return;
+        if (sx == dx && sy == dy && points.size() > 1) {
+            points.back() = p;
+        } else {
+            points.push(p);
+            dx = sx;
+            dy = sy;
+        }
+    }
+};
+
+struct Image {
+    const uint8_t* pixels; // 0 or 1, with a guard pixel on every side
+    int stride;
+    int width;
+    int height;
+    float xmax;
+    float ymax;
+
+    uint8_t at(int x, int y) const noexcept {
+        return pixels[size_t(y + 1) * stride + x + 1];
+    }
+
+    int key(int x, int y) const noexcept {
+        return at(x, y) | (at(x + 1, y) << 1) | (at(x, y + 1) << 2) | (at(x + 1, y + 1) << 3);
+    }
+
+    // Middle of the specified edge of the cell (x, y), clamped to the image like
+    // the points produced by marchCells()
+    Point crossing(int x, int y, int edge) const noexcept {
+        switch (edge) {
+            case Left:   return { clamp(float(x), xmax), clamp(float(y) + 0.5f, ymax) };
+            case Top:    return { clamp(float(x) + 0.5f, xmax), clamp(float(y), ymax) };
+            case Right:  return { clamp(float(x) + 1.0f, xmax), clamp(float(y) + 0.5f, ymax) };
+            default:     return { clamp(float(x) + 0.5f, xmax), clamp(float(y) + 1.0f, ymax) };
+        }
+    }
+};
+
+// Labels the connected components of the pixels inside the shape, one row at a time.
+// The labels of a row are provisional: two labels found to be connected are united,
+// and the statistics of the pixels are only gathered under their root label by resolve()
+class ComponentLabeler {
+public:
+    // When labels is null, only the two most recent rows of labels are kept
+    ComponentLabeler(int width, int32_t* labels) noexcept
+            : mWidth(width), mLabels(labels) {
+        if (!mLabels) {
+            mRows = static_cast<int32_t*>(calloc(size_t(width) * 2, sizeof(int32_t)));
+        }
+        // Label 0 is the background
+        mParents.push(0);
+        mStats.push({});
+    }
+
+    ~ComponentLabeler() noexcept {
+        free(mRows);
+    }
+
+    ComponentLabeler(const ComponentLabeler&) = delete;
+    ComponentLabeler& operator=(const ComponentLabeler&) = delete;
+
+    // Labels the row y of pixels, which are 0 or 1. A run of pixels takes the label of
+    // the runs it touches in the previous row, which are united
+    void labelRow(const uint8_t* pixels, int y) noexcept {
+        int32_t* current = row(y);
+        const int32_t* previous = y > 0 ? row(y - 1) : nullptr;
+
+        int x = 0;
+        while (x < mWidth) {
+            if (pixels[x] == 0) {
+                current[x++] = 0;
+                continue;
+            }
+
+            const int start = x;
+            while (x < mWidth && pixels[x] != 0) x++;
+
+            int label = 0;
+            if (previous) {
+                int last = 0;
+                for (int i = start; i < x; i++) {
+                    const int above = previous[i];
+                    if (above == 0 || above == last) continue;
+                    label = label == 0 ? above : unite(label, above);
+                    last = above;
+                }
+            }
+            if (label == 0) {
+                label = mParents.size();
+                mParents.push(label);
+                mStats.push({ 0, start, y, x, y + 1, -1 });
+            }
+
+            ComponentStats& stats = mStats[label];
+            stats.area += x - start;
+            if (start < stats.left) stats.left = start;
+            if (x > stats.right) stats.right = x;
+            if (y + 1 > stats.bottom) stats.bottom = y + 1;
+
+            for (int i = start; i < x; i++) current[i] = label;
+        }
+    }
+
+    // Provisional label of the pixel x of the row y, which must be the last labelled row
+    int32_t label(int x, int y) const noexcept {
+        return row(y)[x];
+    }
+
+    int find(int label) noexcept {
+        while (mParents[label] != label) {
+            // Path halving
+            mParents[label] = mParents[mParents[label]];
+            label = mParents[label];
+        }
+        return label;
+    }
+
+    // Gathers the statistics of every provisional label under its root, and returns
+    // them indexed by root label
+    Array<ComponentStats>& resolve() noexcept {
+        for (int label = mParents.size() - 1; label > 0; label--) {
+            const int root = find(label);
+            if (root == label) continue;
+            ComponentStats& dst = mStats[root];
+            const ComponentStats& src = mStats[label];
+            dst.area += src.area;
+            if (src.left < dst.left) dst.left = src.left;
+            if (src.top < dst.top) dst.top = src.top;
+            if (src.right > dst.right) dst.right = src.right;
+            if (src.bottom > dst.bottom) dst.bottom = src.bottom;
+        }
+        return mStats;
+    }
+
+    int labelCount() const noexcept { return mParents.size(); }
+
+private:
+    int32_t* row(int y) const noexcept {
+        return mLabels ? mLabels + size_t(y) * mWidth : mRows + size_t(y & 1) * mWidth;
+    }
+
+    // Unites the sets of the two labels and returns the root, the smallest label
+    int unite(int a, int b) noexcept {
+        a = find(a);
+        b = find(b);
+        if (a == b) return a;
+        if (a > b) {
+            const int t = a;
+            a = b;
+            b = t;
+        }
+        mParents[b] = a;
+        return a;
+    }
+
+    int mWidth;
+    int32_t* mLabels;
+    int32_t* mRows = nullptr;
+    Array<int> mParents;
+    Array<ComponentStats> mStats;
+};
+
+}
+
+// Follows the contour going through the transition between the pixels (x, y) and
+// (x + 1, y), and labels all the transitions it goes through. The transitions of row y
+// are stored in labels[y * (width + 1)], starting with the one between the left guard
+// pixel and the first pixel
+static void follow(const Image& image, int x, int y, int label, int32_t* labels,
+        Polyline& polyline) noexcept {
+    const int labelStride = image.width + 1;
+
+    // When the pixel on the right is inside, the isoline goes down through the cell
+    // below the transition, otherwise it goes up through the cell above
+    int cx = x;
+    int cy = y;
+    int entry = Top;
+    if (image.at(x, y) != 0) {
+        cy = y - 1;
+        entry = Bottom;
+    }
+    const int startX = cx;
+    const int startY = cy;
+    const int startEntry = entry;
+
+    polyline.start(image.crossing(cx, cy, entry));
+    labels[size_t(y) * labelStride + x + 1] = label;
+
+    while (true) {
+        const int exit = kExits[image.key(cx, cy)][entry];
+        polyline.add(image.crossing(cx, cy, exit));
+
+        switch (exit) {
+            case Left:   cx--; break;
+            case Top:
+                labels[size_t(cy) * labelStride + cx + 1] = label;
+                cy--;
+                break;
+            case Right:  cx++; break;
+            default:
+                labels[size_t(cy + 1) * labelStride + cx + 1] = label;
+                cy++;
+                break;
+        }
+        entry = (exit + 2) & 3;
+
+        if (cx == startX && cy == startY && entry == startEntry) break;
+    }
+}
+
+// Copies the specified closed polyline, whose last point is its first point, to a new
+// contour. When the first point is in the middle of a straight run, the contour is
+// rotated to start at the next point instead
+static void addContour(const Polyline& polyline, ContourSet& contours) noexcept {
+    const Point* points = polyline.points.data();
+    int count = polyline.points.size();
+
+    if (count > 3) {
+        const Point first = points[0];
+        const Point second = points[1];
+        const Point last = points[count - 2];
+        if (sign(second.x - first.x) == sign(first.x - last.x) &&
+                sign(second.y - first.y) == sign(first.y - last.y)) {
+            Point* dst = contours.addContour(count - 2);
+            memcpy(dst, points + 1, sizeof(Point) * (count - 2));
+            contours.appendPoints(points + 1, 1);
+            return;
+        }
+    }
+
+    contours.addContour(points, count);
+}
+
+static float signedArea(const Contour& contour) noexcept {
+    // Shoelace formula, relative to the first point, see computeHierarchy()
+    const Point o = contour.points[0];
+    float area = 0.0f;
+    for (int k = 1; k + 1 < contour.count; k++) {
+        const Point a = contour.points[k];
+        const Point b = contour.points[k + 1];
+        area += (a.x - o.x) * (b.y - o.y) - (b.x - o.x) * (a.y - o.y);
+    }
+    return area * 0.5f;
+}
+
+// Links each contour to the component of the pixel that started it, and numbers the
+// components in the order of their outer contours
+static void linkComponents(ComponentLabeler& labeler, const Array<int>& contourLabels,
+        ConnectedComponents& components, size_t pixelCount) noexcept {
+    Array<ComponentStats>& stats = labeler.resolve();
+
+    // Index of the component of each root label
+    Array<int> indices;
+    indices.resize(labeler.labelCount());
+
+    components.stats.clear();
+    for (int i = 0; i < contourLabels.size(); i++) {
+        // Outer contours are stored with a positive label, holes with a negative label
+        if (contourLabels[i] < 0) continue;
+        const int root = labeler.find(contourLabels[i]);
+        indices[root] = components.stats.size();
+        stats[root].contour = i;
+        components.stats.push(stats[root]);
+    }
+
+    components.contourComponents.resize(contourLabels.size());
+    for (int i = 0; i < contourLabels.size(); i++) {
+        const int label = contourLabels[i];
+        components.contourComponents[i] = indices[labeler.find(label < 0 ? -label : label)];
+    }
+
+    if (components.labels) {
+        Array<int32_t> table;
+        table.resize(labeler.labelCount());
+        table[0] = 0;
+        for (int label = 1; label < table.size(); label++) {
+            table[label] = indices[labeler.find(label)] + 1;
+        }
+
+        int32_t* labels = components.labels;
+        for (size_t i = 0; i < pixelCount; i++) {
+            labels[i] = table[labels[i]];
+        }
+    }
+}
+
+bool followBorders(const RowSource& source, ContourSet& contours,
+        ContourHierarchy* hierarchy, ConnectedComponents* components) noexcept {
+    PATHWAY_TRACE("pathway::followBorders");
+
+    const int w = source.width;
+    const int h = source.height;
+    const int stride = w + 2;
+
+    auto* pixels = static_cast<uint8_t*>(calloc(size_t(stride) * (h + 2), 1));
+    {
+        PATHWAY_TIMER(Stat::TraceReadNanos);
+        for (int y = 0; y < h; y++) {
+            uint8_t* row = pixels + size_t(y + 1) * stride + 1;
+            if (!source.readRow(source.context, y, 0, w, row)) {
+                free(pixels);
+                return false;
+            }
+            for (int x = 0; x < w; x++) row[x] = row[x] != 0;
+        }
+    }
+
+    PATHWAY_TIMER(Stat::TraceFollowNanos);
+
+    const Image image = { pixels, stride, w, h, float(w - 1), float(h - 1) };
+
+    // Label of the contour going through each transition, 0 if the transition was not
+    // visited yet, or if there is no transition
+    const int labelStride = w + 1;
+    auto* labels = static_cast<int32_t*>(calloc(size_t(labelStride) * h, sizeof(int32_t)));
+
+    Array<int> parents;
+    Array<int> depths;
+    Polyline polyline;
+
+    // Provisional label of the component of the pixel that started each contour
+    ComponentLabeler* labeler = nullptr;
+    Array<int> contourLabels;
+    if (components) {
+        labeler = new(malloc(sizeof(ComponentLabeler))) ComponentLabeler(w, components->labels);
+    }
+
+    for (int y = 0; y < h; y++) {
+        const uint8_t* row = pixels + size_t(y + 1) * stride;
+        const int32_t* rowLabels = labels + size_t(y) * labelStride;
+
+        if (labeler) labeler->labelRow(row + 1, y);
+
+        // Innermost contour enclosing the pixels we walk through, contours are nested
+        // so crossing a contour either enters it, or leaves it for its parent
+        int current = -1;
+
+        int x = -1;
+        while (x < w) {
+            // Skip runs of identical pixels 8 at a time
+            if (x + 9 <= w + 1) {
+                uint64_t a;
+                uint64_t b;
+                memcpy(&a, row + x + 1, sizeof(uint64_t));
+                memcpy(&b, row + x + 2, sizeof(uint64_t));
+                if (a == b) {
+                    x += 8;
+                    continue;
+                }
+            }
+
+            if (row[x + 1] != row[x + 2]) {
+                const int label = rowLabels[x + 1];
+                if (label == 0) {
+                    const int contour = contours.size();
+                    parents.push(current);
+                    depths.push(current >= 0 ? depths[current] + 1 : 0);
+
+                    follow(image, x, y, contour + 1, labels, polyline);
+                    addContour(polyline, contours);
+
+                    if (labeler) {
+                        // The pixel on the right is inside for outer contours, and the
+                        // pixel on the left for holes
+                        const bool outer = row[x + 2] != 0;
+                        const int label = labeler->label(outer ? x + 1 : x, y);
+                        contourLabels.push(outer ? label : -label);
+                    }
+
+                    current = contour;
+                } else {
+                    const int contour = label - 1;
+                    current = current == contour ? parents[contour] : contour;
+                }
+            }
+            x++;
+        }
+    }
+
+    free(labels);
+    free(pixels);
+
+    if (labeler) {
+        linkComponents(*labeler, contourLabels, *components, size_t(w) * h);
+        labeler->~ComponentLabeler();
+        free(labeler);
+    }
+
+    if (hierarchy) {
+        const int size = contours.size();
+        hierarchy->parents.clear();
+        hierarchy->parents.append(parents.data(), size);
+        hierarchy->depths.clear();
+        hierarchy->depths.append(depths.data(), size);
+        hierarchy->areas.resize(size);
+        for (int i = 0; i < size; i++) {
+            hierarchy->areas[i] = signedArea(contours[i]);
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_BORDER_TRACER_H
+#define PATHWAY_BORDER_TRACER_H
+
+#include "Array.h"
+#include "Contours.h"
+#include "Tracer.h"
+
+#include <stdint.h>
+
+// Pixel area and bounds of a connected component of the pixels inside the shape. Pixels
+// are connected to their 4 direct neighbors, like the pixels enclosed by a contour.
+// The layout must match ConnectedComponents.RecordSize in Kotlin
+struct ComponentStats {
+    int32_t area;
+    // Bounds of the pixels of the component, right and bottom are exclusive
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+    // Index of the outer contour of the component
+    int32_t contour;
+};
+
+constexpr int kComponentStatsSize = int(sizeof(ComponentStats) / sizeof(int32_t));
+
+struct ConnectedComponents {
+    // Components, in the order of their outer contours
+    Array<ComponentStats> stats;
+    // Index of the component bounded by each contour
+    Array<int> contourComponents;
+    // Optional buffer of width * height labels. When set, followBorders() writes the index
+    // of the component of each pixel + 1, or 0 for pixels outside the shape
+    int32_t* labels = nullptr;
+};
+
+// Traces the contours of the shape defined by the specified source by following its
+// borders, in the spirit of Suzuki and Abe's algorithm. A pixel is inside the shape if
+// its level is greater than 0.
+//
+// The image is scanned row by row for transitions between two horizontally adjacent
+// pixels. Each transition not yet visited starts a new contour, which is followed cell by
+// cell through the same isoline marching squares produces, and all its transitions are
+// labelled. While scanning a row, the labels of the transitions crossed so far give the
+// innermost contour enclosing the current pixel, which is the parent of the next new
+// contour. Contours are therefore produced closed, in order, with their hierarchy, and
+// without any of the joining done by ContourBuilder. Consecutive collinear steps are
+// merged as they are followed, so straight borders produce a single segment.
+//
+// The contours describe the same shapes as traceContours(), but start at different
+// points, may be ordered differently, and contain fewer points. The whole image is kept
+// in memory, using 5 bytes per pixel. Returns false if the source aborted the tracing,
+// in which case contours, hierarchy and components are left empty.
+//
+// When components is not null, the pixels are also labelled with a union-find during the
+// same scan, one run of pixels at a time, and each contour is linked to the component
+// of the pixel that started it.
+bool followBorders(const RowSource& source, ContourSet& contours,
+        ContourHierarchy* hierarchy = nullptr,
+        ConnectedComponents* components = nullptr) noexcept;
+
+#endif //PATHWAY_BORDER_TRACER_H
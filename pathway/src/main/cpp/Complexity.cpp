@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Complexity.h"
+
+#include "Geometry.h"
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+#include <cstring>
+
+// Caps the estimates of pathological curves
+constexpr float kMaxFlattenedLines = 1 << 20;
+
+static int flattenedLines(float error, float tolerance) noexcept {
+    const float count = std::ceil(std::sqrt(error / tolerance));
+    if (!(count > 1.0f)) return 1;
+    return count >= kMaxFlattenedLines ? int(kMaxFlattenedLines) : int(count);
+}
+
+static int32_t saturatedAdd(int32_t a, int32_t b) noexcept {
+    const int64_t sum = int64_t(a) + int64_t(b);
+    return sum > INT32_MAX ? INT32_MAX : int32_t(sum);
+}
+
+void analyzeComplexity(PathIterator& iterator, float tolerance,
+        PathComplexity& complexity, ControlBounds& bounds) noexcept {
+    PATHWAY_TRACE("pathway::analyzeComplexity");
+
+    memset(&complexity, 0, sizeof(PathComplexity));
+    if (!(tolerance > 0.0f)) tolerance = 0.25f;
+
+    bool hasBounds = false;
+    float left = 0.0f;
+    float top = 0.0f;
+    float right = 0.0f;
+    float bottom = 0.0f;
+
+    // Whether the current contour has a segment other than its move
+    bool drawn = false;
+    bool inContour = false;
+    Point start{};
+    Point end{};
+
+    Point points[4];
+    while (iterator.hasNext()) {
+        const Verb verb = iterator.next(points);
+        if (verb == Verb::Done) break;
+        complexity.verbCounts[int(verb)]++;
+
+        // Points of the segment, the first point of a segment other than a move was
+        // added to the path by the previous verb
+        int last = -1;
+        switch (verb) {
+            case Verb::Move: last = 0; break;
+            case Verb::Line: last = 1; break;
+            case Verb::Quadratic:
+            case Verb::Conic: last = 2; break;
+            case Verb::Cubic: last = 3; break;
+            default: break;
+        }
+        const int first = verb == Verb::Move ? 0 : 1;
+
+        // Whether all the points of the segment are finite
+        bool finite = true;
+        for (int i = 0; i <= last; i++) {
+            const Point p = points[i];
+            if (!isFinite(p.x) || !isFinite(p.y)) {
+                if (i >= first) complexity.nonFiniteCount++;
+                finite = false;
+                continue;
+            }
+            if (i < first) continue;
+            if (!hasBounds) {
+                hasBounds = true;
+                left = right = p.x;
+                top = bottom = p.y;
+            }
+            if (p.x < left) left = p.x;
+            if (p.y < top) top = p.y;
+            if (p.x > right) right = p.x;
+            if (p.y > bottom) bottom = p.y;
+        }
+
+        switch (verb) {
+            case Verb::Move:
+                if (inContour && !drawn) complexity.emptyContourCount++;
+                complexity.contourCount++;
+                inContour = true;
+                drawn = false;
+                start = end = points[0];
+                break;
+            case Verb::Line:
+                drawn = true;
+                if (finite && equals(points[0], points[1])) {
+                    complexity.degenerateSegmentCount++;
+                }
+                complexity.flattenedLineCount = saturatedAdd(complexity.flattenedLineCount, 1);
+                end = points[1];
+                break;
+            case Verb::Quadratic:
+            case Verb::Conic:
+            case Verb::Cubic: {
+                drawn = true;
+                const int degree = last;
+                bool degenerate = finite;
+                for (int i = 1; i <= degree && degenerate; i++) {
+                    if (!equals(points[i], points[0])) degenerate = false;
+                }
+                if (degenerate) complexity.degenerateSegmentCount++;
+
+                int lines = 1;
+                if (verb == Verb::Conic) {
+                    const float weight = points[3].x;
+                    if (!isFinite(weight) || !(weight > 0.0f)) {
+                        complexity.nonFiniteCount++;
+                        finite = false;
+                    }
+                    if (finite) {
+                        // Flattening the quadratics of the conic gives a tighter estimate
+                        // than a bound of the derivatives of the conic
+                        Point quadratics[1 + 2 * kMaxQuadraticCount];
+                        Conic conic(points[0], points[1], points[2], weight);
+                        const int quadraticCount = conic.splitIntoQuadratics(
+                                quadratics, conic.computeQuadraticCount(tolerance));
+                        complexity.quadraticsFromConics =
+                                saturatedAdd(complexity.quadraticsFromConics, quadraticCount);
+                        lines = 0;
+                        for (int i = 0; i < quadraticCount; i++) {
+                            lines += flattenedLines(
+                                    flatteningError(quadratics + i * 2, 2), tolerance);
+                        }
+                    }
+                } else if (finite) {
+                    lines = flattenedLines(flatteningError(points, degree), tolerance);
+                }
+                complexity.flattenedLineCount =
+                        saturatedAdd(complexity.flattenedLineCount, lines);
+                end = points[degree];
+                break;
+            }
+            case Verb::Close:
+                if (!equals(end, start)) {
+                    complexity.flattenedLineCount =
+                            saturatedAdd(complexity.flattenedLineCount, 1);
+                }
+                end = start;
+                break;
+            case Verb::Done:
+                break;
+        }
+    }
+    if (inContour && !drawn) complexity.emptyContourCount++;
+
+    bounds = { left, top, right, bottom };
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_COMPLEXITY_H
+#define PATHWAY_COMPLEXITY_H
+
+#include "PathIterator.h"
+
+#include <stdint.h>
+
+// Summary of the structure of a path, used to estimate the cost of processing it
+struct PathComplexity {
+    // Number of verbs of each type, indexed by Verb, Done excluded
+    int32_t verbCounts[6];
+    int32_t contourCount;
+    // Contours made of a single move, or of a move followed by a close
+    int32_t emptyContourCount;
+    // Number of quadratics produced by the conversion of every conic at the tolerance
+    int32_t quadraticsFromConics;
+    // Estimated number of lines produced by flattening the path at the tolerance,
+    // including the lines that close contours explicitly
+    int32_t flattenedLineCount;
+    // Lines of length 0 and curves whose points are all identical
+    int32_t degenerateSegmentCount;
+    // Points with a NaN or infinite coordinate, and conic weights that are not finite
+    // or not positive
+    int32_t nonFiniteCount;
+};
+
+// Number of ints in PathComplexity, must match PathComplexity.Size in Kotlin
+constexpr int kPathComplexitySize = sizeof(PathComplexity) / sizeof(int32_t);
+
+// Bounds of the control points of a path
+struct ControlBounds {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+// Analyzes the verbs, points and conic weights of a path in a single pass. Conics must
+// not be converted by the iterator: each conic is split into quadratics here to count
+// them, and the number of lines of each quadratic, cubic and line is estimated from a
+// bound of its second derivative, see flatteningError(), without flattening anything.
+// Non-finite points are excluded from the bounds, which are empty (all 0) when the path
+// has no finite point
+void analyzeComplexity(PathIterator& iterator, float tolerance,
+        PathComplexity& complexity, ControlBounds& bounds) noexcept;
+
+#endif //PATHWAY_COMPLEXITY_H
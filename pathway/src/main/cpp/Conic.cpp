@@ -17,7 +17,9 @@
 
 #include "Conic.h"
 
+#include "Geometry.h"
 #include "scalar.h"
+#include "Stats.h"
 
 #include "math/vec2.h"
 
@@ -37,22 +39,39 @@ constexpr bool isFinite(const Point point) noexcept {
     return a == 0.0f;
 }
 
-constexpr Point toPoint(float2 v) noexcept {
-    return { .x = v.x, .y = v.y };
-}
-
-constexpr float2 fromPoint(Point v) noexcept {
-    return float2{v.x, v.y};
-}
-
 const Point* ConicConverter::toQuadratics(
         const Point points[3], float weight, float tolerance
 ) noexcept {
     Conic conic(points[0], points[1], points[2], weight);
 
+    mCubicCount = 0;
     int count = conic.computeQuadraticCount(tolerance);
     mQuadraticCount = conic.splitIntoQuadratics(mStorage, count);
 
+    if (statsEnabled()) {
+        addStat(Stat::ConicsConverted, 1);
+        addStat(Stat::QuadraticsFromConics, mQuadraticCount);
+        // The number of quadratics is a power of 2, from 1 to 32
+        const int bucket = __builtin_ctz(uint32_t(mQuadraticCount));
+        addStat(Stat(uint32_t(Stat::ConicsTo1Quadratic) + bucket), 1);
+    }
+
+    return mStorage;
+}
+
+const Point* ConicConverter::toCubics(
+        const Point points[3], float weight, float tolerance
+) noexcept {
+    Conic conic(points[0], points[1], points[2], weight);
+
+    mQuadraticCount = 0;
+    mCubicCount = conic.splitIntoCubics(mStorage, tolerance);
+
+    if (statsEnabled()) {
+        addStat(Stat::ConicsConverted, 1);
+        addStat(Stat::CubicsFromConics, mCubicCount);
+    }
+
     return mStorage;
 }
 
@@ -159,4 +178,117 @@ commonFinitePointCheck:
     }
 
     return quadCount;
-}
\ No newline at end of file
+}
+
+// Ratio of the distance between an end point of the conic and its control point used to
+// place the control points of the cubic. This places the middle of the cubic on the middle
+// of the conic, and yields the usual cubic approximation of circular arcs
+static inline float cubicControlRatio(float weight) noexcept {
+    return 4.0f * weight / (3.0f * (1.0f + weight));
+}
+
+static void toCubic(const Conic& conic, Point cubic[3]) noexcept {
+    const float k = cubicControlRatio(conic.weight);
+    const Point* p = conic.points;
+    cubic[0] = { p[0].x + k * (p[1].x - p[0].x), p[0].y + k * (p[1].y - p[0].y) };
+    cubic[1] = { p[2].x + k * (p[1].x - p[2].x), p[2].y + k * (p[1].y - p[2].y) };
+    cubic[2] = p[2];
+}
+
+// Estimates the maximum distance between a conic and its cubic approximation. A point q
+// with barycentric coordinates (a0, a1, a2) in the triangle of the control points of the
+// conic lies on the conic iff f(q) = a1^2 - 4 w^2 a0 a2 = 0. The distance from q to the
+// conic is estimated as |f(q)| / |grad f(q)| at several points of the cubic
+static float cubicError(const Conic& conic, const Point cubic[3]) noexcept {
+    const Point p0 = conic.points[0];
+    const Point p1 = conic.points[1];
+    const Point p2 = conic.points[2];
+
+    const float det = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+    // The conic is a line, and so is the cubic
+    if (tabs(det) <= 1e-6f || !isFinite(det)) return 0.0f;
+
+    const float invDet = 1.0f / det;
+    // Gradients of the barycentric coordinates
+    const float g1x = (p2.y - p0.y) * invDet;
+    const float g1y = (p0.x - p2.x) * invDet;
+    const float g2x = (p0.y - p1.y) * invDet;
+    const float g2y = (p1.x - p0.x) * invDet;
+    const float g0x = -g1x - g2x;
+    const float g0y = -g1y - g2y;
+
+    const float w2 = 4.0f * conic.weight * conic.weight;
+
+    float error = 0.0f;
+    for (int i = 1; i < 16; i++) {
+        const float t = float(i) / 16.0f;
+        const float u = 1.0f - t;
+        const float b0 = u * u * u;
+        const float b1 = 3.0f * u * u * t;
+        const float b2 = 3.0f * u * t * t;
+        const float b3 = t * t * t;
+        const float x = b0 * p0.x + b1 * cubic[0].x + b2 * cubic[1].x + b3 * cubic[2].x - p0.x;
+        const float y = b0 * p0.y + b1 * cubic[0].y + b2 * cubic[1].y + b3 * cubic[2].y - p0.y;
+
+        const float a1 = g1x * x + g1y * y;
+        const float a2 = g2x * x + g2y * y;
+        const float a0 = 1.0f - a1 - a2;
+
+        const float f = a1 * a1 - w2 * a0 * a2;
+        const float gx = 2.0f * a1 * g1x - w2 * (a0 * g2x + a2 * g0x);
+        const float gy = 2.0f * a1 * g1y - w2 * (a0 * g2y + a2 * g0y);
+        const float gradient = std::sqrtf(gx * gx + gy * gy);
+
+        if (gradient > 0.0f) {
+            const float distance = tabs(f) / gradient;
+            if (distance > error) error = distance;
+        }
+    }
+
+    return error;
+}
+
+int Conic::splitIntoCubics(Point dstPoints[], float tolerance) const noexcept {
+    dstPoints[0] = points[0];
+
+    // Conics are split in halves until every piece is close enough to its cubic
+    Conic storage[2][kMaxCubicCount];
+    Conic* pieces = storage[0];
+    Conic* next = storage[1];
+    pieces[0] = *this;
+    int count = 1;
+
+    const bool valid = tolerance > 0.0f && isFinite(tolerance) && isFinite(points, 3);
+    if (valid) {
+        while (count < kMaxCubicCount) {
+            float error = 0.0f;
+            for (int i = 0; i < count && error <= tolerance; i++) {
+                Point cubic[3];
+                toCubic(pieces[i], cubic);
+                error = cubicError(pieces[i], cubic);
+            }
+            if (error <= tolerance) break;
+
+            for (int i = 0; i < count; i++) {
+                pieces[i].split(&next[i * 2]);
+            }
+            Conic* t = pieces;
+            pieces = next;
+            next = t;
+            count *= 2;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        toCubic(pieces[i], &dstPoints[1 + i * 3]);
+    }
+
+    const int pointCount = 1 + count * 3;
+    if (!isFinite(dstPoints, pointCount)) {
+        for (int i = 1; i < pointCount - 1; ++i) {
+            dstPoints[i] = points[1];
+        }
+    }
+
+    return count;
+}
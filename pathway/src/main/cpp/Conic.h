@@ -21,6 +21,8 @@
 
 constexpr int kMaxConicToQuadCount = 5;
 constexpr int kMaxQuadraticCount = 1 << kMaxConicToQuadCount;
+constexpr int kMaxConicToCubicCount = 5;
+constexpr int kMaxCubicCount = 1 << kMaxConicToCubicCount;
 
 class ConicConverter {
 public:
@@ -34,9 +36,20 @@ public:
         return mQuadraticCount > 0 ? mStorage : nullptr;
     }
 
+    // Approximates the conic with the smallest number of cubics (1, 2, 4, ... up to
+    // kMaxCubicCount) whose distance to the conic is less than tolerance
+    const Point* toCubics(const Point points[3], float weight, float tolerance = 0.25f) noexcept;
+
+    int cubicCount() const noexcept { return mCubicCount; }
+
+    const Point* cubics() const noexcept {
+        return mCubicCount > 0 ? mStorage : nullptr;
+    }
+
 private:
     int mQuadraticCount = 0;
-    Point mStorage[1 + 2 * kMaxQuadraticCount];
+    int mCubicCount = 0;
+    Point mStorage[1 + 3 * kMaxCubicCount];
 };
 
 struct Conic {
@@ -52,6 +65,9 @@ struct Conic {
     void split(Conic* __restrict__ dst) const noexcept;
     int computeQuadraticCount(float tolerance) const noexcept;
     int splitIntoQuadratics(Point dstPoints[], int count) const noexcept;
+    // Writes the start point followed by 3 points per cubic in dstPoints, which must be
+    // large enough to hold 1 + 3 * kMaxCubicCount points. Returns the number of cubics
+    int splitIntoCubics(Point dstPoints[], float tolerance) const noexcept;
 
     Point points[3];
     float weight;
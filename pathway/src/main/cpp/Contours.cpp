@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Contours.h"
+
+#include <cmath>
+#include <cstring>
+
+static inline bool equals(Point a, Point b) noexcept {
+    return a.x == b.x && a.y == b.y;
+}
+
+int ContourBuilder::startIndexOf(Point p) noexcept {
+    // Indexed runs were all created before the pending run and take precedence
+    int* index = mStarts.find(p);
+    if (index) return *index;
+    if (mPending >= 0 && equals(mNodes[mRuns[mPending].head].point, p)) return mPending;
+    return -1;
+}
+
+int ContourBuilder::endIndexOf(Point p) noexcept {
+    int* index = mEnds.find(p);
+    if (index) return *index;
+    if (mPending >= 0 && equals(mNodes[mRuns[mPending].tail].point, p)) return mPending;
+    return -1;
+}
+
+// Several runs can share the same end points. They are kept in a list sorted by creation
+// order, whose head is stored in the map, so that lookups return the oldest run
+void ContourBuilder::registerStart(int index) noexcept {
+    if (index == mPending) return;
+
+    const Point p = mNodes[mRuns[index].head].point;
+    int* head = mStarts.find(p);
+    if (!head) {
+        mRuns[index].nextStart = -1;
+        mStarts.insert(p, index);
+    } else if (index < *head) {
+        mRuns[index].nextStart = *head;
+        *head = index;
+    } else {
+        int previous = *head;
+        while (mRuns[previous].nextStart >= 0 && mRuns[previous].nextStart < index) {
+            previous = mRuns[previous].nextStart;
+        }
+        mRuns[index].nextStart = mRuns[previous].nextStart;
+        mRuns[previous].nextStart = index;
+    }
+}
+
+void ContourBuilder::unregisterStart(int index) noexcept {
+    if (index == mPending) return;
+
+    const Point p = mNodes[mRuns[index].head].point;
+    int* head = mStarts.find(p);
+    if (*head == index) {
+        if (mRuns[index].nextStart >= 0) {
+            *head = mRuns[index].nextStart;
+        } else {
+            mStarts.erase(p);
+        }
+    } else {
+        int previous = *head;
+        while (mRuns[previous].nextStart != index) previous = mRuns[previous].nextStart;
+        mRuns[previous].nextStart = mRuns[index].nextStart;
+    }
+}
+
+void ContourBuilder::registerEnd(int index) noexcept {
+    if (index == mPending) return;
+
+    const Point p = mNodes[mRuns[index].tail].point;
+    int* head = mEnds.find(p);
+    if (!head) {
+        mRuns[index].nextEnd = -1;
+        mEnds.insert(p, index);
+    } else if (index < *head) {
+        mRuns[index].nextEnd = *head;
+        *head = index;
+    } else {
+        int previous = *head;
+        while (mRuns[previous].nextEnd >= 0 && mRuns[previous].nextEnd < index) {
+            previous = mRuns[previous].nextEnd;
+        }
+        mRuns[index].nextEnd = mRuns[previous].nextEnd;
+        mRuns[previous].nextEnd = index;
+    }
+}
+
+void ContourBuilder::unregisterEnd(int index) noexcept {
+    if (index == mPending) return;
+
+    const Point p = mNodes[mRuns[index].tail].point;
+    int* head = mEnds.find(p);
+    if (*head == index) {
+        if (mRuns[index].nextEnd >= 0) {
+            *head = mRuns[index].nextEnd;
+        } else {
+            mEnds.erase(p);
+        }
+    } else {
+        int previous = *head;
+        while (mRuns[previous].nextEnd != index) previous = mRuns[previous].nextEnd;
+        mRuns[previous].nextEnd = mRuns[index].nextEnd;
+    }
+}
+
+void ContourBuilder::create(Point p0, Point p1) noexcept {
+    // The pending run is not the most recent one anymore
+    if (mPending >= 0) {
+        const int pending = mPending;
+        mPending = -1;
+        registerStart(pending);
+        registerEnd(pending);
+    }
+
+    const int node = mNodes.size();
+    mNodes.push({ p0, node + 1 });
+    mNodes.push({ p1, -1 });
+
+    mPending = mRuns.size();
+    mRuns.push({ node, node + 1, 2, -1, -1, true });
+}
+
+void ContourBuilder::append(int index, Point p) noexcept {
+    unregisterEnd(index);
+
+    Run& run = mRuns[index];
+    const int node = mNodes.size();
+    mNodes.push({ p, -1 });
+    mNodes[run.tail].next = node;
+    run.tail = node;
+    run.count++;
+
+    registerEnd(index);
+}
+
+void ContourBuilder::prepend(int index, Point p) noexcept {
+    unregisterStart(index);
+
+    Run& run = mRuns[index];
+    const int node = mNodes.size();
+    mNodes.push({ p, run.head });
+    run.head = node;
+    run.count++;
+
+    registerStart(index);
+}
+
+void ContourBuilder::join(int from, int to) noexcept {
+    unregisterEnd(from);
+    unregisterStart(to);
+    unregisterEnd(to);
+
+    Run& fromRun = mRuns[from];
+    Run& toRun = mRuns[to];
+    mNodes[fromRun.tail].next = toRun.head;
+    fromRun.tail = toRun.tail;
+    fromRun.count += toRun.count;
+    toRun.alive = false;
+    if (to == mPending) mPending = -1;
+
+    registerEnd(from);
+}
+
+void ContourBuilder::addLine(float x0, float y0, float x1, float y1) noexcept {
+    const Point p0 = { x0, y0 };
+    const Point p1 = { x1, y1 };
+
+    // Find the contour this new line would come from
+    const int from = endIndexOf(p0);
+    // Find the contour this new line would connect to
+    const int to = startIndexOf(p1);
+    if (from >= 0 && to >= 0) {
+        if (from != to) {
+            // Join the two contours
+            join(from, to);
+        } else {
+            // Loop the contour by appending its first point
+            append(from, p1);
+        }
+    } else if (from >= 0) {
+        // We're coming from an existing contour, append x1/y1
+        append(from, p1);
+    } else if (to >= 0) {
+        // We're going to an existing contour head, prepend x0/y0
+        prepend(to, p0);
+    } else {
+        // No contour, let's start a new one
+        create(p0, p1);
+    }
+}
+
+void ContourBuilder::build(ContourSet& contours) noexcept {
+    for (int i = 0; i < mRuns.size(); i++) {
+        const Run& run = mRuns[i];
+        if (!run.alive) continue;
+
+        Point* points = contours.addContour(run.count);
+        for (int node = run.head; node >= 0; node = mNodes[node].next) {
+            *points++ = mNodes[node].point;
+        }
+    }
+    clear();
+}
+
+void ContourBuilder::clear() noexcept {
+    mNodes.clear();
+    mRuns.clear();
+    mStarts.clear();
+    mEnds.clear();
+    mPending = -1;
+}
+
+static inline float invlength(float x, float y) noexcept {
+    return 1.0f / std::sqrtf(x * x + y * y);
+}
+
+int simplify(const Contour& contour, float tolerance, Point* dst) noexcept {
+    const Point* points = contour.points;
+    if (contour.count < 3) {
+        memcpy(dst, points, sizeof(Point) * contour.count);
+        return contour.count;
+    }
+
+    dst[0] = points[0];
+    dst[1] = points[1];
+    int count = 2;
+
+    const float minTolerance = -std::cos(tolerance * float(M_PI / 180.0));
+
+    for (int i = 2; i < contour.count; i++) {
+        const float x = points[i].x;
+        const float y = points[i].y;
+
+        float x0 = dst[count - 2].x;
+        float y0 = dst[count - 2].y;
+        float x1 = dst[count - 1].x;
+        float y1 = dst[count - 1].y;
+
+        // Quick checks for horizontal/vertical cases
+        if (x0 == x && x1 == x) {
+            dst[count - 1].y = y;
+        } else if (y0 == y && y1 == y) {
+            dst[count - 1].x = x;
+        } else {
+            x0 -= x1;
+            y0 -= y1;
+            const float l0 = invlength(x0, y0);
+
+            x1 = x - x1;
+            y1 = y - y1;
+            const float l1 = invlength(x1, y1);
+
+            const float cosAngle = x0 * l0 * x1 * l1 + y0 * l0 * y1 * l1;
+            if (cosAngle > minTolerance) {
+                dst[count++] = { x, y };
+            } else {
+                dst[count - 1] = { x, y };
+            }
+        }
+    }
+
+    // TODO: We should check the angle between the first and last point when the contour is
+    //       a closed contour
+
+    return count;
+}
+
+struct Crossing {
+    float x;
+    int contour;
+};
+
+static int compareCrossings(const void* lhs, const void* rhs) noexcept {
+    const float a = static_cast<const Crossing*>(lhs)->x;
+    const float b = static_cast<const Crossing*>(rhs)->x;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+// Invokes f(scanline, edge) for each scanline crossed by each edge of the contours. The
+// scanline j is at y = origin + 0.5 * j + 0.25, and never goes through a point
+template<typename F>
+static inline void forEachCrossing(const ContourSet& contours, float origin, F f) noexcept {
+    for (int i = 0; i < contours.size(); i++) {
+        const Contour contour = contours[i];
+        for (int k = 0; k < contour.count; k++) {
+            const Point p0 = contour.points[k];
+            const Point p1 = contour.points[k + 1 < contour.count ? k + 1 : 0];
+            const float y0 = p0.y < p1.y ? p0.y : p1.y;
+            const float y1 = p0.y < p1.y ? p1.y : p0.y;
+            const int first = int(std::ceil((y0 - origin - 0.25f) * 2.0f));
+            const int last = int(std::floor((y1 - origin - 0.25f) * 2.0f));
+            for (int j = first; j <= last; j++) {
+                const float y = origin + 0.5f * float(j) + 0.25f;
+                if (y <= y0 || y >= y1) continue;
+                f(j, i, p0.x + (y - p0.y) * (p1.x - p0.x) / (p1.y - p0.y));
+            }
+        }
+    }
+}
+
+void computeHierarchy(const ContourSet& contours, ContourHierarchy& hierarchy) noexcept {
+    const int size = contours.size();
+    hierarchy.parents.resize(size);
+    hierarchy.depths.resize(size);
+    hierarchy.areas.resize(size);
+    if (size == 0) return;
+
+    float minY = contours.points()[0].y;
+    float maxY = minY;
+    for (int i = 0; i < size; i++) {
+        const Contour contour = contours[i];
+        // Shoelace formula, relative to the first point to limit the loss of precision
+        const Point o = contour.points[0];
+        float area = 0.0f;
+        for (int k = 1; k + 1 < contour.count; k++) {
+            const Point a = contour.points[k];
+            const Point b = contour.points[k + 1];
+            area += (a.x - o.x) * (b.y - o.y) - (b.x - o.x) * (a.y - o.y);
+        }
+        for (int k = 0; k < contour.count; k++) {
+            const float y = contour.points[k].y;
+            minY = y < minY ? y : minY;
+            maxY = y > maxY ? y : maxY;
+        }
+        hierarchy.areas[i] = area * 0.5f;
+        hierarchy.parents[i] = -1;
+        hierarchy.depths[i] = -1;
+    }
+
+    // Bucket the crossings of the edges with the scanlines, by scanline
+    const float origin = std::floor(minY);
+    const int scanlineCount = int((maxY - origin) * 2.0f) + 1;
+    Array<int> offsets;
+    offsets.resize(scanlineCount + 1);
+    memset(offsets.data(), 0, sizeof(int) * (scanlineCount + 1));
+    forEachCrossing(contours, origin, [&](int j, int, float) { offsets[j + 1]++; });
+    for (int j = 0; j < scanlineCount; j++) offsets[j + 1] += offsets[j];
+
+    Array<Crossing> crossings;
+    crossings.resize(offsets[scanlineCount]);
+    Array<int> cursors;
+    cursors.append(offsets.data(), scanlineCount);
+    forEachCrossing(contours, origin, [&](int j, int contour, float x) {
+        crossings[cursors[j]++] = { x, contour };
+    });
+
+    // Along a scanline, the crossings of nested contours are balanced like parentheses.
+    // The innermost contour we are in when entering a contour for the first time is its
+    // parent. Leaving a contour also leaves the contours entered after it, which only
+    // happens when contours touch
+    Array<int> stack;
+    Array<int> positions; // Position of each contour in the stack, or -1
+    positions.resize(size);
+    memset(positions.data(), 0xff, sizeof(int) * size);
+
+    for (int j = 0; j < scanlineCount; j++) {
+        Crossing* line = crossings.data() + offsets[j];
+        const int count = offsets[j + 1] - offsets[j];
+        qsort(line, count, sizeof(Crossing), compareCrossings);
+
+        for (int k = 0; k < count; k++) {
+            const int contour = line[k].contour;
+            const int position = positions[contour];
+            if (position >= 0) {
+                while (stack.size() > position) {
+                    positions[stack.back()] = -1;
+                    stack.pop();
+                }
+            } else {
+                if (hierarchy.depths[contour] < 0) {
+                    const int parent = stack.empty() ? -1 : stack.back();
+                    hierarchy.parents[contour] = parent;
+                    hierarchy.depths[contour] = parent >= 0 ? hierarchy.depths[parent] + 1 : 0;
+                }
+                positions[contour] = stack.size();
+                stack.push(contour);
+            }
+        }
+
+        while (!stack.empty()) {
+            positions[stack.back()] = -1;
+            stack.pop();
+        }
+    }
+
+    for (int i = 0; i < size; i++) {
+        if (hierarchy.depths[i] < 0) hierarchy.depths[i] = 0;
+    }
+}
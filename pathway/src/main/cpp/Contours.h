@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_CONTOURS_H
+#define PATHWAY_CONTOURS_H
+
+#include "Array.h"
+#include "Path.h"
+#include "PointMap.h"
+
+#include <cstring>
+
+// A contour is a series of line segments. The first point should be treated as a move
+// command and subsequent points as line commands.
+struct Contour {
+    const Point* points;
+    int count;
+
+    bool startsWith(float x, float y) const noexcept {
+        return points[0].x == x && points[0].y == y;
+    }
+
+    bool endsWith(float x, float y) const noexcept {
+        return points[count - 1].x == x && points[count - 1].y == y;
+    }
+};
+
+// A list of contours whose points are stored contiguously, one contour after the other.
+class ContourSet {
+public:
+    ContourSet() noexcept { }
+
+    ContourSet(const ContourSet&) = delete;
+    ContourSet& operator=(const ContourSet&) = delete;
+
+    int size() const noexcept { return mOffsets.size(); }
+
+    Contour operator[](int index) const noexcept {
+        const int offset = mOffsets[index];
+        const int end = index + 1 < mOffsets.size() ? mOffsets[index + 1] : mPoints.size();
+        return { mPoints.data() + offset, end - offset };
+    }
+
+    // Points of all the contours, contour i starts at offsets()[i]
+    const Point* points() const noexcept { return mPoints.data(); }
+    const int* offsets() const noexcept { return mOffsets.data(); }
+    int pointCount() const noexcept { return mPoints.size(); }
+
+    // Adds a new contour of count points and returns the storage to write them to
+    Point* addContour(int count) noexcept {
+        mOffsets.push(mPoints.size());
+        return mPoints.grow(count);
+    }
+
+    void addContour(const Point* points, int count) noexcept {
+        memcpy(addContour(count), points, sizeof(Point) * count);
+    }
+
+    // Appends the specified points to the last contour
+    void appendPoints(const Point* points, int count) noexcept {
+        mPoints.append(points, count);
+    }
+
+    // Sets the number of points of the last contour, which cannot be greater than
+    // its current number of points
+    void truncateLast(int count) noexcept {
+        mPoints.resize(mOffsets.back() + count);
+    }
+
+    void clear() noexcept {
+        mPoints.clear();
+        mOffsets.clear();
+    }
+
+private:
+    Array<Point> mPoints;
+    Array<int> mOffsets;
+};
+
+// Builds contours from line segments. When a new segment is added, either a new contour
+// is created, or the segment is added to existing contours, which can lead to the fusion
+// of pairs of contours.
+//
+// The points of all the contours are stored in a shared arena as linked lists, which
+// makes adding points at either end of a contour and merging contours constant time
+// operations. The end points of the contours are indexed in hash maps.
+class ContourBuilder {
+public:
+    ContourBuilder() noexcept { }
+
+    ContourBuilder(const ContourBuilder&) = delete;
+    ContourBuilder& operator=(const ContourBuilder&) = delete;
+
+    void addLine(float x0, float y0, float x1, float y1) noexcept;
+
+    // Adds all the contours to the specified set, in the order they were created, and
+    // clears this builder
+    void build(ContourSet& contours) noexcept;
+
+    void clear() noexcept;
+
+private:
+    struct Node {
+        Point point;
+        int next;
+    };
+
+    struct Run {
+        int head;
+        int tail;
+        int count;
+        int nextStart; // Next run with the same start point
+        int nextEnd;   // Next run with the same end point
+        bool alive;
+    };
+
+    int startIndexOf(Point p) noexcept;
+    int endIndexOf(Point p) noexcept;
+
+    void registerStart(int index) noexcept;
+    void unregisterStart(int index) noexcept;
+    void registerEnd(int index) noexcept;
+    void unregisterEnd(int index) noexcept;
+
+    void create(Point p0, Point p1) noexcept;
+    void append(int index, Point p) noexcept;
+    void prepend(int index, Point p) noexcept;
+    void join(int from, int to) noexcept;
+
+    Array<Node> mNodes;
+    Array<Run> mRuns;
+    PointMap mStarts;
+    PointMap mEnds;
+    // The most recently created run is not indexed until another run is created,
+    // since most runs are extended or merged right after their creation
+    int mPending = -1;
+};
+
+// Nesting of a set of closed contours that do not intersect each other, such as the
+// contours produced by the tracer. Contours are stored in the same order as in the set.
+struct ContourHierarchy {
+    // Index of the innermost contour enclosing each contour, or -1
+    Array<int> parents;
+    // Number of contours enclosing each contour. Contours at an odd depth are holes
+    Array<int> depths;
+    // Signed area of each contour, positive when the contour is clockwise (with the y
+    // axis pointing down)
+    Array<float> areas;
+};
+
+// Computes the hierarchy of the specified contours in roughly linear time, by sweeping
+// horizontal scanlines placed between the points of the contours, which must all lie
+// on a half-pixel grid. Contours without area have no parent and a depth of 0.
+void computeHierarchy(const ContourSet& contours, ContourHierarchy& hierarchy) noexcept;
+
+// Returns a simplified copy of the specified contour into dst. The simplification is based
+// on tolerance, expressed as the minimum angle in degrees allowed between two segments.
+// Returns the number of points written in dst, which must be large enough to hold
+// contour.count points.
+int simplify(const Contour& contour, float tolerance, Point* dst) noexcept;
+
+#endif //PATHWAY_CONTOURS_H
@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ConvexHull.h"
+
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+#include <cstdlib>
+
+// Maximum number of lines a curve is flattened into
+constexpr int kMaxFlattenCount = 256;
+
+// Directions in which the first pass looks for extreme points, in counter-clockwise order
+constexpr int kDirectionCount = 8;
+constexpr float kDirections[kDirectionCount][2] = {
+        {  1.0f,  0.0f }, {  1.0f,  1.0f }, {  0.0f,  1.0f }, { -1.0f,  1.0f },
+        { -1.0f,  0.0f }, { -1.0f, -1.0f }, {  0.0f, -1.0f }, {  1.0f, -1.0f }
+};
+
+static int pointCount(Verb verb) noexcept {
+    switch (verb) {
+        case Verb::Move: return 1;
+        case Verb::Line: return 2;
+        case Verb::Cubic: return 4;
+        case Verb::Quadratic:
+        case Verb::Conic: return 3;
+        default: return 0;
+    }
+}
+
+static float cross(Point o, Point a, Point b) noexcept {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+static float length(float x, float y) noexcept {
+    return std::sqrt(x * x + y * y);
+}
+
+// Number of lines needed to approximate the curve within tolerance, from a bound of its
+// second derivative: the distance between a curve and its chord over a parametric length
+// h is at most max|p''| h^2 / 8
+static int flattenCount(const Point* p, Verb verb, float weight, float tolerance) noexcept {
+    float error = length(p[0].x - 2.0f * p[1].x + p[2].x, p[0].y - 2.0f * p[1].y + p[2].y);
+    if (verb == Verb::Cubic) {
+        const float error1 = length(
+                p[1].x - 2.0f * p[2].x + p[3].x, p[1].y - 2.0f * p[2].y + p[3].y);
+        error = (error > error1 ? error : error1) * 0.75f;
+    } else {
+        error *= verb == Verb::Conic && weight > 1.0f ? weight * 0.25f : 0.25f;
+    }
+    const float count = std::ceil(std::sqrt(error / tolerance));
+    if (!(count > 1.0f)) return 1;
+    return count >= float(kMaxFlattenCount) ? kMaxFlattenCount : int(count);
+}
+
+static Point evaluate(const Point* p, Verb verb, float weight, float t) noexcept {
+    const float u = 1.0f - t;
+    if (verb == Verb::Cubic) {
+        const float a = u * u * u;
+        const float b = 3.0f * t * u * u;
+        const float c = 3.0f * t * t * u;
+        const float d = t * t * t;
+        return {
+            a * p[0].x + b * p[1].x + c * p[2].x + d * p[3].x,
+            a * p[0].y + b * p[1].y + c * p[2].y + d * p[3].y
+        };
+    }
+    const float a = u * u;
+    const float b = 2.0f * t * u * (verb == Verb::Conic ? weight : 1.0f);
+    const float c = t * t;
+    const float d = verb == Verb::Conic ? 1.0f / (a + b + c) : 1.0f;
+    return {
+        (a * p[0].x + b * p[1].x + c * p[2].x) * d,
+        (a * p[0].y + b * p[1].y + c * p[2].y) * d
+    };
+}
+
+static int comparePoints(const void* lhs, const void* rhs) {
+    const auto* a = static_cast<const Point*>(lhs);
+    const auto* b = static_cast<const Point*>(rhs);
+    if (a->x != b->x) return a->x < b->x ? -1 : 1;
+    return a->y < b->y ? -1 : (a->y > b->y ? 1 : 0);
+}
+
+void convexHull(const PathIterator& iterator, float tolerance, Array<Point>& hull) noexcept {
+    PATHWAY_TRACE("pathway::convexHull");
+
+    hull.clear();
+    if (!(tolerance > 0.0f)) tolerance = 0.25f;
+
+    Point points[4];
+
+    // First pass, extreme end points in each direction
+    Point extremes[kDirectionCount];
+    float maxima[kDirectionCount];
+    bool empty = true;
+    {
+        PathIterator pass(iterator);
+        while (pass.hasNext()) {
+            const Verb verb = pass.next(points);
+            const int count = pointCount(verb);
+            if (count == 0) continue;
+            // Skip the segments the second pass drops
+            if (!areFinite(points, count)) continue;
+            const Point p = points[count - 1];
+            for (int i = 0; i < kDirectionCount; i++) {
+                const float d = p.x * kDirections[i][0] + p.y * kDirections[i][1];
+                if (empty || d > maxima[i]) {
+                    maxima[i] = d;
+                    extremes[i] = p;
+                }
+            }
+            empty = false;
+        }
+    }
+    if (empty) return;
+
+    // Second pass, keep the points of the segments that may touch the hull
+    Array<Point> candidates;
+    {
+        PathIterator pass(iterator);
+        while (pass.hasNext()) {
+            const Verb verb = pass.next(points);
+            const int count = pointCount(verb);
+            if (count == 0) continue;
+            if (!areFinite(points, count)) continue;
+
+            bool inside = true;
+            for (int i = 0; i < count && inside; i++) {
+                for (int j = 0; j < kDirectionCount; j++) {
+                    const Point a = extremes[j];
+                    const Point b = extremes[(j + 1) % kDirectionCount];
+                    if ((a.x != b.x || a.y != b.y) && cross(a, b, points[i]) <= 0.0f) {
+                        inside = false;
+                        break;
+                    }
+                }
+            }
+            if (inside) continue;
+
+            if (verb == Verb::Move || verb == Verb::Line) {
+                candidates.push(points[count - 1]);
+                if (verb == Verb::Line) candidates.push(points[0]);
+                continue;
+            }
+
+            const float weight = points[3].x;
+            const int steps = flattenCount(points, verb, weight, tolerance);
+            candidates.push(points[0]);
+            for (int i = 1; i < steps; i++) {
+                candidates.push(evaluate(points, verb, weight, float(i) / float(steps)));
+            }
+            candidates.push(points[count - 1]);
+        }
+    }
+
+    // The octagon is made of points of the outline
+    candidates.append(extremes, kDirectionCount);
+
+    Point* p = candidates.data();
+    qsort(p, candidates.size(), sizeof(Point), comparePoints);
+
+    int count = 1;
+    for (int i = 1; i < candidates.size(); i++) {
+        if (p[i].x != p[count - 1].x || p[i].y != p[count - 1].y) p[count++] = p[i];
+    }
+
+    // Andrew's monotone chain, lower hull then upper hull
+    hull.reserve(count + 1);
+    for (int i = 0; i < count; i++) {
+        while (hull.size() >= 2 && cross(hull[hull.size() - 2], hull.back(), p[i]) <= 0.0f) {
+            hull.pop();
+        }
+        hull.push(p[i]);
+    }
+    const int lower = hull.size() + 1;
+    for (int i = count - 2; i >= 0; i--) {
+        while (hull.size() >= lower && cross(hull[hull.size() - 2], hull.back(), p[i]) <= 0.0f) {
+            hull.pop();
+        }
+        hull.push(p[i]);
+    }
+    // The last point is the first point
+    if (hull.size() > 1) hull.pop();
+}
+
+OrientedBox orientedBoundingBox(const Array<Point>& hull) noexcept {
+    const int n = hull.size();
+    if (n == 0) return { { 0.0f, 0.0f }, 0.0f, 0.0f, 0.0f };
+    if (n == 1) return { hull[0], 0.0f, 0.0f, 0.0f };
+    if (n == 2) {
+        const Point a = hull[0];
+        const Point b = hull[1];
+        return {
+            { (a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f },
+            length(b.x - a.x, b.y - a.y), 0.0f,
+            std::atan2(b.y - a.y, b.x - a.x)
+        };
+    }
+
+    auto dot = [](Point p, float x, float y) { return p.x * x + p.y * y; };
+
+    OrientedBox best{};
+    float bestArea = 0.0f;
+    bool first = true;
+
+    // Indices of the points of the hull furthest along the edge, opposite to the edge,
+    // and backward along the edge
+    int right = 0;
+    int top = 0;
+    int left = 0;
+
+    for (int i = 0; i < n; i++) {
+        const Point a = hull[i];
+        const Point b = hull[(i + 1) % n];
+        const float l = length(b.x - a.x, b.y - a.y);
+        if (l <= 0.0f) continue;
+        const float ex = (b.x - a.x) / l;
+        const float ey = (b.y - a.y) / l;
+        // The hull is on the left of its edges
+        const float nx = -ey;
+        const float ny = ex;
+
+        // Projections of the point j of the hull along the edge and along its normal
+        auto along = [&](int j) { return dot(hull[j], ex, ey); };
+        auto across = [&](int j) { return dot(hull[j], nx, ny); };
+        auto next = [n](int j) { return (j + 1) % n; };
+
+        if (first) {
+            for (int j = 1; j < n; j++) {
+                if (along(j) > along(right)) right = j;
+                if (across(j) > across(top)) top = j;
+                if (along(j) < along(left)) left = j;
+            }
+        } else {
+            // The calipers rotate in the same direction as the edges
+            for (int k = 0; k < n && along(next(right)) >= along(right); k++) {
+                right = next(right);
+            }
+            for (int k = 0; k < n && across(next(top)) >= across(top); k++) {
+                top = next(top);
+            }
+            for (int k = 0; k < n && along(next(left)) <= along(left); k++) {
+                left = next(left);
+            }
+        }
+
+        const float minE = along(left);
+        const float maxE = along(right);
+        const float minN = dot(a, nx, ny);
+        const float maxN = across(top);
+        const float width = maxE - minE;
+        const float height = maxN - minN;
+        const float area = width * height;
+
+        if (first || area < bestArea) {
+            bestArea = area;
+            const float ce = (minE + maxE) * 0.5f;
+            const float cn = (minN + maxN) * 0.5f;
+            best = {
+                { ex * ce + nx * cn, ey * ce + ny * cn },
+                width, height,
+                std::atan2(ey, ex)
+            };
+        }
+        first = false;
+    }
+
+    return best;
+}
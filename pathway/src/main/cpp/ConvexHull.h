@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_CONVEX_HULL_H
+#define PATHWAY_CONVEX_HULL_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+// Computes the convex hull of the outline of a path, in hull. Conics must not be converted
+// by the iterator, which is only copied, so the path is read twice from its storage.
+//
+// The first pass finds the extreme end points of the segments in 8 directions. The
+// octagon they form is inside the hull, and since a curve lies inside the convex hull of
+// its control points, the segments whose control points are all inside the octagon are
+// discarded by the second pass. The remaining curves are flattened within tolerance, and
+// the hull of the remaining points is computed with Andrew's monotone chain.
+//
+// The points of the hull are counter-clockwise in a y-up coordinate system, clockwise on
+// screen, without collinear points
+void convexHull(const PathIterator& iterator, float tolerance, Array<Point>& hull) noexcept;
+
+struct OrientedBox {
+    Point center;
+    // Size of the box along the direction given by angle, and perpendicular to it
+    float width;
+    float height;
+    // Angle in radians between the x axis and the width of the box
+    float angle;
+};
+
+// Finds the box of minimum area that contains a convex hull, with rotating calipers:
+// one side of the box is collinear with an edge of the hull
+OrientedBox orientedBoundingBox(const Array<Point>& hull) noexcept;
+
+#endif //PATHWAY_CONVEX_HULL_H
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Cubic.h"
+
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+
+// sqrt(3) / 36, see computeQuadraticCount()
+constexpr float kQuadraticErrorScale = 0.048112522f;
+
+int CubicConverter::computeQuadraticCount(const Point points[4], float tolerance) noexcept {
+    if (tolerance <= 0.0f || !isFinite(tolerance)) return 1;
+
+    const float x = points[3].x - 3.0f * points[2].x + 3.0f * points[1].x - points[0].x;
+    const float y = points[3].y - 3.0f * points[2].y + 3.0f * points[1].y - points[0].y;
+    const float error = kQuadraticErrorScale * std::sqrtf(x * x + y * y);
+    if (!isFinite(error)) return 1;
+
+    // Splitting the cubic in n pieces divides the bound by n^3
+    const float count = std::ceil(std::cbrt(error / tolerance));
+    if (count <= 1.0f) return 1;
+    return count >= float(kMaxCubicToQuadCount) ? kMaxCubicToQuadCount : int(count);
+}
+
+const Point* CubicConverter::toQuadratics(const Point points[4], float tolerance) noexcept {
+    const int count = computeQuadraticCount(points, tolerance);
+
+    // Power basis: p(t) = a t^3 + b t^2 + c t + d, and p'(t) = 3a t^2 + 2b t + c
+    const Point p0 = points[0];
+    const Point p1 = points[1];
+    const Point p2 = points[2];
+    const Point p3 = points[3];
+    const float ax = p3.x + 3.0f * (p1.x - p2.x) - p0.x;
+    const float ay = p3.y + 3.0f * (p1.y - p2.y) - p0.y;
+    const float bx = 3.0f * (p2.x - 2.0f * p1.x + p0.x);
+    const float by = 3.0f * (p2.y - 2.0f * p1.y + p0.y);
+    const float cx = 3.0f * (p1.x - p0.x);
+    const float cy = 3.0f * (p1.y - p0.y);
+
+    // Each piece [t0, t1] is approximated by the quadratic whose control point is
+    // (q0 + q1) / 2 + h / 4 * (p'(t0) - p'(t1)), with h = t1 - t0
+    const float h = 1.0f / float(count);
+    Point start = p0;
+    float dx0 = cx;
+    float dy0 = cy;
+
+    mStorage[0] = p0;
+    for (int i = 0; i < count; i++) {
+        const float t = float(i + 1) * h;
+        const Point end = i == count - 1 ? p3 : Point {
+                ((ax * t + bx) * t + cx) * t + p0.x,
+                ((ay * t + by) * t + cy) * t + p0.y
+        };
+        const float dx1 = (3.0f * ax * t + 2.0f * bx) * t + cx;
+        const float dy1 = (3.0f * ay * t + 2.0f * by) * t + cy;
+
+        mStorage[i * 2 + 1] = {
+                (start.x + end.x) * 0.5f + h * 0.25f * (dx0 - dx1),
+                (start.y + end.y) * 0.5f + h * 0.25f * (dy0 - dy1)
+        };
+        mStorage[i * 2 + 2] = end;
+
+        start = end;
+        dx0 = dx1;
+        dy0 = dy1;
+    }
+    mQuadraticCount = count;
+
+    if (statsEnabled()) {
+        addStat(Stat::CubicsConverted, 1);
+        addStat(Stat::QuadraticsFromCubics, count);
+    }
+
+    return mStorage;
+}
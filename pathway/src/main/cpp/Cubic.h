@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_CUBIC_H
+#define PATHWAY_CUBIC_H
+
+#include "Path.h"
+
+constexpr int kMaxCubicToQuadCount = 32;
+
+// Approximates cubics with sequences of quadratics, see toQuadratics()
+class CubicConverter {
+public:
+    CubicConverter() noexcept { }
+
+    // Splits the cubic in the smallest number of pieces of equal parametric length whose
+    // quadratic approximations are within tolerance of the cubic, up to kMaxCubicToQuadCount.
+    // The number of pieces is derived from the third derivative of the cubic, which is
+    // constant: the distance between a cubic and the quadratic sharing its end points and
+    // the average of its end tangents is bounded by sqrt(3) / 36 * |p3 - 3 p2 + 3 p1 - p0|
+    static int computeQuadraticCount(const Point points[4], float tolerance) noexcept;
+
+    const Point* toQuadratics(const Point points[4], float tolerance = 0.25f) noexcept;
+
+    int quadraticCount() const noexcept { return mQuadraticCount; }
+
+    const Point* quadratics() const noexcept {
+        return mQuadraticCount > 0 ? mStorage : nullptr;
+    }
+
+private:
+    int mQuadraticCount = 0;
+    Point mStorage[1 + 2 * kMaxCubicToQuadCount];
+};
+
+#endif //PATHWAY_CUBIC_H
@@ -0,0 +1,897 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DistanceField.h"
+
+#include "Geometry.h"
+#include "Stats.h"
+
+#include "math/vec2.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace filament::math;
+
+using Edge = DistanceField::Edge;
+using Monotone = DistanceField::Monotone;
+using Crossing = DistanceField::Crossing;
+
+// Size of the cells of the grid of edges, in pixels, and distance from the center of a
+// cell to its corners
+constexpr int kCellSize = 8;
+constexpr float kCellRadius = kCellSize * 0.70710678f;
+
+// Starting points and Newton iterations used to find the closest point of conics and
+// cubics, as in msdfgen
+constexpr int kSearchStarts = 4;
+constexpr int kSearchSteps = 4;
+
+// Two consecutive edges form a corner if the sine of the angle between their tangents
+// is greater than sin(3), or if they turn by more than 90 degrees
+constexpr float kCornerThreshold = 0.14112f;
+
+constexpr double kTwoPi = 6.283185307179586;
+
+constexpr uint8_t kRed = 1;
+constexpr uint8_t kGreen = 2;
+constexpr uint8_t kBlue = 4;
+constexpr uint8_t kMagenta = kRed | kBlue;
+constexpr uint8_t kCyan = kGreen | kBlue;
+constexpr uint8_t kWhite = kRed | kGreen | kBlue;
+
+static int pointCount(Verb verb) noexcept {
+    switch (verb) {
+        case Verb::Line: return 2;
+        case Verb::Cubic: return 4;
+        default: return 3;
+    }
+}
+
+static void computeBounds(Edge& edge) noexcept {
+    const int count = pointCount(edge.verb);
+    edge.left = edge.right = edge.points[0].x;
+    edge.top = edge.bottom = edge.points[0].y;
+    for (int i = 1; i < count; i++) {
+        const Point p = edge.points[i];
+        if (p.x < edge.left) edge.left = p.x;
+        if (p.x > edge.right) edge.right = p.x;
+        if (p.y < edge.top) edge.top = p.y;
+        if (p.y > edge.bottom) edge.bottom = p.y;
+    }
+}
+
+// Evaluates the position, and optionally the first and second derivatives, of the edge at t
+static float2 evaluate(const Edge& edge, float t,
+        float2* d1 = nullptr, float2* d2 = nullptr) noexcept {
+    const float2 p0 = fromPoint(edge.points[0]);
+    const float2 p1 = fromPoint(edge.points[1]);
+    const float u = 1.0f - t;
+
+    switch (edge.verb) {
+        case Verb::Line:
+            if (d1) *d1 = p1 - p0;
+            if (d2) *d2 = float2{0.0f};
+            return p0 + (p1 - p0) * t;
+        case Verb::Quadratic: {
+            const float2 p2 = fromPoint(edge.points[2]);
+            if (d1) *d1 = 2.0f * ((p1 - p0) * u + (p2 - p1) * t);
+            if (d2) *d2 = 2.0f * (p2 - 2.0f * p1 + p0);
+            return p0 * (u * u) + p1 * (2.0f * t * u) + p2 * (t * t);
+        }
+        case Verb::Conic: {
+            // p(t) = n(t) / d(t) with n(t) = p0 u^2 + 2 w p1 t u + p2 t^2
+            // and d(t) = u^2 + 2 w t u + t^2
+            const float2 p2 = fromPoint(edge.points[2]);
+            const float w = edge.weight;
+            const float2 wp1 = p1 * w;
+            const float2 n = p0 * (u * u) + wp1 * (2.0f * t * u) + p2 * (t * t);
+            const float d = u * u + 2.0f * w * t * u + t * t;
+            const float2 p = n / d;
+            if (d1 || d2) {
+                const float2 n1 = 2.0f * ((wp1 - p0) * u + (p2 - wp1) * t);
+                const float dd1 = 2.0f * (w - 1.0f) * (1.0f - 2.0f * t);
+                const float2 v = (n1 - p * dd1) / d;
+                if (d1) *d1 = v;
+                if (d2) {
+                    const float2 n2 = 2.0f * (p0 - 2.0f * wp1 + p2);
+                    const float dd2 = -4.0f * (w - 1.0f);
+                    *d2 = (n2 - v * (2.0f * dd1) - p * dd2) / d;
+                }
+            }
+            return p;
+        }
+        default: {
+            const float2 p2 = fromPoint(edge.points[2]);
+            const float2 p3 = fromPoint(edge.points[3]);
+            if (d1) *d1 = 3.0f * ((p1 - p0) * (u * u) + (p2 - p1) * (2.0f * t * u) +
+                    (p3 - p2) * (t * t));
+            if (d2) *d2 = 6.0f * ((p2 - 2.0f * p1 + p0) * u + (p3 - 2.0f * p2 + p1) * t);
+            return p0 * (u * u * u) + p1 * (3.0f * t * u * u) + p2 * (3.0f * t * t * u) +
+                    p3 * (t * t * t);
+        }
+    }
+}
+
+// Tangents at the ends of the edge, which skip control points that coincide with the end
+static float2 startDirection(const Edge& edge) noexcept {
+    const float2 p0 = fromPoint(edge.points[0]);
+    const int count = pointCount(edge.verb);
+    for (int i = 1; i < count; i++) {
+        const float2 d = fromPoint(edge.points[i]) - p0;
+        if (d.x != 0.0f || d.y != 0.0f) return d;
+    }
+    return float2{0.0f};
+}
+
+static float2 endDirection(const Edge& edge) noexcept {
+    const int count = pointCount(edge.verb);
+    const float2 p = fromPoint(edge.points[count - 1]);
+    for (int i = count - 2; i >= 0; i--) {
+        const float2 d = p - fromPoint(edge.points[i]);
+        if (d.x != 0.0f || d.y != 0.0f) return d;
+    }
+    return float2{0.0f};
+}
+
+static float2 direction(const Edge& edge, float t) noexcept {
+    float2 d;
+    evaluate(edge, t, &d);
+    if (d.x != 0.0f || d.y != 0.0f) return d;
+    return t < 0.5f ? startDirection(edge) : endDirection(edge);
+}
+
+// Splits the edge at t. The conic split is done in homogeneous coordinates
+static void splitEdge(const Edge& edge, float t, Edge& first, Edge& second) noexcept {
+    first = edge;
+    second = edge;
+    switch (edge.verb) {
+        case Verb::Line:
+            first.points[1] = second.points[0] = lerp(edge.points[0], edge.points[1], t);
+            break;
+        case Verb::Quadratic: {
+            Point dst[5];
+            splitQuadratic(edge.points, t, dst);
+            for (int i = 0; i < 3; i++) {
+                first.points[i] = dst[i];
+                second.points[i] = dst[i + 2];
+            }
+            break;
+        }
+        case Verb::Conic: {
+            // (x w, y w, w) for each control point, the weights of the ends are 1
+            const float w = edge.weight;
+            const Point p0 = edge.points[0];
+            const Point p1 = { edge.points[1].x * w, edge.points[1].y * w };
+            const Point p2 = edge.points[2];
+            const Point a = lerp(p0, p1, t);
+            const Point b = lerp(p1, p2, t);
+            const Point m = lerp(a, b, t);
+            const float aw = 1.0f + (w - 1.0f) * t;
+            const float bw = w + (1.0f - w) * t;
+            const float mw = aw + (bw - aw) * t;
+            // Both halves are normalized so the weights of their ends are 1
+            const Point mid = { m.x / mw, m.y / mw };
+            first.points[1] = { a.x / aw, a.y / aw };
+            first.points[2] = mid;
+            first.weight = aw / std::sqrt(mw);
+            second.points[0] = mid;
+            second.points[1] = { b.x / bw, b.y / bw };
+            second.weight = bw / std::sqrt(mw);
+            break;
+        }
+        default: {
+            Point dst[7];
+            splitCubic(edge.points, t, dst);
+            for (int i = 0; i < 4; i++) {
+                first.points[i] = dst[i];
+                second.points[i] = dst[i + 3];
+            }
+            break;
+        }
+    }
+    computeBounds(first);
+    computeBounds(second);
+}
+
+// Roots of a t^2 + b t + c
+static int solveQuadratic(double roots[2], double a, double b, double c) noexcept {
+    if (std::fabs(a) < 1e-14) {
+        if (std::fabs(b) < 1e-14) return 0;
+        roots[0] = -c / b;
+        return 1;
+    }
+    double discriminant = b * b - 4.0 * a * c;
+    if (discriminant > 0.0) {
+        discriminant = std::sqrt(discriminant);
+        roots[0] = (-b + discriminant) / (2.0 * a);
+        roots[1] = (-b - discriminant) / (2.0 * a);
+        return 2;
+    }
+    if (discriminant == 0.0) {
+        roots[0] = -b / (2.0 * a);
+        return 1;
+    }
+    return 0;
+}
+
+// Real roots of t^3 + a t^2 + b t + c
+static int solveNormedCubic(double roots[3], double a, double b, double c) noexcept {
+    const double a2 = a * a;
+    double q = (a2 - 3.0 * b) / 9.0;
+    const double r = (a * (2.0 * a2 - 9.0 * b) + 27.0 * c) / 54.0;
+    const double r2 = r * r;
+    const double q3 = q * q * q;
+    a /= 3.0;
+    if (r2 < q3) {
+        double t = r / std::sqrt(q3);
+        t = std::acos(t < -1.0 ? -1.0 : (t > 1.0 ? 1.0 : t));
+        q = -2.0 * std::sqrt(q);
+        roots[0] = q * std::cos(t / 3.0) - a;
+        roots[1] = q * std::cos((t + kTwoPi) / 3.0) - a;
+        roots[2] = q * std::cos((t - kTwoPi) / 3.0) - a;
+        return 3;
+    }
+    double u = -std::cbrt(std::fabs(r) + std::sqrt(r2 - q3));
+    if (r < 0.0) u = -u;
+    const double v = u == 0.0 ? 0.0 : q / u;
+    roots[0] = (u + v) - a;
+    if (std::fabs(u - v) < 1e-14) {
+        roots[1] = -0.5 * (u + v) - a;
+        return 2;
+    }
+    return 1;
+}
+
+// Roots of a t^3 + b t^2 + c t + d
+static int solveCubic(double roots[3], double a, double b, double c, double d) noexcept {
+    if (a != 0.0) {
+        const double bn = b / a;
+        // Above this ratio, the cubic term is negligible
+        if (std::fabs(bn) < 1e6) return solveNormedCubic(roots, bn, c / a, d / a);
+    }
+    return solveQuadratic(roots, b, c, d);
+}
+
+// Distance from a point to the closest point of an edge, at t
+struct EdgeDistance {
+    float distance;
+    // Orthogonality of the edge and of the vector to the point when the closest point
+    // is an end of the edge, 0 otherwise. Used to pick between edges sharing an end
+    float dot;
+    float t;
+};
+
+static bool isCloser(const EdgeDistance& a, const EdgeDistance& b) noexcept {
+    return a.distance < b.distance || (a.distance == b.distance && a.dot < b.dot);
+}
+
+static EdgeDistance distanceTo(const Edge& edge, float2 p) noexcept {
+    const float2 p0 = fromPoint(edge.points[0]);
+    const float2 end = fromPoint(edge.points[pointCount(edge.verb) - 1]);
+
+    // Start with the ends of the edge
+    float t = 0.0f;
+    float distance2 = length2(p0 - p);
+    const float endDistance2 = length2(end - p);
+    if (endDistance2 < distance2) {
+        t = 1.0f;
+        distance2 = endDistance2;
+    }
+
+    if (edge.verb == Verb::Line) {
+        const float2 d = end - p0;
+        const float s = dot(p - p0, d) / dot(d, d);
+        if (s > 0.0f && s < 1.0f) {
+            const float candidate = length2(p0 + d * s - p);
+            if (candidate < distance2) {
+                t = s;
+                distance2 = candidate;
+            }
+        }
+    } else if (edge.verb == Verb::Quadratic) {
+        // The closest point is a root of dot(q(t) - p, q'(t)), a cubic polynomial
+        const float2 qa = p0 - p;
+        const float2 ab = fromPoint(edge.points[1]) - p0;
+        const float2 br = end - fromPoint(edge.points[1]) - ab;
+        double roots[3];
+        const int count = solveCubic(roots,
+                dot(br, br), 3.0 * dot(ab, br), 2.0 * dot(ab, ab) + dot(qa, br), dot(qa, ab));
+        for (int i = 0; i < count; i++) {
+            const float s = float(roots[i]);
+            if (s > 0.0f && s < 1.0f) {
+                const float candidate = length2(qa + ab * (2.0f * s) + br * (s * s));
+                if (candidate < distance2) {
+                    t = s;
+                    distance2 = candidate;
+                }
+            }
+        }
+    } else {
+        // Newton iterations on dot(q(t) - p, q'(t)) from several starting points
+        for (int i = 0; i <= kSearchStarts; i++) {
+            float s = float(i) / float(kSearchStarts);
+            for (int step = 0; step <= kSearchSteps; step++) {
+                float2 d1;
+                float2 d2;
+                const float2 q = evaluate(edge, s, &d1, &d2) - p;
+                if (step > 0) {
+                    const float candidate = length2(q);
+                    if (candidate < distance2) {
+                        t = s;
+                        distance2 = candidate;
+                    }
+                    if (step == kSearchSteps) break;
+                }
+                const float slope = dot(d1, d1) + dot(q, d2);
+                if (slope == 0.0f) break;
+                s -= dot(q, d1) / slope;
+                if (s <= 0.0f || s >= 1.0f) break;
+            }
+        }
+    }
+
+    EdgeDistance result = { std::sqrt(distance2), 0.0f, t };
+    if ((t == 0.0f || t == 1.0f) && result.distance > 0.0f) {
+        const float2 d = t == 0.0f ? startDirection(edge) : endDirection(edge);
+        const float2 q = (t == 0.0f ? p0 : end) - p;
+        const float l = length(d);
+        if (l > 0.0f) result.dot = std::fabs(dot(d, q)) / (l * result.distance);
+    }
+    return result;
+}
+
+// Distance signed by the side of the edge the point lies on, positive on the left. When
+// the closest point is an end of the edge, the distance to the line extending the edge
+// is used instead if the point is beyond that end, which keeps corners sharp in
+// multi-channel fields
+static float signedPseudoDistance(const Edge& edge, float2 p, const EdgeDistance& d) noexcept {
+    if (d.t == 0.0f || d.t == 1.0f) {
+        const bool start = d.t == 0.0f;
+        float2 direction = start ? startDirection(edge) : endDirection(edge);
+        const float l = length(direction);
+        if (l > 0.0f) {
+            direction /= l;
+            const float2 q = p - fromPoint(edge.points[start ? 0 : pointCount(edge.verb) - 1]);
+            const float along = dot(q, direction);
+            if (start ? along < 0.0f : along > 0.0f) {
+                const float distance = cross(direction, q);
+                if (std::fabs(distance) <= d.distance) return distance;
+            }
+        }
+    }
+    const float2 q = p - evaluate(edge, d.t);
+    return cross(direction(edge, d.t), q) >= 0.0f ? d.distance : -d.distance;
+}
+
+// Returns the next color of the sequence cyan, magenta, yellow, which is different from
+// banned if banned is a color made of two channels, see switchColor() in msdfgen
+static uint8_t switchColor(uint8_t color, uint8_t banned = 0) noexcept {
+    const uint8_t combined = color & banned;
+    if (combined == kRed || combined == kGreen || combined == kBlue) return combined ^ kWhite;
+    if (color == 0 || color == kWhite) return kCyan;
+    const int shifted = color << 1;
+    return uint8_t((shifted | shifted >> 3) & kWhite);
+}
+
+static bool isCorner(float2 a, float2 b) noexcept {
+    const float la = length(a);
+    const float lb = length(b);
+    if (la == 0.0f || lb == 0.0f) return false;
+    a /= la;
+    b /= lb;
+    return dot(a, b) <= 0.0f || std::fabs(cross(a, b)) > kCornerThreshold;
+}
+
+static float edgeArea(const Edge& edge) noexcept {
+    // Twice the signed area of the control polygon, enough to find the orientation
+    float area = 0.0f;
+    const int count = pointCount(edge.verb);
+    for (int i = 1; i < count; i++) {
+        const Point a = edge.points[i - 1];
+        const Point b = edge.points[i];
+        area += a.x * b.y - a.y * b.x;
+    }
+    return area;
+}
+
+void DistanceField::setPath(PathIterator& iterator, bool evenOdd, bool inverse) noexcept {
+    mEdges.clear();
+    mMonotones.clear();
+    mArea = 0.0f;
+    mContourStart = 0;
+    mStart = mLast = Point{};
+    mEvenOdd = evenOdd;
+    mInverse = inverse;
+
+    Point points[4];
+    Edge edge{};
+    bool done = false;
+    while (!done && iterator.hasNext()) {
+        const Verb verb = iterator.next(points);
+        switch (verb) {
+            case Verb::Move:
+                closeContour();
+                mStart = mLast = points[0];
+                break;
+            case Verb::Line:
+            case Verb::Quadratic:
+            case Verb::Conic:
+            case Verb::Cubic: {
+                const int count = pointCount(verb);
+                edge.verb = verb;
+                edge.weight = verb == Verb::Conic ? points[3].x : 1.0f;
+                for (int i = 0; i < count; i++) edge.points[i] = points[i];
+                addEdge(edge);
+                mLast = points[count - 1];
+                break;
+            }
+            case Verb::Close:
+                closeContour();
+                mLast = mStart;
+                break;
+            case Verb::Done:
+                done = true;
+                break;
+        }
+    }
+    closeContour();
+}
+
+void DistanceField::addEdge(const Edge& edge) noexcept {
+    Edge& e = *mEdges.grow(1);
+    e = edge;
+    computeBounds(e);
+    // Skip degenerate edges, which have no tangent
+    if (e.left == e.right && e.top == e.bottom) mEdges.pop();
+}
+
+void DistanceField::closeContour() noexcept {
+    if (mEdges.size() == mContourStart) return;
+
+    if (mLast.x != mStart.x || mLast.y != mStart.y) {
+        Edge edge{};
+        edge.verb = Verb::Line;
+        edge.weight = 1.0f;
+        edge.points[0] = mLast;
+        edge.points[1] = mStart;
+        addEdge(edge);
+    }
+
+    colorContour(mContourStart);
+
+    for (int i = mContourStart; i < mEdges.size(); i++) {
+        const Edge& edge = mEdges[i];
+        mArea += edgeArea(edge);
+
+        // Split the edge where y reaches an extremum
+        float ts[4] = { 0.0f };
+        int count = 1;
+        const float y0 = edge.points[0].y;
+        const float y1 = edge.points[1].y;
+        double roots[2];
+        int rootCount = 0;
+        if (edge.verb == Verb::Quadratic) {
+            rootCount = solveQuadratic(roots, 0.0, y0 - 2.0f * y1 + edge.points[2].y, y1 - y0);
+        } else if (edge.verb == Verb::Conic) {
+            // See SkConic::findYExtrema()
+            const float y20 = edge.points[2].y - y0;
+            const float wy10 = edge.weight * (y1 - y0);
+            rootCount = solveQuadratic(roots, edge.weight * y20 - y20, y20 - 2.0f * wy10, wy10);
+        } else if (edge.verb == Verb::Cubic) {
+            const float a = y1 - y0;
+            const float b = edge.points[2].y - y1;
+            const float c = edge.points[3].y - edge.points[2].y;
+            rootCount = solveQuadratic(roots, a - 2.0f * b + c, 2.0f * (b - a), a);
+        }
+        for (int j = 0; j < rootCount; j++) {
+            const float t = float(roots[j]);
+            if (t > 0.0f && t < 1.0f) ts[count++] = t;
+        }
+        if (count == 3 && ts[2] < ts[1]) {
+            const float t = ts[1];
+            ts[1] = ts[2];
+            ts[2] = t;
+        }
+        ts[count] = 1.0f;
+
+        float ya = y0;
+        for (int j = 0; j < count; j++) {
+            const float yb = j + 1 == count ?
+                    edge.points[pointCount(edge.verb) - 1].y : evaluate(edge, ts[j + 1]).y;
+            if (ya != yb) {
+                const bool down = yb > ya;
+                mMonotones.push({ i, ts[j], ts[j + 1], down ? ya : yb, down ? yb : ya,
+                        down ? 1 : -1 });
+            }
+            ya = yb;
+        }
+    }
+
+    mContourStart = mEdges.size();
+}
+
+void DistanceField::colorContour(int start) noexcept {
+    const int count = mEdges.size() - start;
+    Edge* edges = mEdges.data() + start;
+
+    // Edge i starts at a corner if it turns sharply from edge i - 1
+    auto startsAtCorner = [edges, count](int i) {
+        return isCorner(endDirection(edges[(i + count - 1) % count]), startDirection(edges[i]));
+    };
+
+    int cornerCount = 0;
+    int firstCorner = -1;
+    for (int i = 0; i < count; i++) {
+        if (startsAtCorner(i)) {
+            if (cornerCount++ == 0) firstCorner = i;
+        }
+    }
+
+    if (cornerCount == 0) {
+        // Smooth contour, all the channels see the same edges
+        for (int i = 0; i < count; i++) edges[i].color = kWhite;
+        return;
+    }
+
+    if (cornerCount == 1) {
+        // Teardrop, the contour is split in three parts of different colors
+        const uint8_t colors[3] = { kCyan, kWhite, kMagenta };
+        if (count >= 3) {
+            for (int i = 0; i < count; i++) {
+                const int part = int(2.0625f + 2.875f * float(i) / float(count - 1)) - 2;
+                edges[(firstCorner + i) % count].color = colors[part];
+            }
+            return;
+        }
+
+        // Not enough edges for three colors, split each edge in thirds
+        Edge parts[6];
+        for (int i = 0; i < count; i++) {
+            Edge rest;
+            Edge* thirds = parts + i * 3;
+            splitEdge(edges[(firstCorner + i) % count], 1.0f / 3.0f, thirds[0], rest);
+            splitEdge(rest, 0.5f, thirds[1], thirds[2]);
+        }
+        const int partCount = count * 3;
+        for (int i = 0; i < partCount; i++) {
+            parts[i].color = colors[i * 3 / partCount];
+        }
+        mEdges.resize(start);
+        mEdges.append(parts, partCount);
+        return;
+    }
+
+    // Each spline between two corners gets a different color than its neighbors, and
+    // the last spline a different color than the first one
+    uint8_t color = switchColor(kWhite);
+    const uint8_t initialColor = color;
+    int spline = 0;
+    for (int i = 0; i < count; i++) {
+        const int index = (firstCorner + i) % count;
+        if (i > 0 && spline + 1 < cornerCount && startsAtCorner(index)) {
+            spline++;
+            color = switchColor(color, spline == cornerCount - 1 ? initialColor : 0);
+        }
+        edges[index].color = color;
+    }
+}
+
+// Returns floor(v) clamped to [min, max], v can be infinite
+static int clampToInt(float v, int min, int max) noexcept {
+    v = std::floor(v);
+    return v < float(min) ? min : (v > float(max) ? max : int(v));
+}
+
+void DistanceField::buildIndex() noexcept {
+    const float range = mRange;
+
+    mCellsX = (mWidth + kCellSize - 1) / kCellSize;
+    const int cellsY = (mHeight + kCellSize - 1) / kCellSize;
+    const int cellCount = mCellsX * cellsY;
+
+    // Count the edges of each cell in offset i + 1, then accumulate the counts
+    mCellOffsets.resize(cellCount + 1);
+    memset(mCellOffsets.data(), 0, sizeof(int) * (cellCount + 1));
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < mEdges.size(); i++) {
+            const Edge& edge = mEdges[i];
+            if (edge.right + range < 0.0f || edge.left - range > float(mWidth) ||
+                    edge.bottom + range < 0.0f || edge.top - range > float(mHeight)) {
+                continue;
+            }
+            const int x0 = clampToInt((edge.left - range) / kCellSize, 0, mCellsX - 1);
+            const int x1 = clampToInt((edge.right + range) / kCellSize, 0, mCellsX - 1);
+            const int y0 = clampToInt((edge.top - range) / kCellSize, 0, cellsY - 1);
+            const int y1 = clampToInt((edge.bottom + range) / kCellSize, 0, cellsY - 1);
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    // The bounds of long curves cover many cells far from the curve
+                    const float2 center{(float(x) + 0.5f) * kCellSize,
+                            (float(y) + 0.5f) * kCellSize};
+                    if (distanceTo(edge, center).distance > range + kCellRadius) continue;
+
+                    const int cell = y * mCellsX + x;
+                    if (pass == 0) {
+                        mCellOffsets[cell + 1]++;
+                    } else {
+                        mCellEdges[mCellOffsets[cell]++] = i;
+                    }
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int i = 1; i <= cellCount; i++) mCellOffsets[i] += mCellOffsets[i - 1];
+            mCellEdges.resize(mCellOffsets[cellCount]);
+        } else {
+            // The fill pass moved each offset to the start of the next cell
+            for (int i = cellCount; i > 0; i--) mCellOffsets[i] = mCellOffsets[i - 1];
+            mCellOffsets[0] = 0;
+        }
+    }
+
+    // Same for the monotone parts of the edges crossed by the rows of each band of tiles.
+    // Row y is crossed if top <= y + 0.5 < bottom
+    const int bandCount = (mHeight + kDistanceFieldTileSize - 1) / kDistanceFieldTileSize;
+    mBandOffsets.resize(bandCount + 1);
+    memset(mBandOffsets.data(), 0, sizeof(int) * (bandCount + 1));
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < mMonotones.size(); i++) {
+            const Monotone& monotone = mMonotones[i];
+            if (monotone.bottom < 0.0f || monotone.top > float(mHeight)) continue;
+            const int y0 = clampToInt(
+                    (monotone.top - 0.5f) / kDistanceFieldTileSize, 0, bandCount - 1);
+            const int y1 = clampToInt(
+                    (monotone.bottom - 0.5f) / kDistanceFieldTileSize, 0, bandCount - 1);
+            for (int y = y0; y <= y1; y++) {
+                if (pass == 0) {
+                    mBandOffsets[y + 1]++;
+                } else {
+                    mBandMonotones[mBandOffsets[y]++] = i;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (int i = 1; i <= bandCount; i++) mBandOffsets[i] += mBandOffsets[i - 1];
+            mBandMonotones.resize(mBandOffsets[bandCount]);
+        } else {
+            for (int i = bandCount; i > 0; i--) mBandOffsets[i] = mBandOffsets[i - 1];
+            mBandOffsets[0] = 0;
+        }
+    }
+}
+
+void DistanceField::render(uint8_t* pixels, uint32_t stride, int width, int height,
+        float range, Type type, int threadCount) noexcept {
+    if (width <= 0 || height <= 0) return;
+
+    PATHWAY_TRACE("pathway::DistanceField::render");
+
+    mPixels = pixels;
+    mStride = stride;
+    mWidth = width;
+    mHeight = height;
+    mRange = range;
+    mType = type;
+    mTilesX = (width + kDistanceFieldTileSize - 1) / kDistanceFieldTileSize;
+    mTileCount = mTilesX * ((height + kDistanceFieldTileSize - 1) / kDistanceFieldTileSize);
+    mNextTile.store(0, std::memory_order_relaxed);
+
+    buildIndex();
+
+    if (threadCount <= 0) {
+        threadCount = int(sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    if (threadCount > mTileCount) threadCount = mTileCount;
+    if (threadCount < 1) threadCount = 1;
+
+    // The calling thread renders tiles too
+    auto* threads = static_cast<pthread_t*>(malloc(sizeof(pthread_t) * threadCount));
+    int started = 0;
+    for (int i = 1; i < threadCount; i++) {
+        if (pthread_create(&threads[started], nullptr, run, this) == 0) started++;
+    }
+    run(this);
+    for (int i = 0; i < started; i++) {
+        pthread_join(threads[i], nullptr);
+    }
+    free(threads);
+
+    mPixels = nullptr;
+}
+
+void* DistanceField::run(void* field_) noexcept {
+    auto* field = static_cast<DistanceField*>(field_);
+    Array<Crossing> crossings;
+    while (true) {
+        const int tile = field->mNextTile.fetch_add(1, std::memory_order_relaxed);
+        if (tile >= field->mTileCount) break;
+        field->renderTile(tile, crossings);
+    }
+    return nullptr;
+}
+
+// x of the point of the monotone part of the edge at y, found with Newton iterations
+// guarded by bisection
+static float crossingX(const Edge& edge, const Monotone& monotone, float y) noexcept {
+    const float y0 = monotone.direction > 0 ? monotone.top : monotone.bottom;
+    const float y1 = monotone.direction > 0 ? monotone.bottom : monotone.top;
+    if (edge.verb == Verb::Line) {
+        const Point p0 = edge.points[0];
+        const Point p1 = edge.points[1];
+        return p0.x + (p1.x - p0.x) * (y - p0.y) / (p1.y - p0.y);
+    }
+
+    float low = monotone.t0;
+    float high = monotone.t1;
+    float t = low + (high - low) * (y - y0) / (y1 - y0);
+    for (int i = 0; i < 24; i++) {
+        float2 d;
+        const float delta = evaluate(edge, t, &d).y - y;
+        if (delta == 0.0f || high - low < 1e-7f) break;
+        if ((delta > 0.0f) == (monotone.direction > 0)) {
+            high = t;
+        } else {
+            low = t;
+        }
+        const float next = d.y != 0.0f ? t - delta / d.y : low;
+        t = next > low && next < high ? next : (low + high) * 0.5f;
+    }
+    return evaluate(edge, t).x;
+}
+
+static uint8_t encode(float distance, float scale) noexcept {
+    float v = distance * scale + 0.5f;
+    v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    return uint8_t(v * 255.0f + 0.5f);
+}
+
+static float median(float a, float b, float c) noexcept {
+    const float lo = a < b ? a : b;
+    const float hi = a < b ? b : a;
+    return c < lo ? lo : (c > hi ? hi : c);
+}
+
+// Lower bound of the distance from p to the edge, since the edge lies in the hull of
+// its control points
+static float boundsDistance(const Edge& edge, float2 p) noexcept {
+    const float dx = edge.left - p.x > p.x - edge.right ? edge.left - p.x : p.x - edge.right;
+    const float dy = edge.top - p.y > p.y - edge.bottom ? edge.top - p.y : p.y - edge.bottom;
+    const float x = dx > 0.0f ? dx : 0.0f;
+    const float y = dy > 0.0f ? dy : 0.0f;
+    return std::sqrt(x * x + y * y);
+}
+
+void DistanceField::renderTile(int tile, Array<Crossing>& crossings) noexcept {
+    const int tileY = tile / mTilesX;
+    const int x0 = (tile % mTilesX) * kDistanceFieldTileSize;
+    const int y0 = tileY * kDistanceFieldTileSize;
+    const int x1 = x0 + kDistanceFieldTileSize < mWidth ? x0 + kDistanceFieldTileSize : mWidth;
+    const int y1 = y0 + kDistanceFieldTileSize < mHeight ? y0 + kDistanceFieldTileSize : mHeight;
+
+    const float range = mRange;
+    const float scale = 1.0f / (2.0f * range);
+    const bool multiChannel = mType == Type::MultiChannel;
+    // Edges have the interior on their left if the outline is counter-clockwise
+    const float orientation = (mArea < 0.0f) != mInverse ? -1.0f : 1.0f;
+
+    const int* bandMonotones = mBandMonotones.data() + mBandOffsets[tileY];
+    const int bandCount = mBandOffsets[tileY + 1] - mBandOffsets[tileY];
+
+    for (int y = y0; y < y1; y++) {
+        const float cy = float(y) + 0.5f;
+
+        // Winding number left of the tile, and crossings inside the tile, sorted along x
+        int winding = 0;
+        crossings.clear();
+        for (int i = 0; i < bandCount; i++) {
+            const Monotone& monotone = mMonotones[bandMonotones[i]];
+            if (cy < monotone.top || cy >= monotone.bottom) continue;
+            const float x = crossingX(mEdges[monotone.edge], monotone, cy);
+            if (x < float(x0) + 0.5f) {
+                winding += monotone.direction;
+            } else if (x < float(x1) - 0.5f) {
+                int j = crossings.size();
+                crossings.grow(1);
+                while (j > 0 && crossings[j - 1].x > x) {
+                    crossings[j] = crossings[j - 1];
+                    j--;
+                }
+                crossings[j] = { x, monotone.direction };
+            }
+        }
+
+        uint8_t* row = mPixels + size_t(y) * mStride;
+        int crossing = 0;
+        for (int x = x0; x < x1; x++) {
+            const float2 p{float(x) + 0.5f, cy};
+            while (crossing < crossings.size() && crossings[crossing].x < p.x) {
+                winding += crossings[crossing++].direction;
+            }
+            const bool inside = (mEvenOdd ? (winding & 1) != 0 : winding != 0) != mInverse;
+            const float sign = inside ? 1.0f : -1.0f;
+
+            const int cell = (y / kCellSize) * mCellsX + x / kCellSize;
+            const int* edges = mCellEdges.data() + mCellOffsets[cell];
+            const int edgeCount = mCellOffsets[cell + 1] - mCellOffsets[cell];
+
+            if (!multiChannel) {
+                float distance = range;
+                for (int i = 0; i < edgeCount; i++) {
+                    const Edge& edge = mEdges[edges[i]];
+                    if (boundsDistance(edge, p) >= distance) continue;
+                    const float d = distanceTo(edge, p).distance;
+                    if (d < distance) distance = d;
+                }
+                row[x] = encode(sign * distance, scale);
+                continue;
+            }
+
+            // Closest edge of each channel, edges beyond the range are ignored
+            EdgeDistance closest[3];
+            int closestEdge[3] = { -1, -1, -1 };
+            for (auto& c : closest) c = { range, 1.0f, 0.0f };
+            float distance = range;
+
+            for (int i = 0; i < edgeCount; i++) {
+                const Edge& edge = mEdges[edges[i]];
+                float threshold = 0.0f;
+                for (int c = 0; c < 3; c++) {
+                    if ((edge.color & (1 << c)) && closest[c].distance > threshold) {
+                        threshold = closest[c].distance;
+                    }
+                }
+                if (boundsDistance(edge, p) > threshold) continue;
+
+                const EdgeDistance d = distanceTo(edge, p);
+                if (d.distance < distance) distance = d.distance;
+                for (int c = 0; c < 3; c++) {
+                    if ((edge.color & (1 << c)) && isCloser(d, closest[c])) {
+                        closest[c] = d;
+                        closestEdge[c] = edges[i];
+                    }
+                }
+            }
+
+            float channels[3];
+            for (int c = 0; c < 3; c++) {
+                float v = sign * range;
+                if (closestEdge[c] >= 0) {
+                    v = orientation * signedPseudoDistance(mEdges[closestEdge[c]], p, closest[c]);
+                    v = v < -range ? -range : (v > range ? range : v);
+                }
+                channels[c] = v;
+            }
+
+            // The fill rule decides which side is inside when contours overlap or
+            // are not consistently oriented
+            const float m = median(channels[0], channels[1], channels[2]);
+            if (m != 0.0f && (m > 0.0f) != inside) {
+                for (float& v : channels) v = -v;
+            }
+
+            uint8_t* pixel = row + x * 4;
+            pixel[0] = encode(channels[0], scale);
+            pixel[1] = encode(channels[1], scale);
+            pixel[2] = encode(channels[2], scale);
+            pixel[3] = encode(sign * distance, scale);
+        }
+    }
+}
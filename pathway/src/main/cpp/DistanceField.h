@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_DISTANCE_FIELD_H
+#define PATHWAY_DISTANCE_FIELD_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+#include <atomic>
+
+#include <stdint.h>
+
+// Size of the square tiles rendered by each thread, in pixels
+constexpr int kDistanceFieldTileSize = 32;
+
+// Generates signed distance fields from the outline of a path. Distances to lines and
+// quadratics are computed exactly (up to float precision), and distances to conics and
+// cubics with Newton iterations from several starting points. Each pixel only tests the
+// segments stored in its cell of a uniform grid, which holds the segments closer than the
+// distance range to the cell, and inside/outside is decided with the fill rule of the
+// path by counting the crossings of each row with the outline.
+//
+// The output is rendered in tiles of kDistanceFieldTileSize pixels, pulled from a shared
+// counter by threads created for each call to render().
+//
+// Multi-channel fields store in the red, green and blue channels the distances to edges
+// of different colors, colored with the same heuristics as msdfgen, which preserves sharp
+// corners when the field is magnified. The median of the three channels is the signed
+// distance, and the alpha channel stores the true signed distance.
+class DistanceField {
+public:
+    enum class Type : uint8_t {
+        SingleChannel, // 1 byte per pixel
+        MultiChannel   // 4 bytes per pixel, RGBA
+    };
+
+    DistanceField() noexcept { }
+
+    DistanceField(const DistanceField&) = delete;
+    DistanceField& operator=(const DistanceField&) = delete;
+
+    // Collects the segments of the path. Conics must not be converted by the iterator.
+    // Open contours are implicitly closed, as they are when the path is filled
+    void setPath(PathIterator& iterator, bool evenOdd, bool inverse) noexcept;
+
+    // Renders the field of the path into an image of width by height pixels, on at most
+    // threadCount threads, or one thread per core if threadCount is <= 0. The pixel at
+    // (x, y) holds the distance from (x + 0.5, y + 0.5) to the outline, positive inside
+    // the path, divided by 2 * range and offset by 0.5: 128 on the outline, 255 inside
+    // and 0 outside at range pixels or more
+    void render(uint8_t* pixels, uint32_t stride, int width, int height,
+            float range, Type type, int threadCount) noexcept;
+
+    // Segment of the outline. Lines store 2 points, quadratics and conics 3, cubics 4
+    struct Edge {
+        Point points[4];
+        float weight;
+        Verb verb;
+        // Channels of the edge in a multi-channel field, bit 0 for red, 1 for green
+        // and 2 for blue
+        uint8_t color;
+        // Bounds of the control points
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    // Part of an edge along which y is monotonic, used to count crossings
+    struct Monotone {
+        int edge;
+        float t0;
+        float t1;
+        float top;
+        float bottom;
+        // +1 if y increases along the edge, -1 otherwise
+        int direction;
+    };
+
+    struct Crossing {
+        float x;
+        int direction;
+    };
+
+private:
+    void addEdge(const Edge& edge) noexcept;
+    void closeContour() noexcept;
+    void colorContour(int start) noexcept;
+    void buildIndex() noexcept;
+
+    static void* run(void* field) noexcept;
+    void renderTile(int tile, Array<Crossing>& crossings) noexcept;
+
+    Array<Edge> mEdges;
+    Array<Monotone> mMonotones;
+    // Signed area of the outline, twice, whose sign gives the side of the interior
+    float mArea = 0.0f;
+    int mContourStart = 0;
+    Point mStart{};
+    Point mLast{};
+    bool mEvenOdd = false;
+    bool mInverse = false;
+
+    // Rendering state, valid during render()
+    uint8_t* mPixels = nullptr;
+    uint32_t mStride = 0;
+    int mWidth = 0;
+    int mHeight = 0;
+    float mRange = 0.0f;
+    Type mType = Type::SingleChannel;
+    int mTilesX = 0;
+    int mTileCount = 0;
+    std::atomic<int> mNextTile{0};
+
+    // The edges closer than the range to cell i are stored in mCellEdges from
+    // mCellOffsets[i] until mCellOffsets[i + 1]
+    int mCellsX = 0;
+    Array<int> mCellOffsets;
+    Array<int> mCellEdges;
+
+    // Same as the cells for the monotone parts of the edges spanning each row of tiles
+    Array<int> mBandOffsets;
+    Array<int> mBandMonotones;
+};
+
+#endif //PATHWAY_DISTANCE_FIELD_H
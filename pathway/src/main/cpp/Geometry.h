@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_GEOMETRY_H
+#define PATHWAY_GEOMETRY_H
+
+#include "Path.h"
+
+#include "math/vec2.h"
+
+#include <cmath>
+
+constexpr Point toPoint(filament::math::float2 v) noexcept {
+    return { .x = v.x, .y = v.y };
+}
+
+constexpr filament::math::float2 fromPoint(Point v) noexcept {
+    return filament::math::float2{v.x, v.y};
+}
+
+inline Point lerp(Point a, Point b, float t) noexcept {
+    return { a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t };
+}
+
+// Splits the quadratic src at t. The first half is stored in dst[0..2] and the
+// second half in dst[2..4]
+inline void splitQuadratic(const Point src[3], float t, Point dst[5]) noexcept {
+    Point ab = lerp(src[0], src[1], t);
+    Point bc = lerp(src[1], src[2], t);
+    dst[0] = src[0];
+    dst[1] = ab;
+    dst[2] = lerp(ab, bc, t);
+    dst[3] = bc;
+    dst[4] = src[2];
+}
+
+// Splits the cubic src at t. The first half is stored in dst[0..3] and the
+// second half in dst[3..6]
+inline void splitCubic(const Point src[4], float t, Point dst[7]) noexcept {
+    Point ab = lerp(src[0], src[1], t);
+    Point bc = lerp(src[1], src[2], t);
+    Point cd = lerp(src[2], src[3], t);
+    Point abc = lerp(ab, bc, t);
+    Point bcd = lerp(bc, cd, t);
+    dst[0] = src[0];
+    dst[1] = ab;
+    dst[2] = abc;
+    dst[3] = lerp(abc, bcd, t);
+    dst[4] = bcd;
+    dst[5] = cd;
+    dst[6] = src[3];
+}
+
+// Upper bound of max|p''(t)| / 8 for a quadratic (degree 2) or a cubic (degree 3). The
+// distance between the curve and the chord of a piece of parametric length h is bounded
+// by this value times h^2, so n pieces of equal parametric length approximate the curve
+// within error / n^2
+inline float flatteningError(const Point* p, int degree) noexcept {
+    const float dx0 = p[0].x - 2.0f * p[1].x + p[2].x;
+    const float dy0 = p[0].y - 2.0f * p[1].y + p[2].y;
+    const float dd0 = std::sqrt(dx0 * dx0 + dy0 * dy0);
+    // p''(t) = 2 (p0 - 2 p1 + p2)
+    if (degree == 2) return dd0 * 0.25f;
+    // |p''(t)| <= 6 max(|p0 - 2 p1 + p2|, |p1 - 2 p2 + p3|)
+    const float dx1 = p[1].x - 2.0f * p[2].x + p[3].x;
+    const float dy1 = p[1].y - 2.0f * p[2].y + p[3].y;
+    const float dd1 = std::sqrt(dx1 * dx1 + dy1 * dy1);
+    return (dd0 > dd1 ? dd0 : dd1) * 0.75f;
+}
+
+// Degree elevation, the resulting cubic is exactly the same curve as the source line
+inline void lineToCubic(const Point src[2], Point dst[4]) noexcept {
+    dst[0] = src[0];
+    dst[1] = lerp(src[0], src[1], 1.0f / 3.0f);
+    dst[2] = lerp(src[0], src[1], 2.0f / 3.0f);
+    dst[3] = src[1];
+}
+
+// Degree elevation, the resulting cubic is exactly the same curve as the source quadratic
+inline void quadraticToCubic(const Point src[3], Point dst[4]) noexcept {
+    dst[0] = src[0];
+    dst[1] = lerp(src[0], src[1], 2.0f / 3.0f);
+    dst[2] = lerp(src[2], src[1], 2.0f / 3.0f);
+    dst[3] = src[2];
+}
+
+#endif //PATHWAY_GEOMETRY_H
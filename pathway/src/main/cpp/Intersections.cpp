@@ -0,0 +1,519 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Intersections.h"
+#include "Monotonic.h"
+
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+using Segment = Intersector::Segment;
+using Piece = Intersector::Piece;
+using Contour = Intersector::Contour;
+using Intersection = Intersector::Intersection;
+
+// Maximum number of subdivisions of a pair of pieces, after which the sub-pieces are
+// treated as lines
+constexpr int kMaxDepth = 48;
+
+static int pointCount(Verb verb) noexcept {
+    switch (verb) {
+        case Verb::Line: return 2;
+        case Verb::Cubic: return 4;
+        default: return 3;
+    }
+}
+
+static Point evaluate(const Segment& segment, float t) noexcept {
+    const Point* p = segment.points;
+    const float u = 1.0f - t;
+    switch (segment.verb) {
+        case Verb::Line:
+            return { p[0].x + (p[1].x - p[0].x) * t, p[0].y + (p[1].y - p[0].y) * t };
+        case Verb::Quadratic: {
+            const float a = u * u;
+            const float b = 2.0f * t * u;
+            const float c = t * t;
+            return { a * p[0].x + b * p[1].x + c * p[2].x, a * p[0].y + b * p[1].y + c * p[2].y };
+        }
+        case Verb::Conic: {
+            const float a = u * u;
+            const float b = 2.0f * t * u * segment.weight;
+            const float c = t * t;
+            const float d = 1.0f / (a + b + c);
+            return {
+                (a * p[0].x + b * p[1].x + c * p[2].x) * d,
+                (a * p[0].y + b * p[1].y + c * p[2].y) * d
+            };
+        }
+        default: {
+            const float a = u * u * u;
+            const float b = 3.0f * t * u * u;
+            const float c = 3.0f * t * t * u;
+            const float d = t * t * t;
+            return {
+                a * p[0].x + b * p[1].x + c * p[2].x + d * p[3].x,
+                a * p[0].y + b * p[1].y + c * p[2].y + d * p[3].y
+            };
+        }
+    }
+}
+
+void Intersector::addPath(PathIterator& iterator, int path) noexcept {
+    Point points[4];
+    int index = 0;
+
+    mContourSegment = mSegments.size();
+    mContourPiece = mPieces.size();
+    mStart = mLast = Point{};
+
+    while (iterator.hasNext()) {
+        const Verb verb = iterator.next(points);
+
+        Segment segment;
+        segment.verb = verb;
+        segment.weight = 0.0f;
+        segment.path = uint8_t(path);
+        segment.index = index;
+
+        switch (verb) {
+            case Verb::Move:
+                closeContour();
+                mStart = mLast = points[0];
+                break;
+            case Verb::Line:
+            case Verb::Quadratic:
+            case Verb::Conic:
+            case Verb::Cubic: {
+                const int count = pointCount(verb);
+                memcpy(segment.points, points, sizeof(Point) * count);
+                if (verb == Verb::Conic) segment.weight = points[3].x;
+                addSegment(segment);
+                mLast = points[count - 1];
+                break;
+            }
+            case Verb::Close:
+                if (mLast.x != mStart.x || mLast.y != mStart.y) {
+                    segment.verb = Verb::Line;
+                    segment.points[0] = mLast;
+                    segment.points[1] = mStart;
+                    addSegment(segment);
+                }
+                mLast = mStart;
+                closeContour();
+                break;
+            case Verb::Done:
+                break;
+        }
+
+        index++;
+    }
+
+    closeContour();
+}
+
+void Intersector::addSegment(const Segment& segment_) noexcept {
+    const int count = pointCount(segment_.verb);
+    if (!areFinite(segment_.points, count)) return;
+
+    bool degenerate = true;
+    for (int i = 1; i < count && degenerate; i++) {
+        degenerate = segment_.points[i].x == segment_.points[0].x &&
+                segment_.points[i].y == segment_.points[0].y;
+    }
+    if (degenerate) return;
+
+    Segment& segment = *mSegments.grow(1);
+    segment = segment_;
+    segment.contour = mContours.size();
+
+    float ts[6];
+    ts[0] = 0.0f;
+    const int extremaCount = findExtrema(segment.verb, segment.points, segment.weight, ts + 1);
+    ts[extremaCount + 1] = 1.0f;
+
+    float t0 = 0.0f;
+    Point start = segment.points[0];
+    for (int i = 0; i <= extremaCount; i++) {
+        const float t1 = ts[i + 1];
+        const Point end = i == extremaCount ? segment.points[count - 1] : evaluate(segment, t1);
+        if (t1 - t0 > 1e-6f || i == extremaCount) {
+            Piece& piece = *mPieces.grow(1);
+            piece.segment = mSegments.size() - 1;
+            piece.order = mPieces.size() - 1 - mContourPiece;
+            piece.t0 = t0;
+            piece.t1 = t1;
+            piece.start = start;
+            piece.end = end;
+            piece.left = start.x < end.x ? start.x : end.x;
+            piece.right = start.x < end.x ? end.x : start.x;
+            piece.top = start.y < end.y ? start.y : end.y;
+            piece.bottom = start.y < end.y ? end.y : start.y;
+            t0 = t1;
+            start = end;
+        }
+    }
+}
+
+void Intersector::closeContour() noexcept {
+    if (mSegments.size() > mContourSegment) {
+        const Point start = mPieces[mContourPiece].start;
+        const Point end = mPieces.back().end;
+        mContours.push({
+                mContourSegment,
+                mSegments.size() - 1,
+                mPieces.size() - mContourPiece,
+                start.x == end.x && start.y == end.y
+        });
+    }
+    mContourSegment = mSegments.size();
+    mContourPiece = mPieces.size();
+}
+
+bool Intersector::isAdjacent(const Piece& a, const Piece& b, Point* joint) const noexcept {
+    const int contour = mSegments[a.segment].contour;
+    if (contour != mSegments[b.segment].contour) return false;
+
+    if (b.order == a.order + 1) {
+        *joint = a.end;
+        return true;
+    }
+    if (a.order == b.order + 1) {
+        *joint = b.end;
+        return true;
+    }
+
+    const Contour& c = mContours[contour];
+    if (c.closed && c.pieceCount > 2) {
+        const int last = c.pieceCount - 1;
+        if (a.order == last && b.order == 0) {
+            *joint = a.end;
+            return true;
+        }
+        if (b.order == last && a.order == 0) {
+            *joint = b.end;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Intersector::isAdjacent(int segment0, int segment1) const noexcept {
+    if (segment0 == segment1) return true;
+
+    const int contour = mSegments[segment0].contour;
+    if (contour != mSegments[segment1].contour) return false;
+    if (segment0 == segment1 + 1 || segment1 == segment0 + 1) return true;
+
+    const Contour& c = mContours[contour];
+    return c.closed &&
+            ((segment0 == c.firstSegment && segment1 == c.lastSegment) ||
+             (segment1 == c.firstSegment && segment0 == c.lastSegment));
+}
+
+static float cross(float ax, float ay, float bx, float by) noexcept {
+    return ax * by - ay * bx;
+}
+
+static inline float minOf(float a, float b) noexcept {
+    return a < b ? a : b;
+}
+
+static inline float maxOf(float a, float b) noexcept {
+    return a > b ? a : b;
+}
+
+static inline float clamp01(float v) noexcept {
+    return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+}
+
+// Returns true if the bounds of two monotonic pieces, given by their end points, are
+// further apart than the tolerance
+static bool isDisjoint(Point a0, Point a1, Point b0, Point b1, float tolerance) noexcept {
+    return minOf(a0.x, a1.x) > maxOf(b0.x, b1.x) + tolerance ||
+            minOf(b0.x, b1.x) > maxOf(a0.x, a1.x) + tolerance ||
+            minOf(a0.y, a1.y) > maxOf(b0.y, b1.y) + tolerance ||
+            minOf(b0.y, b1.y) > maxOf(a0.y, a1.y) + tolerance;
+}
+
+// Largest distance between the piece of curve between t0 and t1, sampled at 1/4, 1/2
+// and 3/4, and its chord. Sampling several points catches inflections
+static float flatness(const Segment& segment, float t0, float t1,
+        Point p0, Point p1) noexcept {
+    const float dx = p1.x - p0.x;
+    const float dy = p1.y - p0.y;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    float distance = 0.0f;
+    for (int i = 1; i <= 3; i++) {
+        const Point p = evaluate(segment, t0 + (t1 - t0) * (float(i) * 0.25f));
+        const float d = length > 0.0f ?
+                std::fabs(cross(dx, dy, p.x - p0.x, p.y - p0.y)) / length :
+                std::sqrt((p.x - p0.x) * (p.x - p0.x) + (p.y - p0.y) * (p.y - p0.y));
+        if (d > distance) distance = d;
+    }
+    return distance;
+}
+
+void Intersector::intersectPieces(const Piece& a, const Piece& b) noexcept {
+    struct Range {
+        float a0;
+        float a1;
+        float b0;
+        float b1;
+        Point pa0;
+        Point pa1;
+        Point pb0;
+        Point pb1;
+        int depth;
+    };
+
+    const Segment& sa = mSegments[a.segment];
+    const Segment& sb = mSegments[b.segment];
+    const float tolerance = mTolerance;
+
+    // Depth first, each range pushes at most 2 ranges one level deeper
+    Range stack[kMaxDepth + 2];
+    int top = 0;
+    stack[top++] = { a.t0, a.t1, b.t0, b.t1, a.start, a.end, b.start, b.end, 0 };
+
+    while (top > 0) {
+        const Range r = stack[--top];
+
+        // Monotonic pieces are bounded by their end points
+        if (isDisjoint(r.pa0, r.pa1, r.pb0, r.pb1, tolerance)) continue;
+
+        const bool last = r.depth >= kMaxDepth;
+        const bool flatA = sa.verb == Verb::Line || last ||
+                flatness(sa, r.a0, r.a1, r.pa0, r.pa1) <= tolerance;
+        const bool flatB = sb.verb == Verb::Line || last ||
+                flatness(sb, r.b0, r.b1, r.pb0, r.pb1) <= tolerance;
+
+        if (!flatA || !flatB) {
+            bool splitA = !flatA;
+            if (!flatA && !flatB) {
+                // Split the longest piece
+                const float la = std::fabs(r.pa1.x - r.pa0.x) + std::fabs(r.pa1.y - r.pa0.y);
+                const float lb = std::fabs(r.pb1.x - r.pb0.x) + std::fabs(r.pb1.y - r.pb0.y);
+                splitA = la >= lb;
+            }
+            if (splitA) {
+                const float t = (r.a0 + r.a1) * 0.5f;
+                const Point p = evaluate(sa, t);
+                stack[top++] = { t, r.a1, r.b0, r.b1, p, r.pa1, r.pb0, r.pb1, r.depth + 1 };
+                stack[top++] = { r.a0, t, r.b0, r.b1, r.pa0, p, r.pb0, r.pb1, r.depth + 1 };
+            } else {
+                const float t = (r.b0 + r.b1) * 0.5f;
+                const Point p = evaluate(sb, t);
+                stack[top++] = { r.a0, r.a1, t, r.b1, r.pa0, r.pa1, p, r.pb1, r.depth + 1 };
+                stack[top++] = { r.a0, r.a1, r.b0, t, r.pa0, r.pa1, r.pb0, p, r.depth + 1 };
+            }
+            continue;
+        }
+
+        // Both pieces are lines, intersect them
+        const float rx = r.pa1.x - r.pa0.x;
+        const float ry = r.pa1.y - r.pa0.y;
+        const float sx = r.pb1.x - r.pb0.x;
+        const float sy = r.pb1.y - r.pb0.y;
+        const float qx = r.pb0.x - r.pa0.x;
+        const float qy = r.pb0.y - r.pa0.y;
+        const float lr = std::sqrt(rx * rx + ry * ry);
+        const float ls = std::sqrt(sx * sx + sy * sy);
+        const float denominator = cross(rx, ry, sx, sy);
+
+        // Tolerance expressed in the parameter of each line
+        const float er = lr > 0.0f ? tolerance / lr : 0.0f;
+        const float es = ls > 0.0f ? tolerance / ls : 0.0f;
+
+        if (std::fabs(denominator) > 1e-6f * lr * ls) {
+            float u = cross(qx, qy, sx, sy) / denominator;
+            float v = cross(qx, qy, rx, ry) / denominator;
+            if (u < -er || u > 1.0f + er || v < -es || v > 1.0f + es) continue;
+            u = u < 0.0f ? 0.0f : (u > 1.0f ? 1.0f : u);
+            v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+            addIntersection(a, r.a0 + (r.a1 - r.a0) * u, b, r.b0 + (r.b1 - r.b0) * v,
+                    { r.pa0.x + rx * u, r.pa0.y + ry * u });
+            continue;
+        }
+
+        // Parallel lines, they intersect if they overlap: every end point of a line
+        // that lies on the other line is an intersection
+        const float distance = lr >= ls ?
+                (lr > 0.0f ? std::fabs(cross(qx, qy, rx, ry)) / lr :
+                        std::sqrt(qx * qx + qy * qy)) :
+                std::fabs(cross(qx, qy, sx, sy)) / ls;
+        if (distance > tolerance) continue;
+
+        if (ls > 0.0f) {
+            const float v0 = -(qx * sx + qy * sy) / (ls * ls);
+            const float v1 = ((r.pa1.x - r.pb0.x) * sx + (r.pa1.y - r.pb0.y) * sy) / (ls * ls);
+            if (v0 >= -es && v0 <= 1.0f + es) {
+                addIntersection(a, r.a0, b, r.b0 + (r.b1 - r.b0) * clamp01(v0), r.pa0);
+            }
+            if (v1 >= -es && v1 <= 1.0f + es) {
+                addIntersection(a, r.a1, b, r.b0 + (r.b1 - r.b0) * clamp01(v1), r.pa1);
+            }
+        }
+        if (lr > 0.0f) {
+            const float u0 = (qx * rx + qy * ry) / (lr * lr);
+            const float u1 = ((r.pb1.x - r.pa0.x) * rx + (r.pb1.y - r.pa0.y) * ry) / (lr * lr);
+            if (u0 >= -er && u0 <= 1.0f + er) {
+                addIntersection(a, r.a0 + (r.a1 - r.a0) * clamp01(u0), b, r.b0, r.pb0);
+            }
+            if (u1 >= -er && u1 <= 1.0f + er) {
+                addIntersection(a, r.a0 + (r.a1 - r.a0) * clamp01(u1), b, r.b1, r.pb1);
+            }
+        } else if (ls == 0.0f) {
+            addIntersection(a, r.a0, b, r.b0, r.pa0);
+        }
+    }
+}
+
+void Intersector::addIntersection(const Piece& a, float ta, const Piece& b, float tb,
+        Point p) noexcept {
+    if (mSelf) {
+        // Adjacent pieces always meet at their shared end point
+        Point joint;
+        if (isAdjacent(a, b, &joint)) {
+            const float dx = p.x - joint.x;
+            const float dy = p.y - joint.y;
+            if (dx * dx + dy * dy <= mTolerance * mTolerance) return;
+        }
+    }
+
+    int segment0 = a.segment;
+    int segment1 = b.segment;
+    if (mSelf && (segment0 > segment1 || (segment0 == segment1 && ta > tb))) {
+        const int segment = segment0;
+        segment0 = segment1;
+        segment1 = segment;
+        const float t = ta;
+        ta = tb;
+        tb = t;
+    }
+
+    // Segment indices are stored until duplicates are removed
+    mIntersections.push({ p.x, p.y, segment0, ta, segment1, tb });
+}
+
+static int compareX(const void* lhs, const void* rhs) {
+    const float a = static_cast<const Intersection*>(lhs)->x;
+    const float b = static_cast<const Intersection*>(rhs)->x;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static int compareSegments(const void* lhs, const void* rhs) {
+    const auto* a = static_cast<const Intersection*>(lhs);
+    const auto* b = static_cast<const Intersection*>(rhs);
+    if (a->segment0 != b->segment0) return a->segment0 < b->segment0 ? -1 : 1;
+    if (a->t0 != b->t0) return a->t0 < b->t0 ? -1 : 1;
+    if (a->segment1 != b->segment1) return a->segment1 < b->segment1 ? -1 : 1;
+    return a->t1 < b->t1 ? -1 : (a->t1 > b->t1 ? 1 : 0);
+}
+
+// The same intersection is found more than once when it lies on the end points of pieces
+// or segments: intersections closer than the tolerance are merged if they are on the same
+// or adjacent segments
+void Intersector::removeDuplicates() noexcept {
+    const int count = mIntersections.size();
+    if (count == 0) return;
+
+    Intersection* intersections = mIntersections.data();
+    qsort(intersections, count, sizeof(Intersection), compareX);
+
+    // Duplicates are marked with a negative segment0
+    const float tolerance = mTolerance;
+    for (int i = 0; i < count; i++) {
+        const Intersection& a = intersections[i];
+        if (a.segment0 < 0) continue;
+        for (int j = i + 1; j < count && intersections[j].x - a.x <= tolerance; j++) {
+            Intersection& b = intersections[j];
+            if (b.segment0 < 0 || std::fabs(b.y - a.y) > tolerance) continue;
+            bool same = isAdjacent(a.segment0, b.segment0) && isAdjacent(a.segment1, b.segment1);
+            if (!same && mSelf) {
+                same = isAdjacent(a.segment0, b.segment1) && isAdjacent(a.segment1, b.segment0);
+            }
+            if (same) b.segment0 = -1;
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        Intersection intersection = intersections[i];
+        if (intersection.segment0 < 0) continue;
+        intersection.segment0 = mSegments[intersection.segment0].index;
+        intersection.segment1 = mSegments[intersection.segment1].index;
+        intersections[kept++] = intersection;
+    }
+    mIntersections.resize(kept);
+
+    qsort(intersections, kept, sizeof(Intersection), compareSegments);
+}
+
+static int compareLeft(const void* lhs, const void* rhs) {
+    const float a = static_cast<const Piece*>(lhs)->left;
+    const float b = static_cast<const Piece*>(rhs)->left;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+void Intersector::intersect(bool self, float tolerance) noexcept {
+    PATHWAY_TRACE("pathway::Intersector::intersect");
+
+    mSelf = self;
+    mTolerance = tolerance > 0.0f ? tolerance : 0.0f;
+    mIntersections.clear();
+    mActive.clear();
+
+    // Pieces only refer to each other through their segment and order
+    Piece* pieces = mPieces.data();
+    const int count = mPieces.size();
+    qsort(pieces, count, sizeof(Piece), compareLeft);
+
+    for (int i = 0; i < count; i++) {
+        const Piece& piece = pieces[i];
+        const int path = mSegments[piece.segment].path;
+        if (self && path != 0) continue;
+
+        // Retire the pieces entirely left of the current piece
+        int kept = 0;
+        for (int j = 0; j < mActive.size(); j++) {
+            const int index = mActive[j];
+            if (pieces[index].right + mTolerance < piece.left) continue;
+            mActive[kept++] = index;
+
+            const Piece& other = pieces[index];
+            if (!self && mSegments[other.segment].path == path) continue;
+            if (other.top > piece.bottom + mTolerance ||
+                    piece.top > other.bottom + mTolerance) {
+                continue;
+            }
+
+            if (path == 0) {
+                intersectPieces(piece, other);
+            } else {
+                intersectPieces(other, piece);
+            }
+        }
+        mActive.resize(kept);
+        mActive.push(i);
+    }
+
+    removeDuplicates();
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_INTERSECTIONS_H
+#define PATHWAY_INTERSECTIONS_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+#include <stdint.h>
+
+// Finds the intersections between the segments of two paths, or between the segments of
+// a single path. Segments are split into pieces monotonic in x and y, whose bounds are
+// the bounds of their end points. A sweep along x over the bounds of the pieces finds
+// the candidate pairs, and each pair is refined by recursively splitting the parameter
+// ranges of the pieces, discarding the sub-pieces whose bounds do not overlap, until
+// both are flat within the tolerance. The intersection of their chords then gives the
+// position and the parameters of the intersection.
+class Intersector {
+public:
+    Intersector() noexcept { }
+
+    Intersector(const Intersector&) = delete;
+    Intersector& operator=(const Intersector&) = delete;
+
+    // Adds the segments of the path with the specified id, 0 or 1. Conics must not be
+    // converted by the iterator. The index of a segment is the number of verbs returned
+    // by the iterator before it, and close verbs are treated as lines
+    void addPath(PathIterator& iterator, int path) noexcept;
+
+    // Finds the intersections between the segments of path 0 and the segments of path 1,
+    // or between the segments of path 0 if self is true. In that case, adjacent segments
+    // do not intersect at their shared end point
+    void intersect(bool self, float tolerance) noexcept;
+
+    struct Intersection {
+        float x;
+        float y;
+        // Index and parameter of the intersection on each segment. When intersecting a
+        // path with itself, segment0 <= segment1
+        int segment0;
+        float t0;
+        int segment1;
+        float t1;
+    };
+
+    // Intersections sorted by segment0 then t0, valid after intersect()
+    const Array<Intersection>& intersections() const noexcept { return mIntersections; }
+
+    struct Segment {
+        Point points[4];
+        float weight;
+        Verb verb;
+        uint8_t path;
+        int index;
+        int contour;
+    };
+
+    // Part of a segment monotonic in x and y
+    struct Piece {
+        int segment;
+        // Sequence number of the piece in its contour, to find adjacent pieces
+        int order;
+        float t0;
+        float t1;
+        Point start;
+        Point end;
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    struct Contour {
+        int firstSegment;
+        int lastSegment;
+        int pieceCount;
+        // True if the contour ends where it starts
+        bool closed;
+    };
+
+private:
+    void addSegment(const Segment& segment) noexcept;
+    void closeContour() noexcept;
+    bool isAdjacent(const Piece& a, const Piece& b, Point* joint) const noexcept;
+    bool isAdjacent(int segment0, int segment1) const noexcept;
+    void intersectPieces(const Piece& a, const Piece& b) noexcept;
+    void addIntersection(const Piece& a, float ta, const Piece& b, float tb,
+            Point p) noexcept;
+    void removeDuplicates() noexcept;
+
+    Array<Segment> mSegments;
+    Array<Piece> mPieces;
+    Array<Contour> mContours;
+    int mContourSegment = 0;
+    int mContourPiece = 0;
+    Point mStart{};
+    Point mLast{};
+
+    // Valid during intersect()
+    bool mSelf = false;
+    float mTolerance = 0.0f;
+    Array<int> mActive;
+    Array<Intersection> mIntersections;
+};
+
+#endif //PATHWAY_INTERSECTIONS_H
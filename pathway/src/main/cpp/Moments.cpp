@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Moments.h"
+
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+
+// Nodes and weights of the 6 point Gauss-Legendre rule, mapped to [0, 1]
+constexpr int kGaussCount = 6;
+constexpr double kGaussNodes[kGaussCount] = {
+        0.5 - 0.5 * 0.9324695142031521, 0.5 - 0.5 * 0.6612093864662645,
+        0.5 - 0.5 * 0.2386191860831969, 0.5 + 0.5 * 0.2386191860831969,
+        0.5 + 0.5 * 0.6612093864662645, 0.5 + 0.5 * 0.9324695142031521
+};
+constexpr double kGaussWeights[kGaussCount] = {
+        0.5 * 0.1713244923791704, 0.5 * 0.3607615730481386, 0.5 * 0.4679139345726910,
+        0.5 * 0.4679139345726910, 0.5 * 0.3607615730481386, 0.5 * 0.1713244923791704
+};
+
+// Number of sub-intervals used to integrate conics, whose integrands are not polynomials
+constexpr int kConicIntervals = 4;
+// Maximum number of bisections when computing arc lengths
+constexpr int kMaxLengthDepth = 10;
+
+namespace {
+
+// Segment relative to the origin of its contour, in double precision
+struct Segment {
+    double x[4];
+    double y[4];
+    double weight;
+    Verb verb;
+};
+
+// Integrals along the outline of a contour
+struct Integrals {
+    double area;
+    double mx;  // x
+    double my;  // y
+    double mxx; // x^2
+    double mxy; // x y
+    double myy; // y^2
+    double length;
+    double lx;  // x along the outline, for the centroid of zero area contours
+    double ly;  // y along the outline
+};
+
+}
+
+static void evaluate(const Segment& s, double t,
+        double& x, double& y, double& dx, double& dy) noexcept {
+    const double u = 1.0 - t;
+    switch (s.verb) {
+        case Verb::Line:
+            x = s.x[0] + (s.x[1] - s.x[0]) * t;
+            y = s.y[0] + (s.y[1] - s.y[0]) * t;
+            dx = s.x[1] - s.x[0];
+            dy = s.y[1] - s.y[0];
+            break;
+        case Verb::Quadratic:
+            x = s.x[0] * u * u + s.x[1] * 2.0 * t * u + s.x[2] * t * t;
+            y = s.y[0] * u * u + s.y[1] * 2.0 * t * u + s.y[2] * t * t;
+            dx = 2.0 * ((s.x[1] - s.x[0]) * u + (s.x[2] - s.x[1]) * t);
+            dy = 2.0 * ((s.y[1] - s.y[0]) * u + (s.y[2] - s.y[1]) * t);
+            break;
+        case Verb::Conic: {
+            // p(t) = n(t) / d(t), p'(t) = (n'(t) - p(t) d'(t)) / d(t)
+            const double w = s.weight;
+            const double d = u * u + 2.0 * w * t * u + t * t;
+            const double dd = 2.0 * (w - 1.0) * (1.0 - 2.0 * t);
+            x = (s.x[0] * u * u + s.x[1] * 2.0 * w * t * u + s.x[2] * t * t) / d;
+            y = (s.y[0] * u * u + s.y[1] * 2.0 * w * t * u + s.y[2] * t * t) / d;
+            dx = (2.0 * ((w * s.x[1] - s.x[0]) * u + (s.x[2] - w * s.x[1]) * t) - x * dd) / d;
+            dy = (2.0 * ((w * s.y[1] - s.y[0]) * u + (s.y[2] - w * s.y[1]) * t) - y * dd) / d;
+            break;
+        }
+        default:
+            x = s.x[0] * u * u * u + s.x[1] * 3.0 * t * u * u + s.x[2] * 3.0 * t * t * u +
+                    s.x[3] * t * t * t;
+            y = s.y[0] * u * u * u + s.y[1] * 3.0 * t * u * u + s.y[2] * 3.0 * t * t * u +
+                    s.y[3] * t * t * t;
+            dx = 3.0 * ((s.x[1] - s.x[0]) * u * u + (s.x[2] - s.x[1]) * 2.0 * t * u +
+                    (s.x[3] - s.x[2]) * t * t);
+            dy = 3.0 * ((s.y[1] - s.y[0]) * u * u + (s.y[2] - s.y[1]) * 2.0 * t * u +
+                    (s.y[3] - s.y[2]) * t * t);
+            break;
+    }
+}
+
+// Adds the integrals of Green's theorem over [t0, t1]: the integral over the area of
+// dQ/dx - dP/dy is the integral along the outline of P dx + Q dy
+static void integrateArea(const Segment& s, double t0, double t1, Integrals& r) noexcept {
+    const double h = t1 - t0;
+    for (int i = 0; i < kGaussCount; i++) {
+        double x, y, dx, dy;
+        evaluate(s, t0 + h * kGaussNodes[i], x, y, dx, dy);
+        const double w = kGaussWeights[i] * h;
+        r.area += w * 0.5 * (x * dy - y * dx);
+        r.mx += w * 0.5 * x * x * dy;
+        r.my -= w * 0.5 * y * y * dx;
+        r.mxx += w * (1.0 / 3.0) * x * x * x * dy;
+        r.mxy += w * 0.5 * x * x * y * dy;
+        r.myy -= w * (1.0 / 3.0) * y * y * y * dx;
+    }
+}
+
+static void gaussLength(const Segment& s, double t0, double t1, double out[3]) noexcept {
+    const double h = t1 - t0;
+    out[0] = out[1] = out[2] = 0.0;
+    for (int i = 0; i < kGaussCount; i++) {
+        double x, y, dx, dy;
+        evaluate(s, t0 + h * kGaussNodes[i], x, y, dx, dy);
+        const double w = kGaussWeights[i] * h * std::sqrt(dx * dx + dy * dy);
+        out[0] += w;
+        out[1] += w * x;
+        out[2] += w * y;
+    }
+}
+
+// Arc length, and integrals of x and y along the curve, bisecting the interval until
+// the estimates of both halves match the estimate of the whole interval
+static void integrateLength(const Segment& s, double t0, double t1, const double whole[3],
+        int depth, Integrals& r) noexcept {
+    const double tm = (t0 + t1) * 0.5;
+    double left[3];
+    double right[3];
+    gaussLength(s, t0, tm, left);
+    gaussLength(s, tm, t1, right);
+    const double length = left[0] + right[0];
+    if (depth >= kMaxLengthDepth || std::fabs(length - whole[0]) <= 1e-9 * length) {
+        r.length += length;
+        r.lx += left[1] + right[1];
+        r.ly += left[2] + right[2];
+        return;
+    }
+    integrateLength(s, t0, tm, left, depth + 1, r);
+    integrateLength(s, tm, t1, right, depth + 1, r);
+}
+
+static void integrate(const Segment& s, bool perimeter, Integrals& r) noexcept {
+    if (s.verb == Verb::Conic) {
+        for (int i = 0; i < kConicIntervals; i++) {
+            integrateArea(s, double(i) / kConicIntervals, double(i + 1) / kConicIntervals, r);
+        }
+    } else {
+        integrateArea(s, 0.0, 1.0, r);
+    }
+
+    if (!perimeter) return;
+    if (s.verb == Verb::Line) {
+        const double length = std::hypot(s.x[1] - s.x[0], s.y[1] - s.y[0]);
+        r.length += length;
+        r.lx += length * (s.x[0] + s.x[1]) * 0.5;
+        r.ly += length * (s.y[0] + s.y[1]) * 0.5;
+    } else {
+        double whole[3];
+        gaussLength(s, 0.0, 1.0, whole);
+        integrateLength(s, 0.0, 1.0, whole, 0, r);
+    }
+}
+
+static ContourMoments toMoments(const Integrals& r, Point origin) noexcept {
+    ContourMoments m{};
+    m.area = float(r.area);
+    m.perimeter = float(r.length);
+
+    // The area of a contour made of lines going back and forth is only made of rounding
+    // errors
+    if (std::fabs(r.area) > 1e-9 * r.length * r.length) {
+        const double cx = r.mx / r.area;
+        const double cy = r.my / r.area;
+        m.centroidX = float(cx + origin.x);
+        m.centroidY = float(cy + origin.y);
+        m.mu20 = float(r.mxx - cx * r.mx);
+        m.mu11 = float(r.mxy - cx * r.my);
+        m.mu02 = float(r.myy - cy * r.my);
+    } else {
+        m.area = 0.0f;
+        m.centroidX = float((r.length > 0.0 ? r.lx / r.length : 0.0) + origin.x);
+        m.centroidY = float((r.length > 0.0 ? r.ly / r.length : 0.0) + origin.y);
+    }
+    return m;
+}
+
+void computeMoments(PathIterator& iterator, Array<ContourMoments>& moments) noexcept {
+    PATHWAY_TRACE("pathway::computeMoments");
+
+    Point points[4];
+    Point start{};
+    Point last{};
+    Integrals integrals{};
+    bool empty = true;
+
+    auto addSegment = [&](Verb verb, const Point* p, float weight, bool perimeter) {
+        const int count = verb == Verb::Line ? 2 : (verb == Verb::Cubic ? 4 : 3);
+        // Segments are relative to the start of the contour, which must be finite too
+        if (!areFinite(p, count) || !areFinite(&start, 1)) return;
+        Segment s;
+        s.verb = verb;
+        s.weight = weight;
+        // Relative to the start of the contour to limit cancellations
+        for (int i = 0; i < count; i++) {
+            s.x[i] = double(p[i].x) - double(start.x);
+            s.y[i] = double(p[i].y) - double(start.y);
+        }
+        integrate(s, perimeter, integrals);
+        empty = false;
+    };
+
+    auto closeContour = [&](bool explicitClose) {
+        if (last.x != start.x || last.y != start.y) {
+            const Point line[2] = { last, start };
+            addSegment(Verb::Line, line, 0.0f, explicitClose);
+        }
+        if (!empty) moments.push(toMoments(integrals, start));
+        integrals = Integrals{};
+        empty = true;
+        last = start;
+    };
+
+    bool done = false;
+    while (!done && iterator.hasNext()) {
+        const Verb verb = iterator.next(points);
+        switch (verb) {
+            case Verb::Move:
+                closeContour(false);
+                start = last = points[0];
+                break;
+            case Verb::Line:
+                addSegment(verb, points, 0.0f, true);
+                last = points[1];
+                break;
+            case Verb::Quadratic:
+            case Verb::Conic:
+                addSegment(verb, points, points[3].x, true);
+                last = points[2];
+                break;
+            case Verb::Cubic:
+                addSegment(verb, points, 0.0f, true);
+                last = points[3];
+                break;
+            case Verb::Close:
+                closeContour(true);
+                break;
+            case Verb::Done:
+                done = true;
+                break;
+        }
+    }
+    closeContour(false);
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_MOMENTS_H
+#define PATHWAY_MOMENTS_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+// Geometric moments of the area enclosed by a contour. The area and the second moments
+// are signed: positive when the contour is clockwise on screen (y pointing down), so the
+// moments of a shape with holes are the sum of the moments of its contours
+struct ContourMoments {
+    float area;
+    float centroidX;
+    float centroidY;
+    float perimeter;
+    // Second moments about the centroid: the integrals over the area of (x - cx)^2,
+    // (x - cx) (y - cy) and (y - cy)^2
+    float mu20;
+    float mu11;
+    float mu02;
+};
+
+// Number of floats per contour, must match ContourMoments.RecordSize in Kotlin
+constexpr int kContourMomentsSize = sizeof(ContourMoments) / sizeof(float);
+
+// Computes the moments of every contour of the path in a single traversal, appended to
+// moments. Conics must not be converted by the iterator. The moments are computed with
+// Green's theorem, which turns each integral over the area into integrals along the
+// segments. Along lines, quadratics and cubics the integrands are polynomials of degree
+// 11 or less, integrated exactly by a 6 point Gauss-Legendre rule; conics use the same
+// rule over 4 sub-intervals. Open contours are implicitly closed for the area integrals,
+// but only explicitly closed contours include the closing line in their perimeter.
+// Contours of area 0 use the centroid of their outline
+void computeMoments(PathIterator& iterator, Array<ContourMoments>& moments) noexcept;
+
+#endif //PATHWAY_MOMENTS_H
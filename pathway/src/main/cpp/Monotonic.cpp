@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Monotonic.h"
+
+#include "Geometry.h"
+
+#include <cmath>
+
+// Stores in ts the roots of a t^2 + b t + c in ]0, 1[ and returns the new count
+static int addRoots(float a, float b, float c, uint8_t axis,
+        float* ts, uint8_t* axes, int count) noexcept {
+    float roots[2];
+    int rootCount = 0;
+    if (std::fabs(a) <= 1e-6f * (std::fabs(b) + std::fabs(c))) {
+        if (b != 0.0f) roots[rootCount++] = -c / b;
+    } else {
+        const float discriminant = b * b - 4.0f * a * c;
+        if (discriminant >= 0.0f) {
+            // Avoids the cancellation of -b + sqrt(discriminant)
+            const float q = -0.5f * (b + std::copysign(std::sqrt(discriminant), b));
+            roots[rootCount++] = q / a;
+            if (q != 0.0f) roots[rootCount++] = c / q;
+        }
+    }
+    for (int i = 0; i < rootCount; i++) {
+        if (roots[i] > 0.0f && roots[i] < 1.0f) {
+            ts[count] = roots[i];
+            axes[count] = axis;
+            count++;
+        }
+    }
+    return count;
+}
+
+int findExtrema(Verb verb, const Point points[4], float weight, float ts[4],
+        uint8_t axes_[4]) noexcept {
+    uint8_t storage[4];
+    uint8_t* axes = axes_ ? axes_ : storage;
+
+    const float* p = &points[0].x;
+    int count = 0;
+    for (int axis = 0; axis < 2; axis++) {
+        const float p0 = p[axis];
+        const float p1 = p[2 + axis];
+        const float p2 = p[4 + axis];
+        const uint8_t mask = uint8_t(1 << axis);
+        switch (verb) {
+            case Verb::Quadratic:
+                count = addRoots(0.0f, p0 - 2.0f * p1 + p2, p1 - p0, mask, ts, axes, count);
+                break;
+            case Verb::Conic: {
+                // See SkConic::findXExtrema()
+                const float p20 = p2 - p0;
+                const float wp10 = weight * (p1 - p0);
+                count = addRoots(weight * p20 - p20, p20 - 2.0f * wp10, wp10, mask,
+                        ts, axes, count);
+                break;
+            }
+            case Verb::Cubic: {
+                const float p3 = p[6 + axis];
+                count = addRoots(
+                        -p0 + 3.0f * (p1 - p2) + p3, 2.0f * (p0 - 2.0f * p1 + p2), p1 - p0,
+                        mask, ts, axes, count);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Insertion sort, there are at most 4 values
+    for (int i = 1; i < count; i++) {
+        const float t = ts[i];
+        const uint8_t axis = axes[i];
+        int j = i - 1;
+        for ( ; j >= 0 && ts[j] > t; j--) {
+            ts[j + 1] = ts[j];
+            axes[j + 1] = axes[j];
+        }
+        ts[j + 1] = t;
+        axes[j + 1] = axis;
+    }
+
+    // Extrema in x and y at the same parameter, at a cusp for instance
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique > 0 && ts[i] - ts[unique - 1] < 1e-6f) {
+            axes[unique - 1] |= axes[i];
+        } else {
+            ts[unique] = ts[i];
+            axes[unique] = axes[i];
+            unique++;
+        }
+    }
+
+    return unique;
+}
+
+// Conic in homogeneous coordinates, (x w, y w, w) for each point of weight w. Unlike
+// conics normalized to have end points of weight 1, splitting a conic in homogeneous
+// coordinates preserves its parameterization, which lets the remainder of a split be
+// split again at remapped parameters
+struct HomogeneousConic {
+    float x[3];
+    float y[3];
+    float z[3];
+};
+
+// Splits the conic src at t, like a quadratic. The first half is stored in first and the
+// second half in src
+static void splitConic(HomogeneousConic& src, float t, HomogeneousConic& first) noexcept {
+    for (int i = 0; i < 3; i++) {
+        float* c = i == 0 ? src.x : (i == 1 ? src.y : src.z);
+        float* f = i == 0 ? first.x : (i == 1 ? first.y : first.z);
+        const float a = c[0] + (c[1] - c[0]) * t;
+        const float b = c[1] + (c[2] - c[1]) * t;
+        f[0] = c[0];
+        f[1] = a;
+        f[2] = a + (b - a) * t;
+        c[0] = f[2];
+        c[1] = b;
+    }
+}
+
+// Stores the points of the conic, after the start point, in dst and returns its weight
+static float normalizeConic(const HomogeneousConic& conic, Point dst[3]) noexcept {
+    dst[0] = { conic.x[0] / conic.z[0], conic.y[0] / conic.z[0] };
+    dst[1] = { conic.x[1] / conic.z[1], conic.y[1] / conic.z[1] };
+    dst[2] = { conic.x[2] / conic.z[2], conic.y[2] / conic.z[2] };
+    return conic.z[1] / std::sqrt(conic.z[0] * conic.z[2]);
+}
+
+int MonotonicSplitter::split(Verb verb, const Point points[4], float weight) noexcept {
+    const int degree = verb == Verb::Cubic ? 3 : 2;
+
+    float ts[4];
+    uint8_t axes[4];
+    const int count = findExtrema(verb, points, weight, ts, axes);
+
+    Point src[4];
+    for (int i = 0; i <= degree; i++) {
+        src[i] = points[i];
+    }
+    HomogeneousConic conic{
+        { points[0].x, points[1].x * weight, points[2].x },
+        { points[0].y, points[1].y * weight, points[2].y },
+        { 1.0f, weight, 1.0f }
+    };
+
+    Point* out = mStorage;
+    out[0] = src[0];
+
+    float t0 = 0.0f;
+    for (int i = 0; i < count; i++) {
+        // Parameter of the extremum in the remainder of the segment
+        const float t = (ts[i] - t0) / (1.0f - t0);
+        t0 = ts[i];
+
+        Point dst[7];
+        if (verb == Verb::Cubic) {
+            splitCubic(src, t, dst);
+        } else if (verb == Verb::Conic) {
+            HomogeneousConic first;
+            splitConic(conic, t, first);
+            mWeights[i] = normalizeConic(first, dst);
+            normalizeConic(conic, dst + 2);
+        } else {
+            splitQuadratic(src, t, dst);
+        }
+
+        // The tangent is parallel to the y axis at an extremum in x, and the reverse
+        const Point extremum = dst[degree];
+        if (axes[i] & 1) dst[degree - 1].x = dst[degree + 1].x = extremum.x;
+        if (axes[i] & 2) dst[degree - 1].y = dst[degree + 1].y = extremum.y;
+        if (verb == Verb::Conic) {
+            // Keep the homogeneous remainder consistent with the snapped control point
+            conic.x[1] = dst[3].x * conic.z[1];
+            conic.y[1] = dst[3].y * conic.z[1];
+        }
+
+        for (int j = 1; j <= degree; j++) {
+            out[j] = dst[j];
+        }
+        out += degree;
+
+        for (int j = 0; j <= degree; j++) {
+            src[j] = dst[degree + j];
+        }
+    }
+
+    for (int j = 1; j < degree; j++) {
+        out[j] = src[j];
+    }
+    // Rounding errors in the normalization of conics would otherwise move the end point
+    out[degree] = points[degree];
+    if (verb == Verb::Conic) mWeights[count] = normalizeConic(conic, src);
+
+    mCount = count + 1;
+    return mCount;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_MONOTONIC_H
+#define PATHWAY_MONOTONIC_H
+
+#include "Path.h"
+
+// A quadratic or conic has at most one extremum per axis, and a cubic two
+constexpr int kMaxMonotonicCount = 5;
+
+// Stores in ts, in increasing order, the parameters in ]0, 1[ at which the derivative
+// of the x or y coordinate of a quadratic, conic or cubic is 0, and returns their
+// number. If axes is not null, each entry receives a mask of the axes whose derivative
+// is 0 at the matching parameter, 1 for x and 2 for y. Parameters closer than 1e-6 are
+// merged. The conic weight is ignored for other verbs
+int findExtrema(Verb verb, const Point points[4], float weight, float ts[4],
+        uint8_t axes[4] = nullptr) noexcept;
+
+// Splits quadratics, conics and cubics at the extrema of their x and y coordinates,
+// into pieces monotonic in x and y, see split()
+class MonotonicSplitter {
+public:
+    MonotonicSplitter() noexcept { }
+
+    // Splits the segment and returns the number of pieces, 1 if the segment is already
+    // monotonic. The pieces are stored in points() like the quadratics of ConicConverter:
+    // the start point followed by the degree points of each piece, the last point of a
+    // piece being the first point of the next one. The control points next to each split
+    // point are snapped to the coordinate of the extremum, so the pieces are monotonic
+    // despite rounding errors
+    int split(Verb verb, const Point points[4], float weight) noexcept;
+
+    int count() const noexcept { return mCount; }
+    const Point* points() const noexcept { return mStorage; }
+
+    // Weight of each piece, only valid when splitting conics
+    const float* weights() const noexcept { return mWeights; }
+
+private:
+    int mCount = 0;
+    Point mStorage[1 + 3 * kMaxMonotonicCount];
+    float mWeights[kMaxMonotonicCount];
+};
+
+#endif //PATHWAY_MONOTONIC_H
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Morph.h"
+
+#include "Geometry.h"
+
+// A curve made of count pieces of the same degree, sharing their end points
+struct Curve {
+    Verb verb;
+    int count;
+    Point points[1 + 3 * kMaxQuadraticCount];
+};
+
+constexpr int degree(Verb verb) noexcept {
+    return verb == Verb::Line ? 1 : (verb == Verb::Quadratic ? 2 : 3);
+}
+
+constexpr bool isCurve(Verb verb) noexcept {
+    return verb == Verb::Line || verb == Verb::Quadratic ||
+           verb == Verb::Conic || verb == Verb::Cubic;
+}
+
+static void expand(Verb verb, const Point points[4], int conicLevel, Curve& curve) noexcept {
+    curve.count = 1;
+    switch (verb) {
+        case Verb::Line:
+            curve.verb = Verb::Line;
+            curve.points[0] = points[0];
+            curve.points[1] = points[1];
+            break;
+        case Verb::Quadratic:
+            curve.verb = Verb::Quadratic;
+            curve.points[0] = points[0];
+            curve.points[1] = points[1];
+            curve.points[2] = points[2];
+            break;
+        case Verb::Conic: {
+            Conic conic(points[0], points[1], points[2], points[3].x);
+            curve.verb = Verb::Quadratic;
+            if (conicLevel >= kMaxConicToQuadCount) {
+                // At this level splitIntoQuadratics() returns only 2 quadratics for
+                // degenerate conics. Split once here instead, so that both sides of a
+                // match always get 1 << conicLevel quadratics
+                Conic halves[2];
+                conic.split(halves);
+                const int count = halves[0].splitIntoQuadratics(curve.points, conicLevel - 1);
+                curve.count = count + halves[1].splitIntoQuadratics(
+                        curve.points + 2 * count, conicLevel - 1);
+            } else {
+                curve.count = conic.splitIntoQuadratics(curve.points, conicLevel);
+            }
+            break;
+        }
+        case Verb::Cubic:
+            curve.verb = Verb::Cubic;
+            curve.points[0] = points[0];
+            curve.points[1] = points[1];
+            curve.points[2] = points[2];
+            curve.points[3] = points[3];
+            break;
+        default:
+            break;
+    }
+}
+
+// Converts the curve to count cubics. The curve must contain either 1 or count pieces
+static void toCubics(Curve& curve, int count) noexcept {
+    if (curve.verb != Verb::Cubic) {
+        const int d = degree(curve.verb);
+        // Walk backwards so we can elevate in place
+        for (int i = curve.count - 1; i >= 0; i--) {
+            Point cubic[4];
+            if (d == 1) {
+                lineToCubic(&curve.points[i], cubic);
+            } else {
+                quadraticToCubic(&curve.points[i * 2], cubic);
+            }
+            curve.points[i * 3 + 0] = cubic[0];
+            curve.points[i * 3 + 1] = cubic[1];
+            curve.points[i * 3 + 2] = cubic[2];
+            curve.points[i * 3 + 3] = cubic[3];
+        }
+        curve.verb = Verb::Cubic;
+    }
+
+    if (curve.count != count) {
+        Point remainder[4] = {
+                curve.points[0], curve.points[1], curve.points[2], curve.points[3]
+        };
+        Point* dst = curve.points;
+        for (int i = 0; i < count - 1; i++) {
+            Point split[7];
+            splitCubic(remainder, 1.0f / float(count - i), split);
+            dst[1] = split[1];
+            dst[2] = split[2];
+            dst[3] = split[3];
+            dst += 3;
+            remainder[0] = split[3];
+            remainder[1] = split[4];
+            remainder[2] = split[5];
+            remainder[3] = split[6];
+        }
+        dst[1] = remainder[1];
+        dst[2] = remainder[2];
+        dst[3] = remainder[3];
+        curve.count = count;
+    }
+}
+
+void PathMorph::addPoints(const Point* from, const Point* to, int count) noexcept {
+    float* start = mStart.grow(count * 2);
+    float* delta = mDelta.grow(count * 2);
+    for (int i = 0; i < count; i++) {
+        start[i * 2 + 0] = from[i].x;
+        start[i * 2 + 1] = from[i].y;
+        delta[i * 2 + 0] = to[i].x - from[i].x;
+        delta[i * 2 + 1] = to[i].y - from[i].y;
+    }
+}
+
+bool PathMorph::set(PathIterator& from, PathIterator& to,
+        Normalization normalization, float tolerance) noexcept {
+    mVerbs.clear();
+    mStart.clear();
+    mDelta.clear();
+
+    Point a[4];
+    Point b[4];
+    Curve curveA;
+    Curve curveB;
+
+    while (from.hasNext() && to.hasNext()) {
+        Verb verbA = from.next(a);
+        Verb verbB = to.next(b);
+
+        if (verbA == verbB && (verbA == Verb::Move || verbA == Verb::Close)) {
+            mVerbs.push(verbA);
+            if (verbA == Verb::Move) addPoints(a, b, 1);
+            continue;
+        }
+
+        if (!isCurve(verbA) || !isCurve(verbB)) return false;
+
+        // Pick the same subdivision level on both sides when matching two conics
+        int levelA = 0;
+        int levelB = 0;
+        if (verbA == Verb::Conic) {
+            levelA = Conic(a[0], a[1], a[2], a[3].x).computeQuadraticCount(tolerance);
+        }
+        if (verbB == Verb::Conic) {
+            levelB = Conic(b[0], b[1], b[2], b[3].x).computeQuadraticCount(tolerance);
+        }
+        if (verbA == Verb::Conic && verbB == Verb::Conic) {
+            levelA = levelB = levelA > levelB ? levelA : levelB;
+        }
+
+        expand(verbA, a, levelA, curveA);
+        expand(verbB, b, levelB, curveB);
+
+        if (curveA.verb != curveB.verb || curveA.count != curveB.count) {
+            if (normalization == Normalization::None) return false;
+
+            int count = curveA.count > curveB.count ? curveA.count : curveB.count;
+            if (curveA.count != count && curveA.count != 1) return false;
+            if (curveB.count != count && curveB.count != 1) return false;
+
+            toCubics(curveA, count);
+            toCubics(curveB, count);
+        }
+
+        const int d = degree(curveA.verb);
+        for (int i = 0; i < curveA.count; i++) {
+            mVerbs.push(curveA.verb);
+            addPoints(&curveA.points[i * d + 1], &curveB.points[i * d + 1], d);
+        }
+    }
+
+    return !from.hasNext() && !to.hasNext();
+}
+
+void PathMorph::interpolate(float t, float* __restrict__ out) const noexcept {
+    // Written as a plain loop over the packed floats so the compiler can vectorize it
+    const float* __restrict__ start = mStart.data();
+    const float* __restrict__ delta = mDelta.data();
+    const int count = mStart.size();
+    for (int i = 0; i < count; i++) {
+        out[i] = start[i] + delta[i] * t;
+    }
+}
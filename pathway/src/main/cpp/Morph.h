@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_MORPH_H
+#define PATHWAY_MORPH_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+// Interpolates between two paths sharing the same structure. The verb streams of
+// both paths are matched once by set(), after which interpolate() only needs to
+// run a single lerp over the packed points.
+//
+// Points are packed the same way Skia stores them: each verb only stores the points
+// it adds to the path (1 for move and line, 2 for quadratic, 3 for cubic, 0 for close).
+// Conics are always converted to quadratics, using the same number of quadratics on
+// both sides.
+class PathMorph {
+public:
+    enum class Normalization : uint8_t {
+        None,  // Matching verbs must be identical
+        Cubics // Mismatched curves are raised to cubics and subdivided if needed
+    };
+
+    PathMorph() noexcept { }
+
+    // Returns false if the two paths cannot be matched. The morph must not be used
+    // in that case
+    bool set(PathIterator& from, PathIterator& to,
+            Normalization normalization, float tolerance = 0.25f) noexcept;
+
+    int verbCount() const noexcept { return mVerbs.size(); }
+    const Verb* verbs() const noexcept { return mVerbs.data(); }
+
+    // Number of floats written by interpolate()
+    int valueCount() const noexcept { return mStart.size(); }
+
+    void interpolate(float t, float* __restrict__ out) const noexcept;
+
+private:
+    void addPoints(const Point* from, const Point* to, int count) noexcept;
+
+    Array<Verb> mVerbs;
+    Array<float> mStart;
+    Array<float> mDelta;
+};
+
+#endif //PATHWAY_MORPH_H
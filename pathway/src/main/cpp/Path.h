@@ -61,7 +61,7 @@ struct PathRef21 {
              float* conicWeights;
     __unused int conicWeightsReserve;
     __unused int conicWeightsCount;
-    __unused uint32_t generationId;
+             uint32_t generationId;
 };
 
 struct PathRef24 {
@@ -79,7 +79,7 @@ struct PathRef24 {
              float* conicWeights;
     __unused int conicWeightsReserve;
     __unused int conicWeightsCount;
-    __unused uint32_t generationId;
+             uint32_t generationId;
 };
 
 struct PathRef26 {
@@ -96,7 +96,7 @@ struct PathRef26 {
              float* conicWeights;
     __unused int conicWeightsReserve;
     __unused int conicWeightsCount;
-    __unused uint32_t generationId;
+             uint32_t generationId;
 };
 
 struct PathRef30 {
@@ -114,7 +114,7 @@ struct PathRef30 {
              float* conicWeights;
     __unused int conicWeightsReserve;
     __unused int conicWeightsCount;
-    __unused uint32_t generationId;
+             uint32_t generationId;
 };
 
 struct PathRef34 {
@@ -135,7 +135,7 @@ struct PathRef34 {
                             float* conicWeights;
                    __unused int conicWeightsSize;
                    __unused int conicWeightsCapacity;
-                   __unused uint32_t generationId;
+                            uint32_t generationId;
 };
 
 struct Path {
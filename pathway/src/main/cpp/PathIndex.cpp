@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PathIndex.h"
+#include "Stats.h"
+
+void PathIndex::build(const Verb* verbs, int count, bool forward, int interval) noexcept {
+    PATHWAY_TRACE("pathway::PathIndex::build");
+
+    mVerbCount = count;
+    mInterval = interval > 0 ? interval : kDefaultInterval;
+    mCheckpoints.clear();
+    mContours.clear();
+    mCheckpoints.reserve(count / mInterval + 1);
+
+    Position position{ };
+    for (int i = 0; i < count; i++) {
+        if (i % mInterval == 0) mCheckpoints.push(position);
+
+        Verb verb = forward ? verbs[i] : verbs[-1 - i];
+        if (verb == Verb::Move) mContours.push(position);
+
+        advance(position, verb);
+    }
+
+    // Checkpoint for the end of the path, so seeking to verbCount() is valid
+    if (count % mInterval == 0) mCheckpoints.push(position);
+}
+
+int PathIndex::contourOf(int verb) const noexcept {
+    // Last contour starting at or before the verb
+    int low = 0;
+    int high = mContours.size();
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (mContours[middle].verb <= verb) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low - 1;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_PATH_INDEX_H
+#define PATHWAY_PATH_INDEX_H
+
+#include "Array.h"
+#include "Path.h"
+
+// Index of the verbs of a path, used by PathIterator::seek() to jump to any verb
+// without iterating over the verbs before it. Every interval verbs, a checkpoint
+// records the offsets of the points and conic weights of the verb in Skia's storage,
+// and the offsets of the first verb of every contour are recorded as well. Seeking to
+// a contour is then O(1), and seeking to a verb is O(interval).
+//
+// The index only stores offsets and does not reference the path. It must be rebuilt
+// when the verbs of the path change.
+class PathIndex {
+public:
+    static constexpr int kDefaultInterval = 64;
+
+    // Offsets of a verb, and of the points and conic weights it reads, in the storage
+    // of the path. The point offset is the offset of the first point the verb adds
+    struct Position {
+        int verb;
+        int point;
+        int conicWeight;
+    };
+
+    PathIndex() noexcept { }
+
+    PathIndex(const PathIndex&) = delete;
+    PathIndex& operator=(const PathIndex&) = delete;
+
+    // Indexes count verbs stored in iteration order if forward is true, or in reverse
+    // order before the verbs pointer otherwise, see PathIterator::VerbDirection
+    void build(const Verb* verbs, int count, bool forward, int interval) noexcept;
+
+    int verbCount() const noexcept { return mVerbCount; }
+    int interval() const noexcept { return mInterval; }
+
+    int contourCount() const noexcept { return mContours.size(); }
+    const Position& contour(int index) const noexcept { return mContours[index]; }
+
+    // Returns the index of the contour the specified verb belongs to, or -1 if the
+    // verb is before the first move
+    int contourOf(int verb) const noexcept;
+
+    // Returns the closest checkpoint at or before the specified verb, which must be
+    // between 0 and verbCount() included
+    const Position& checkpoint(int verb) const noexcept {
+        return mCheckpoints[verb / mInterval];
+    }
+
+    // Number of points added to the path by a verb
+    static int pointCount(Verb verb) noexcept {
+        switch (verb) {
+            case Verb::Move:
+            case Verb::Line:
+                return 1;
+            case Verb::Quadratic:
+            case Verb::Conic:
+                return 2;
+            case Verb::Cubic:
+                return 3;
+            case Verb::Close:
+            case Verb::Done:
+                break;
+        }
+        return 0;
+    }
+
+    // Moves position past the specified verb
+    static void advance(Position& position, Verb verb) noexcept {
+        position.verb++;
+        position.point += pointCount(verb);
+        if (verb == Verb::Conic) position.conicWeight++;
+    }
+
+private:
+    Array<Position> mCheckpoints;
+    Array<Position> mContours;
+    int mVerbCount = 0;
+    int mInterval = kDefaultInterval;
+};
+
+#endif //PATHWAY_PATH_INDEX_H
@@ -15,16 +15,40 @@
  */
 
 #include "PathIterator.h"
+#include "Stats.h"
+#include "scalar.h"
+
+#include <math.h>
 
 int PathIterator::count() noexcept {
-    if (mConicEvaluation == ConicEvaluation::AsConic) {
+    // Counting is not an iteration, the segments and conversions it goes through must not
+    // be counted again when the path is iterated
+    ScopedStatsSuppression suppression;
+
+    if (mCleanup || mMonotonic) {
+        PathIterator iterator(mFirstPoint, mFirstVerb, mFirstConicWeight, mCount, mDirection,
+                mConicEvaluation, mTolerance, mCubicEvaluation, mCleanup, mMonotonic);
+        Point points[4];
+        int count = 0;
+        while (iterator.hasNext()) {
+            iterator.next(points);
+            count++;
+        }
+        return count;
+    }
+
+    if (mConicEvaluation == ConicEvaluation::AsConic &&
+            mCubicEvaluation == CubicEvaluation::AsCubic) {
         return mCount;
     }
 
+    // Use separate converters to not disturb the conversion of the current segment
+    ConicConverter converter;
+
     int count = 0;
-    const Verb* verbs = mVerbs;
-    const Point* points = mPoints;
-    const float* conicWeights = mConicWeights;
+    const Verb* verbs = mFirstVerb;
+    const Point* points = mFirstPoint;
+    const float* conicWeights = mFirstConicWeight;
 
     for (int i = 0; i < mCount; i++) {
         Verb verb = *(mDirection == VerbDirection::Forward ? verbs++ : --verbs);
@@ -39,14 +63,25 @@ int PathIterator::count() noexcept {
                 count++;
                 break;
             case Verb::Conic:
-                mConverter.toQuadratics(points - 1, *conicWeights, mTolerance);
+                if (mConicEvaluation == ConicEvaluation::AsConic) {
+                    count++;
+                } else if (mConicEvaluation == ConicEvaluation::AsCubics) {
+                    converter.toCubics(points - 1, *conicWeights, mTolerance);
+                    count += converter.cubicCount();
+                } else {
+                    converter.toQuadratics(points - 1, *conicWeights, mTolerance);
+                    count += converter.quadraticCount();
+                }
                 conicWeights++;
                 points += 2;
-                count += mConverter.quadraticCount();
                 break;
             case Verb::Cubic:
+                if (mCubicEvaluation == CubicEvaluation::AsQuadratics) {
+                    count += CubicConverter::computeQuadraticCount(points - 1, mTolerance);
+                } else {
+                    count++;
+                }
                 points += 3;
-                count++;
                 break;
             case Verb::Close:
             case Verb::Done:
@@ -59,20 +94,72 @@ int PathIterator::count() noexcept {
 }
 
 Verb PathIterator::next(Point points[4]) noexcept {
+    if (mCleanup) {
+        if (!mHasOutput) return Verb::Done;
+        const Verb verb = mOutputVerb;
+        for (int i = 0; i < 4; i++) {
+            points[i] = mOutput[i];
+        }
+        fetch();
+        return verb;
+    }
+    return nextSegment(points);
+}
+
+Verb PathIterator::nextSegment(Point points[4]) noexcept {
+    if (mMonotonicIndex < mMonotonicCount) return nextMonotonic(points);
+
+    const Verb verb = nextRaw(points);
+    if (mMonotonic &&
+            (verb == Verb::Quadratic || verb == Verb::Conic || verb == Verb::Cubic)) {
+        const int count = mMonotonicSplitter.split(verb, points, points[3].x);
+        if (count > 1) {
+            addStat(Stat::MonotonicSplits, 1);
+            mMonotonicVerb = verb;
+            mMonotonicCount = count;
+            mMonotonicIndex = 0;
+            return nextMonotonic(points);
+        }
+    }
+    return verb;
+}
+
+Verb PathIterator::nextMonotonic(Point points[4]) noexcept {
+    const Verb verb = mMonotonicVerb;
+    const int degree = verb == Verb::Cubic ? 3 : 2;
+    const Point* piece = mMonotonicSplitter.points() + mMonotonicIndex * degree;
+    for (int i = 0; i <= degree; i++) {
+        points[i] = piece[i];
+    }
+    if (verb == Verb::Conic) {
+        const float weight = mMonotonicSplitter.weights()[mMonotonicIndex];
+        points[3].x = weight;
+        points[3].y = weight;
+    }
+    mMonotonicIndex++;
+    return verb;
+}
+
+Verb PathIterator::nextRaw(Point points[4]) noexcept {
+    // The segments produced by the conversion of the last verb are still pending
+    // after mIndex reached 0
+    if (mConvertedIndex < mConvertedCount) {
+        addStat(Stat::SegmentsIterated, 1);
+
+        const int degree = mConvertedDegree;
+        const Point* converted = mConverted + mConvertedIndex * degree;
+        for (int i = 0; i <= degree; i++) {
+            points[i] = converted[i];
+        }
+        mConvertedIndex++;
+        return convertedVerb();
+    }
+
     if (mIndex <= 0) {
         return Verb::Done;
     }
 
-convertConicToQuadratic:
-    if (mConicCurrentQuadratic != mConverter.quadraticCount()) {
-        const Point* quadraticPoints = mConverter.quadratics();
-        int index = mConicCurrentQuadratic * 2;
-        points[0] = quadraticPoints[index];
-        points[1] = quadraticPoints[index + 1];
-        points[2] = quadraticPoints[index + 2];
-        mConicCurrentQuadratic++;
-        return Verb::Quadratic;
-    }
+    addStat(Stat::SegmentsIterated, 1);
 
     mIndex--;
 
@@ -104,8 +191,11 @@ convertConicToQuadratic:
 
             if (mConicEvaluation == ConicEvaluation::AsQuadratics) {
                 mConverter.toQuadratics(points, points[3].x, mTolerance);
-                mConicCurrentQuadratic = 0;
-                goto convertConicToQuadratic;
+                return nextConverted(mConverter.quadratics(), mConverter.quadraticCount(), 2,
+                        points);
+            } else if (mConicEvaluation == ConicEvaluation::AsCubics) {
+                mConverter.toCubics(points, points[3].x, mTolerance);
+                return nextConverted(mConverter.cubics(), mConverter.cubicCount(), 3, points);
             }
 
             break;
@@ -115,6 +205,13 @@ convertConicToQuadratic:
             points[2] = mPoints[1];
             points[3] = mPoints[2];
             mPoints += 3;
+
+            if (mCubicEvaluation == CubicEvaluation::AsQuadratics) {
+                mCubicConverter.toQuadratics(points, mTolerance);
+                return nextConverted(mCubicConverter.quadratics(),
+                        mCubicConverter.quadraticCount(), 2, points);
+            }
+
             break;
         case Verb::Close:
         case Verb::Done:
@@ -123,3 +220,200 @@ convertConicToQuadratic:
 
     return verb;
 }
+
+void PathIterator::seek(const PathIndex& index, int verb) noexcept {
+    PathIndex::Position position = index.checkpoint(verb);
+    const bool forward = mDirection == VerbDirection::Forward;
+    while (position.verb < verb) {
+        Verb v = forward ? mFirstVerb[position.verb] : mFirstVerb[-1 - position.verb];
+        PathIndex::advance(position, v);
+    }
+    seek(position);
+}
+
+void PathIterator::seek(const PathIndex::Position& position) noexcept {
+    mPoints = mFirstPoint + position.point;
+    mVerbs = mDirection == VerbDirection::Forward ?
+            mFirstVerb + position.verb : mFirstVerb - position.verb;
+    mConicWeights = mFirstConicWeight + position.conicWeight;
+    mIndex = mCount - position.verb;
+    mConverted = nullptr;
+    mConvertedCount = 0;
+    mConvertedIndex = 0;
+    mMonotonicCount = 0;
+    mMonotonicIndex = 0;
+
+    if (mCleanup) {
+        mHasLookahead = false;
+        mHasRun = false;
+        fetch();
+    }
+}
+
+static float distanceToSegmentSquared(Point p, Point start, Point end) noexcept {
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const float px = p.x - start.x;
+    const float py = p.y - start.y;
+    const float length = dx * dx + dy * dy;
+    float t = length > 0.0f ? (px * dx + py * dy) / length : 0.0f;
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    const float ex = px - t * dx;
+    const float ey = py - t * dy;
+    return ex * ex + ey * ey;
+}
+
+// Curves are contained in the convex hull of their control points (conics with a
+// positive weight included), so a curve whose control points are within the tolerance
+// of its chord is itself within the tolerance of its chord
+static bool isFlat(const Point* points, int last, float tolerance) noexcept {
+    const float tolerance2 = tolerance * tolerance;
+    for (int i = 1; i < last; i++) {
+        if (distanceToSegmentSquared(points[i], points[0], points[last]) > tolerance2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PathIterator::fetch() noexcept {
+    Point points[4];
+    while (true) {
+        Verb verb;
+        if (mHasLookahead) {
+            for (int i = 0; i < 4; i++) {
+                points[i] = mLookahead[i];
+            }
+            verb = mLookaheadVerb;
+            mHasLookahead = false;
+        } else if (mIndex > 0 || mConvertedIndex < mConvertedCount ||
+                mMonotonicIndex < mMonotonicCount) {
+            verb = nextSegment(points);
+
+            int last = 0;
+            switch (verb) {
+                case Verb::Line: last = 1; break;
+                case Verb::Quadratic:
+                case Verb::Conic: last = 2; break;
+                case Verb::Cubic: last = 3; break;
+                default: break;
+            }
+
+            if (last > 0) {
+                if (last > 1 && (verb != Verb::Conic || points[3].x > 0.0f) &&
+                        isFlat(points, last, mTolerance)) {
+                    verb = Verb::Line;
+                    points[1] = points[last];
+                }
+                // Lines of length 0, and flat curves that start and end at the same point
+                if (verb == Verb::Line && equals(points[0], points[1])) {
+                    addStat(Stat::SegmentsDropped, 1);
+                    continue;
+                }
+            }
+        } else {
+            // End of the path, flush the current run
+            if (mHasRun) {
+                mOutput[0] = mRunStart;
+                mOutput[1] = mRunEnd;
+                mOutputVerb = Verb::Line;
+                mHasOutput = true;
+                mHasRun = false;
+            } else {
+                mHasOutput = false;
+            }
+            return;
+        }
+
+        if (verb == Verb::Line) {
+            if (!mHasRun) {
+                startRun(points[0], points[1]);
+                continue;
+            }
+            if (extendRun(points[1])) {
+                addStat(Stat::SegmentsDropped, 1);
+                continue;
+            }
+        }
+
+        if (mHasRun) {
+            // Return the run, and the segment that ended it after it
+            for (int i = 0; i < 4; i++) {
+                mLookahead[i] = points[i];
+            }
+            mLookaheadVerb = verb;
+            mHasLookahead = true;
+
+            mOutput[0] = mRunStart;
+            mOutput[1] = mRunEnd;
+            mOutputVerb = Verb::Line;
+            mHasOutput = true;
+            mHasRun = false;
+            return;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            mOutput[i] = points[i];
+        }
+        mOutputVerb = verb;
+        mHasOutput = true;
+        return;
+    }
+}
+
+void PathIterator::startRun(Point start, Point end) noexcept {
+    mHasRun = true;
+    mRunOriented = false;
+    mRunStart = start;
+    mRunEnd = start;
+    mRunDistance = 0.0f;
+    extendRun(end);
+}
+
+bool PathIterator::extendRun(Point p) noexcept {
+    const float dx = p.x - mRunStart.x;
+    const float dy = p.y - mRunStart.y;
+    const float distance = sqrtf(dx * dx + dy * dy);
+
+    // The run would turn back, and the previous points would not all be within the
+    // new line, but past its end
+    if (distance < mRunDistance) return false;
+
+    // A point within the tolerance of the start of the run is within the tolerance of
+    // any line from the start. A point at a distance d from the start is within the
+    // tolerance of the lines whose direction is within asin(tolerance / d) of the
+    // direction of the point
+    if (distance > mTolerance) {
+        const float angle = atan2f(dy, dx);
+        const float spread = asinf(mTolerance / distance);
+        if (!mRunOriented) {
+            mRunOriented = true;
+            mRunAngle = angle;
+            mRunLow = -spread;
+            mRunHigh = spread;
+        } else {
+            float delta = angle - mRunAngle;
+            if (delta > float(M_PI)) delta -= 2.0f * float(M_PI);
+            if (delta < -float(M_PI)) delta += 2.0f * float(M_PI);
+            if (delta < mRunLow || delta > mRunHigh) return false;
+            if (delta - spread > mRunLow) mRunLow = delta - spread;
+            if (delta + spread < mRunHigh) mRunHigh = delta + spread;
+        }
+    }
+
+    mRunEnd = p;
+    mRunDistance = distance;
+    return true;
+}
+
+Verb PathIterator::nextConverted(
+        const Point* converted, int count, int degree, Point points[4]) noexcept {
+    mConverted = converted;
+    mConvertedCount = count;
+    mConvertedDegree = degree;
+    mConvertedIndex = 1;
+    for (int i = 0; i <= degree; i++) {
+        points[i] = converted[i];
+    }
+    return convertedVerb();
+}
@@ -19,6 +19,9 @@
 
 #include "Path.h"
 #include "Conic.h"
+#include "Cubic.h"
+#include "Monotonic.h"
+#include "PathIndex.h"
 
 class PathIterator {
 public:
@@ -29,52 +32,158 @@ public:
 
     enum class ConicEvaluation : uint8_t {
         AsConic,
+        AsQuadratics,
+        AsCubics
+    };
+
+    enum class CubicEvaluation : uint8_t {
+        AsCubic,
         AsQuadratics
     };
 
     PathIterator(
-            Point* points,
-            Verb* verbs,
-            float* conicWeights,
+            const Point* points,
+            const Verb* verbs,
+            const float* conicWeights,
             int count,
             VerbDirection direction,
             ConicEvaluation conicEvaluation,
-            float tolerance = 0.25f
+            float tolerance = 0.25f,
+            CubicEvaluation cubicEvaluation = CubicEvaluation::AsCubic,
+            bool cleanup = false,
+            bool monotonic = false
     ) noexcept
             : mPoints(points),
               mVerbs(verbs),
               mConicWeights(conicWeights),
+              mFirstPoint(points),
+              mFirstVerb(verbs),
+              mFirstConicWeight(conicWeights),
               mIndex(count),
               mCount(count),
               mDirection(direction),
               mConicEvaluation(conicEvaluation),
-              mTolerance(tolerance) {
+              mCubicEvaluation(cubicEvaluation),
+              mTolerance(tolerance),
+              mCleanup(cleanup),
+              mMonotonic(monotonic) {
+        if (cleanup) fetch();
     }
 
     int rawCount() const noexcept { return mCount; }
 
+    // Number of segments returned by next() over the whole path. Counting does not update
+    // the stats, see ScopedStatsSuppression
     int count() noexcept;
 
-    bool hasNext() const noexcept { return mIndex > 0; }
+    bool hasNext() const noexcept {
+        if (mCleanup) return mHasOutput;
+        return mIndex > 0 || mConvertedIndex < mConvertedCount ||
+                mMonotonicIndex < mMonotonicCount;
+    }
 
     Verb peek() const noexcept {
+        if (mCleanup) return mHasOutput ? mOutputVerb : Verb::Done;
+        if (mMonotonicIndex < mMonotonicCount) return mMonotonicVerb;
+        if (mConvertedIndex < mConvertedCount) return convertedVerb();
         auto verbs = mDirection == VerbDirection::Forward ? mVerbs : mVerbs - 1;
         return mIndex > 0 ? *verbs : Verb::Done;
     }
 
     Verb next(Point points[4]) noexcept;
 
+    // Moves the iterator to the specified raw verb, between 0 and rawCount() included,
+    // using an index built from the verbs of this iterator. The next call to next()
+    // returns the segments of that verb, and the pending segments of a converted conic
+    // or cubic, or of a monotonic split, are discarded. In cleanup mode, runs of lines
+    // are not merged across the seek position
+    void seek(const PathIndex& index, int verb) noexcept;
+
+    // Moves the iterator to the start of a contour, see PathIndex::contour()
+    void seek(const PathIndex::Position& position) noexcept;
+
 private:
+    // Returns the next segment of the path, before monotonic splitting and cleanup
+    Verb nextRaw(Point points[4]) noexcept;
+
+    // Returns the next segment of the path, split at its extrema in monotonic mode,
+    // before cleanup
+    Verb nextSegment(Point points[4]) noexcept;
+
+    // Returns the piece of the current monotonic split at mMonotonicIndex
+    Verb nextMonotonic(Point points[4]) noexcept;
+
+    // In cleanup mode, computes the segment returned by the next call to next(). Lines
+    // of length 0 are dropped, curves whose control points are within the tolerance of
+    // their chord are replaced by lines, or dropped if their chord has a length of 0,
+    // and runs of lines whose points are all within the tolerance of the line joining
+    // the start of the run to its end are replaced by that line
+    void fetch() noexcept;
+
+    // Starts a new run of collinear lines with the line from start to end
+    void startRun(Point start, Point end) noexcept;
+
+    // Appends the line from the end of the current run to p, if all the points of the
+    // run remain within the tolerance of the line from the start of the run to p
+    bool extendRun(Point p) noexcept;
+
+    // Returns the first of the count segments of the specified degree produced by the
+    // conversion of a conic or cubic, the other segments are returned by next()
+    Verb nextConverted(const Point* converted, int count, int degree, Point points[4]) noexcept;
+
+    Verb convertedVerb() const noexcept {
+        return mConvertedDegree == 2 ? Verb::Quadratic : Verb::Cubic;
+    }
+
     const Point* mPoints;
     const Verb* mVerbs;
     const float* mConicWeights;
+    // Storage of the path, for count() and seek()
+    const Point* mFirstPoint;
+    const Verb* mFirstVerb;
+    const float* mFirstConicWeight;
     int mIndex;
     const int mCount;
     const VerbDirection mDirection;
     const ConicEvaluation mConicEvaluation;
+    const CubicEvaluation mCubicEvaluation;
     const float mTolerance;
+    const bool mCleanup;
+    const bool mMonotonic;
     ConicConverter mConverter;
-    int mConicCurrentQuadratic = 0;
+    CubicConverter mCubicConverter;
+    // Segments produced by the conversion of the current conic or cubic, made of
+    // mConvertedDegree + 1 points each, the last point being shared with the next segment
+    const Point* mConverted = nullptr;
+    int mConvertedCount = 0;
+    int mConvertedIndex = 0;
+    int mConvertedDegree = 0;
+
+    // Pieces of the last segment split by mMonotonicSplitter, in monotonic mode
+    MonotonicSplitter mMonotonicSplitter;
+    int mMonotonicCount = 0;
+    int mMonotonicIndex = 0;
+    Verb mMonotonicVerb = Verb::Done;
+
+    // Cleanup state. The segment returned by the next call to next()
+    Point mOutput[4]{};
+    Verb mOutputVerb = Verb::Done;
+    bool mHasOutput = false;
+    // Segment read after the end of a run of lines, returned after the run
+    Point mLookahead[4]{};
+    Verb mLookaheadVerb = Verb::Done;
+    bool mHasLookahead = false;
+    // Current run of collinear lines. The points of the run must be within the tolerance
+    // of the line from mRunStart in the directions between mRunLow and mRunHigh, angles
+    // relative to mRunAngle, the direction of the first point farther than the tolerance
+    bool mHasRun = false;
+    bool mRunOriented = false;
+    Point mRunStart{};
+    Point mRunEnd{};
+    float mRunDistance = 0.0f;
+    float mRunAngle = 0.0f;
+    float mRunLow = 0.0f;
+    float mRunHigh = 0.0f;
 };
 
 #endif //PATHWAY_PATH_ITERATOR_H
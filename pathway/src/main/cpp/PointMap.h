@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_POINT_MAP_H
+#define PATHWAY_POINT_MAP_H
+
+#include "Path.h"
+
+#include <cstdlib>
+#include <cstring>
+
+// Hash map from points to integers, using open addressing with linear probing.
+// Points are compared bitwise, which is fine for the coordinates produced by the
+// tracers since they are always positive multiples of 0.5.
+class PointMap {
+public:
+    PointMap() noexcept { }
+    ~PointMap() noexcept { free(mSlots); }
+
+    PointMap(const PointMap&) = delete;
+    PointMap& operator=(const PointMap&) = delete;
+
+    int size() const noexcept { return mSize; }
+
+    void clear() noexcept {
+        if (mSlots) memset(mSlots, 0, sizeof(Slot) * (mMask + 1));
+        mSize = 0;
+    }
+
+    // Returns a pointer to the value associated with p, or nullptr
+    int* find(Point p) noexcept {
+        if (mSize == 0) return nullptr;
+        const uint64_t key = toKey(p);
+        for (uint32_t i = hash(key) & mMask; ; i = (i + 1) & mMask) {
+            Slot& slot = mSlots[i];
+            if (!slot.used) return nullptr;
+            if (slot.key == key) return &slot.value;
+        }
+    }
+
+    // Inserts or replaces the value associated with p
+    void insert(Point p, int value) noexcept {
+        if ((mSize + 1) * 2 > int(mMask + 1)) grow();
+        const uint64_t key = toKey(p);
+        for (uint32_t i = hash(key) & mMask; ; i = (i + 1) & mMask) {
+            Slot& slot = mSlots[i];
+            if (!slot.used) {
+                slot = { key, value, true };
+                mSize++;
+                return;
+            }
+            if (slot.key == key) {
+                slot.value = value;
+                return;
+            }
+        }
+    }
+
+    void erase(Point p) noexcept {
+        if (mSize == 0) return;
+        const uint64_t key = toKey(p);
+        uint32_t i = hash(key) & mMask;
+        for ( ; ; i = (i + 1) & mMask) {
+            if (!mSlots[i].used) return;
+            if (mSlots[i].key == key) break;
+        }
+        // Backward shift deletion, moves entries up to keep probe sequences intact
+        uint32_t j = i;
+        while (true) {
+            mSlots[i].used = false;
+            while (true) {
+                j = (j + 1) & mMask;
+                if (!mSlots[j].used) {
+                    mSize--;
+                    return;
+                }
+                uint32_t k = hash(mSlots[j].key) & mMask;
+                // Move the entry at j to i only if its home k is not in (i, j]
+                if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+                break;
+            }
+            mSlots[i] = mSlots[j];
+            i = j;
+        }
+    }
+
+private:
+    struct Slot {
+        uint64_t key;
+        int value;
+        bool used;
+    };
+
+    static uint64_t toKey(Point p) noexcept {
+        uint32_t x;
+        uint32_t y;
+        memcpy(&x, &p.x, sizeof(uint32_t));
+        memcpy(&y, &p.y, sizeof(uint32_t));
+        return (uint64_t(x) << 32) | y;
+    }
+
+    static uint32_t hash(uint64_t key) noexcept {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return uint32_t(key);
+    }
+
+    void grow() noexcept {
+        Slot* slots = mSlots;
+        const uint32_t capacity = mSlots ? mMask + 1 : 0;
+
+        const uint32_t newCapacity = capacity ? capacity * 2 : 64;
+        mSlots = static_cast<Slot*>(calloc(newCapacity, sizeof(Slot)));
+        mMask = newCapacity - 1;
+        mSize = 0;
+
+        for (uint32_t i = 0; i < capacity; i++) {
+            if (slots[i].used) {
+                Point p;
+                uint32_t x = uint32_t(slots[i].key >> 32);
+                uint32_t y = uint32_t(slots[i].key);
+                memcpy(&p.x, &x, sizeof(uint32_t));
+                memcpy(&p.y, &y, sizeof(uint32_t));
+                insert(p, slots[i].value);
+            }
+        }
+        free(slots);
+    }
+
+    Slot* mSlots = nullptr;
+    uint32_t mMask = 0;
+    int mSize = 0;
+};
+
+#endif //PATHWAY_POINT_MAP_H
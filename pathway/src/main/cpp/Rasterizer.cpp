@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Rasterizer.h"
+
+#include "Geometry.h"
+#include "scalar.h"
+#include "Stats.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using Line = Rasterizer::Line;
+
+// Maximum number of lines a curve is flattened into
+constexpr int kMaxFlattenCount = 256;
+
+static int flattenCount(float error, float tolerance) noexcept {
+    // See flatteningError()
+    const float count = std::ceil(std::sqrt(error / tolerance));
+    if (!(count > 1.0f)) return 1;
+    return count >= float(kMaxFlattenCount) ? kMaxFlattenCount : int(count);
+}
+
+void Rasterizer::setPath(PathIterator& iterator, float tolerance) noexcept {
+    mTolerance = tolerance > 0.0f ? tolerance : 0.25f;
+    mLines.clear();
+
+    Point points[4];
+    Point start{};
+    Point last{};
+    ConicConverter converter;
+    bool done = false;
+
+    while (!done && iterator.hasNext()) {
+        const Verb verb = iterator.next(points);
+        switch (verb) {
+            case Verb::Move:
+                // Contours are implicitly closed when filled
+                addLine(last, start);
+                start = last = points[0];
+                break;
+            case Verb::Line:
+                addLine(points[0], points[1]);
+                last = points[1];
+                break;
+            case Verb::Quadratic:
+                flatten(points, 2);
+                last = points[2];
+                break;
+            case Verb::Conic: {
+                const Point* quadratics = converter.toQuadratics(points, points[3].x, mTolerance);
+                for (int i = 0; i < converter.quadraticCount(); i++) {
+                    flatten(quadratics + i * 2, 2);
+                }
+                last = points[2];
+                break;
+            }
+            case Verb::Cubic:
+                flatten(points, 3);
+                last = points[3];
+                break;
+            case Verb::Close:
+                addLine(last, start);
+                last = start;
+                break;
+            case Verb::Done:
+                done = true;
+                break;
+        }
+    }
+    addLine(last, start);
+}
+
+void Rasterizer::flatten(const Point* p, int degree) noexcept {
+    // Non-finite control points would give an undefined number of lines, keep the chord,
+    // which addLine() drops if its end points are not finite either
+    if (!areFinite(p, degree + 1)) {
+        addLine(p[0], p[degree]);
+        return;
+    }
+
+    const int count = flattenCount(flatteningError(p, degree), mTolerance);
+
+    Point previous = p[0];
+    const float step = 1.0f / float(count);
+    for (int i = 1; i < count; i++) {
+        const float t = float(i) * step;
+        const float u = 1.0f - t;
+        Point next;
+        if (degree == 2) {
+            next.x = u * u * p[0].x + 2.0f * t * u * p[1].x + t * t * p[2].x;
+            next.y = u * u * p[0].y + 2.0f * t * u * p[1].y + t * t * p[2].y;
+        } else {
+            next.x = u * u * u * p[0].x + 3.0f * t * u * (u * p[1].x + t * p[2].x) +
+                    t * t * t * p[3].x;
+            next.y = u * u * u * p[0].y + 3.0f * t * u * (u * p[1].y + t * p[2].y) +
+                    t * t * t * p[3].y;
+        }
+        addLine(previous, next);
+        previous = next;
+    }
+    addLine(previous, p[degree]);
+}
+
+void Rasterizer::addLine(Point p0, Point p1) noexcept {
+    // Horizontal lines do not change the coverage
+    if (p0.y == p1.y) return;
+    const Point points[2] = { p0, p1 };
+    if (!areFinite(points, 2)) return;
+
+    if (p0.y < p1.y) {
+        mLines.push({ p0.x, p0.y, p1.x, p1.y, 1.0f });
+    } else {
+        mLines.push({ p1.x, p1.y, p0.x, p0.y, -1.0f });
+    }
+}
+
+// Splits the line where it crosses the left and right edges of the mask. The parts
+// outside of the mask are replaced with vertical lines on the edges: on the left, they
+// still change the coverage of the whole row, on the right they do not affect any pixel
+void Rasterizer::addClippedLine(
+        float x0, float y0, float x1, float y1, float direction) noexcept {
+    const float width = mWidth;
+    float ts[4] = { 0.0f };
+    int count = 1;
+    if (x0 != x1) {
+        const float t0 = (0.0f - x0) / (x1 - x0);
+        const float t1 = (width - x0) / (x1 - x0);
+        if (t0 > 0.0f && t0 < 1.0f) ts[count++] = t0;
+        if (t1 > 0.0f && t1 < 1.0f) ts[count++] = t1;
+        if (count == 3 && ts[2] < ts[1]) {
+            const float t = ts[1];
+            ts[1] = ts[2];
+            ts[2] = t;
+        }
+    }
+    ts[count] = 1.0f;
+
+    float xa = x0;
+    float ya = y0;
+    for (int i = 0; i < count; i++) {
+        const bool last = i + 1 == count;
+        const float xb = last ? x1 : x0 + (x1 - x0) * ts[i + 1];
+        const float yb = last ? y1 : y0 + (y1 - y0) * ts[i + 1];
+        if (yb > ya) {
+            const float middle = (xa + xb) * 0.5f;
+            if (middle <= 0.0f) {
+                mClipped.push({ 0.0f, ya, 0.0f, yb, direction });
+            } else if (middle >= width) {
+                mClipped.push({ width, ya, width, yb, direction });
+            } else {
+                mClipped.push({
+                        xa < 0.0f ? 0.0f : (xa > width ? width : xa), ya,
+                        xb < 0.0f ? 0.0f : (xb > width ? width : xb), yb,
+                        direction });
+            }
+        }
+        xa = xb;
+        ya = yb;
+    }
+}
+
+static int compareLines(const void* lhs, const void* rhs) {
+    const float a = static_cast<const Line*>(lhs)->y0;
+    const float b = static_cast<const Line*>(rhs)->y0;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+// Adds the area covered by the line in each cell it crosses, for the rows [top, bottom),
+// and the change of coverage to the cell on its right, see draw_line() in font-rs
+void Rasterizer::drawLine(const Line& line, int top, int bottom) noexcept {
+    const int yStart = line.y0 <= float(top) ? top : int(std::floor(line.y0));
+    const int yEnd = line.y1 >= float(bottom) ? bottom : int(std::ceil(line.y1));
+    const float dxdy = (line.x1 - line.x0) / (line.y1 - line.y0);
+    const float width = mWidth;
+
+    for (int y = yStart; y < yEnd; y++) {
+        const float ya = float(y) > line.y0 ? float(y) : line.y0;
+        const float yb = float(y + 1) < line.y1 ? float(y + 1) : line.y1;
+        if (yb <= ya) continue;
+
+        float xa = line.x0 + (ya - line.y0) * dxdy;
+        float xb = line.x0 + (yb - line.y0) * dxdy;
+        xa = xa < 0.0f ? 0.0f : (xa > width ? width : xa);
+        xb = xb < 0.0f ? 0.0f : (xb > width ? width : xb);
+
+        float* cells = mAccumulation.data() + (y - top) * mAccumulationStride;
+        const float d = (yb - ya) * line.direction;
+
+        const float x0 = xa < xb ? xa : xb;
+        const float x1 = xa < xb ? xb : xa;
+        const float x0Floor = std::floor(x0);
+        const int x0i = int(x0Floor);
+        const float x1Ceil = std::ceil(x1);
+        const int x1i = int(x1Ceil);
+
+        if (x1i <= x0i + 1) {
+            // The line stays in one cell
+            const float xm = 0.5f * (xa + xb) - x0Floor;
+            cells[x0i] += d - d * xm;
+            cells[x0i + 1] += d * xm;
+        } else {
+            const float s = 1.0f / (x1 - x0);
+            const float x0f = x0 - x0Floor;
+            const float a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            const float x1f = x1 - x1Ceil + 1.0f;
+            const float am = 0.5f * s * x1f * x1f;
+            cells[x0i] += d * a0;
+            if (x1i == x0i + 2) {
+                cells[x0i + 1] += d * (1.0f - a0 - am);
+            } else {
+                const float a1 = s * (1.5f - x0f);
+                cells[x0i + 1] += d * (a1 - a0);
+                for (int x = x0i + 2; x < x1i - 1; x++) {
+                    cells[x] += d * s;
+                }
+                const float a2 = a1 + float(x1i - x0i - 3) * s;
+                cells[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            cells[x1i] += d * am;
+        }
+    }
+}
+
+static inline float coverage(float winding, bool evenOdd, bool inverse) noexcept {
+    float c = std::fabs(winding);
+    if (evenOdd) {
+        c -= 2.0f * std::floor(c * 0.5f);
+        c = c > 1.0f ? 2.0f - c : c;
+    } else {
+        c = c > 1.0f ? 1.0f : c;
+    }
+    return inverse ? 1.0f - c : c;
+}
+
+// Runs a prefix sum over the cells of a row to compute the coverage of each pixel, and
+// clears the cells for the next band
+static void accumulateRow(float* cells, uint8_t* out, int width,
+        bool evenOdd, bool inverse) noexcept {
+    int x = 0;
+    float sum = 0.0f;
+
+#if defined(__ARM_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+    float32x4_t carry = zero;
+
+    for ( ; x + 16 <= width; x += 16) {
+        uint32x4_t bytes[4];
+        for (int i = 0; i < 4; i++) {
+            // Prefix sum of 4 cells in 2 shifted adds, offset by the previous sums
+            float32x4_t v = vld1q_f32(cells + x + i * 4);
+            vst1q_f32(cells + x + i * 4, zero);
+            v = vaddq_f32(v, vextq_f32(zero, v, 3));
+            v = vaddq_f32(v, vextq_f32(zero, v, 2));
+            v = vaddq_f32(v, carry);
+            carry = vdupq_laneq_f32(v, 3);
+
+            float32x4_t c = vabsq_f32(v);
+            if (evenOdd) {
+                c = vsubq_f32(c, vmulq_f32(two, vrndmq_f32(vmulq_f32(c, half))));
+                c = vminq_f32(c, vsubq_f32(two, c));
+            } else {
+                c = vminq_f32(c, one);
+            }
+            if (inverse) c = vsubq_f32(one, c);
+            bytes[i] = vcvtq_u32_f32(vaddq_f32(vmulq_f32(c, scale), half));
+        }
+        const uint16x8_t low = vcombine_u16(vmovn_u32(bytes[0]), vmovn_u32(bytes[1]));
+        const uint16x8_t high = vcombine_u16(vmovn_u32(bytes[2]), vmovn_u32(bytes[3]));
+        vst1q_u8(out + x, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+    }
+    sum = vgetq_lane_f32(carry, 0);
+#endif
+
+    for ( ; x < width; x++) {
+        sum += cells[x];
+        cells[x] = 0.0f;
+        out[x] = uint8_t(coverage(sum, evenOdd, inverse) * 255.0f + 0.5f);
+    }
+    cells[width] = 0.0f;
+    cells[width + 1] = 0.0f;
+}
+
+void Rasterizer::render(uint8_t* pixels, uint32_t stride, int width, int height,
+        bool evenOdd, bool inverse) noexcept {
+    if (width <= 0 || height <= 0) return;
+
+    PATHWAY_TRACE("pathway::Rasterizer::render");
+
+    mWidth = float(width);
+    mClipped.clear();
+    for (int i = 0; i < mLines.size(); i++) {
+        const Line& line = mLines[i];
+        if (line.y1 <= 0.0f || line.y0 >= float(height)) continue;
+        addClippedLine(line.x0, line.y0, line.x1, line.y1, line.direction);
+    }
+    qsort(mClipped.data(), mClipped.size(), sizeof(Line), compareLines);
+
+    // Lines can touch the cell right of the last pixel, and the cell after it
+    mAccumulationStride = width + 2;
+    mAccumulation.resize(mAccumulationStride * kRasterizerBandHeight);
+    memset(mAccumulation.data(), 0, sizeof(float) * mAccumulation.size());
+
+    mActive.clear();
+    int next = 0;
+    for (int top = 0; top < height; top += kRasterizerBandHeight) {
+        const int bottom = top + kRasterizerBandHeight < height ?
+                top + kRasterizerBandHeight : height;
+
+        while (next < mClipped.size() && mClipped[next].y0 < float(bottom)) {
+            mActive.push(next++);
+        }
+
+        // Draw the active lines, and retire the lines that end in this band
+        int kept = 0;
+        for (int i = 0; i < mActive.size(); i++) {
+            const Line& line = mClipped[mActive[i]];
+            drawLine(line, top, bottom);
+            if (line.y1 > float(bottom)) mActive[kept++] = mActive[i];
+        }
+        mActive.resize(kept);
+
+        for (int y = top; y < bottom; y++) {
+            accumulateRow(mAccumulation.data() + (y - top) * mAccumulationStride,
+                    pixels + size_t(y) * stride, width, evenOdd, inverse);
+        }
+    }
+}
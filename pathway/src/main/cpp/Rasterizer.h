@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_RASTERIZER_H
+#define PATHWAY_RASTERIZER_H
+
+#include "Array.h"
+#include "PathIterator.h"
+
+#include <stdint.h>
+
+// Number of rows of the accumulation buffer, see Rasterizer
+constexpr int kRasterizerBandHeight = 16;
+
+// Renders the coverage of a path into an 8 bit alpha mask, with exact area anti-aliasing.
+// The path is flattened into lines, and each line adds to the cells it crosses the signed
+// area it covers in these cells, plus the change of coverage it causes to the right of
+// the cells (the approach used by font-rs and stb_truetype). A prefix sum along each row
+// then yields the winding coverage of every pixel, mapped to the final coverage with the
+// fill rule. Pixels where the outline crosses itself are approximated, since only the sum
+// of the areas is known in each pixel.
+//
+// Rows are rendered in bands of kRasterizerBandHeight rows, which keeps the memory used
+// by the accumulation buffer proportional to the width of the mask.
+class Rasterizer {
+public:
+    Rasterizer() noexcept { }
+
+    Rasterizer(const Rasterizer&) = delete;
+    Rasterizer& operator=(const Rasterizer&) = delete;
+
+    // Flattens the path into lines within tolerance of its curves. Conics should be
+    // converted to quadratics by the iterator
+    void setPath(PathIterator& iterator, float tolerance = 0.25f) noexcept;
+
+    // Renders the path into a mask of width by height pixels. The pixel at (x, y) covers
+    // the area [x, x + 1] x [y, y + 1] of the path
+    void render(uint8_t* pixels, uint32_t stride, int width, int height,
+            bool evenOdd, bool inverse) noexcept;
+
+    // Lines with y0 < y1, direction is +1 if the original line goes down, -1 otherwise
+    struct Line {
+        float x0;
+        float y0;
+        float x1;
+        float y1;
+        float direction;
+    };
+
+private:
+    void addLine(Point p0, Point p1) noexcept;
+    void addClippedLine(float x0, float y0, float x1, float y1, float direction) noexcept;
+    void flatten(const Point* points, int degree) noexcept;
+    void drawLine(const Line& line, int top, int bottom) noexcept;
+
+    float mTolerance = 0.25f;
+    Array<Line> mLines;
+
+    // Lines clipped to the horizontal extent of the mask, sorted by y0, valid in render()
+    Array<Line> mClipped;
+    Array<int> mActive;
+    // kRasterizerBandHeight rows of mAccumulationStride cells
+    Array<float> mAccumulation;
+    int mAccumulationStride = 0;
+    float mWidth = 0.0f;
+};
+
+#endif //PATHWAY_RASTERIZER_H
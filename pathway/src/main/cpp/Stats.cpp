@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Stats.h"
+
+#include <time.h>
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#endif
+
+StatsState gStats{};
+thread_local int gStatsSuppressed = 0;
+std::atomic<const TraceSink*> gTraceSink{nullptr};
+
+void setStatsEnabled(bool enabled) noexcept {
+    gStats.enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void resetStats() noexcept {
+    for (int i = 0; i < kStatCount; i++) {
+        gStats.values[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void snapshotStats(uint64_t* values) noexcept {
+    for (int i = 0; i < kStatCount; i++) {
+        values[i] = gStats.values[i].load(std::memory_order_relaxed);
+    }
+}
+
+uint64_t statsTime() noexcept {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000ULL + uint64_t(now.tv_nsec);
+}
+
+void setTraceSink(const TraceSink* sink) noexcept {
+    gTraceSink.store(sink, std::memory_order_release);
+}
+
+#if defined(__ANDROID__) && PATHWAY_STATS
+
+// The ATrace functions are only available from API 23 and are looked up dynamically
+// since we support older versions of Android
+static struct {
+    bool (*isEnabled)();
+    void (*beginSection)(const char* sectionName);
+    void (*endSection)();
+} sATrace{};
+
+static const TraceSink sATraceSink = {
+        nullptr,
+        [](void*) { return sATrace.isEnabled(); },
+        [](void*, const char* name) { sATrace.beginSection(name); },
+        [](void*) { sATrace.endSection(); }
+};
+
+void initTracing() noexcept {
+    void* library = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) return;
+
+    sATrace.isEnabled = reinterpret_cast<bool (*)()>(dlsym(library, "ATrace_isEnabled"));
+    sATrace.beginSection = reinterpret_cast<void (*)(const char*)>(
+            dlsym(library, "ATrace_beginSection"));
+    sATrace.endSection = reinterpret_cast<void (*)()>(dlsym(library, "ATrace_endSection"));
+
+    if (sATrace.isEnabled && sATrace.beginSection && sATrace.endSection) {
+        setTraceSink(&sATraceSink);
+    }
+}
+
+#else
+
+void initTracing() noexcept {
+}
+
+#endif
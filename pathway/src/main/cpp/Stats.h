@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_STATS_H
+#define PATHWAY_STATS_H
+
+#include <atomic>
+
+#include <stdint.h>
+
+// Instrumentation of the hot paths of the library. Building with PATHWAY_STATS=0 removes
+// all the counters and trace sections. Otherwise counters are only updated after a call
+// to setStatsEnabled(true), and trace sections are only emitted while a trace sink is
+// installed and enabled, which costs a relaxed atomic load when disabled.
+#ifndef PATHWAY_STATS
+#define PATHWAY_STATS 1
+#endif
+
+// The order of these values must match the indices used by the Kotlin API (Stats.kt)
+enum class Stat : uint32_t {
+    SegmentsIterated,
+    ConicsConverted,
+    QuadraticsFromConics,
+    // Number of conics converted into 1, 2, 4, 8, 16 and 32 quadratics
+    ConicsTo1Quadratic,
+    ConicsTo2Quadratics,
+    ConicsTo4Quadratics,
+    ConicsTo8Quadratics,
+    ConicsTo16Quadratics,
+    ConicsTo32Quadratics,
+    BitmapsTraced,
+    // Time spent in each phase of bitmap tracing, in nanoseconds
+    TraceReadNanos,
+    TraceMarchNanos,
+    TraceBuildNanos,
+    TraceOutputNanos,
+    CubicsFromConics,
+    CubicsConverted,
+    QuadraticsFromCubics,
+    // Segments removed or merged by the cleanup mode of PathIterator
+    SegmentsDropped,
+    // Curves split at their extrema by the monotonic mode of PathIterator
+    MonotonicSplits,
+    // Time spent following borders when tracing bitmaps with followBorders()
+    TraceFollowNanos,
+    Count
+};
+
+constexpr int kStatCount = int(Stat::Count);
+
+struct StatsState {
+    std::atomic<bool> enabled;
+    std::atomic<uint64_t> values[kStatCount];
+};
+
+extern StatsState gStats;
+// Number of ScopedStatsSuppression alive on the current thread
+extern thread_local int gStatsSuppressed;
+
+inline bool statsEnabled() noexcept {
+#if PATHWAY_STATS
+    return gStats.enabled.load(std::memory_order_relaxed) && gStatsSuppressed == 0;
+#else
+    return false;
+#endif
+}
+
+inline void addStat(Stat stat, uint64_t value) noexcept {
+#if PATHWAY_STATS
+    if (statsEnabled()) {
+        gStats.values[uint32_t(stat)].fetch_add(value, std::memory_order_relaxed);
+    }
+#else
+    (void) stat;
+    (void) value;
+#endif
+}
+
+void setStatsEnabled(bool enabled) noexcept;
+void resetStats() noexcept;
+// Copies the current value of all the counters into values, which must hold kStatCount
+// entries
+void snapshotStats(uint64_t* values) noexcept;
+
+// Monotonic time in nanoseconds, only meant to be used when statsEnabled() is true
+uint64_t statsTime() noexcept;
+
+// Accumulates the time spent in a scope into a stat
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Stat stat) noexcept
+            : mStat(stat), mStart(statsEnabled() ? statsTime() : 0) {
+    }
+
+    ~ScopedTimer() noexcept {
+        if (mStart != 0) addStat(mStat, statsTime() - mStart);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const Stat mStat;
+    const uint64_t mStart;
+};
+
+// Disables the counters on the current thread for the lifetime of the object, for work
+// that should not be measured, such as a second pass made only to count the segments
+// of a path
+class ScopedStatsSuppression {
+public:
+    ScopedStatsSuppression() noexcept { gStatsSuppressed++; }
+    ~ScopedStatsSuppression() noexcept { gStatsSuppressed--; }
+
+    ScopedStatsSuppression(const ScopedStatsSuppression&) = delete;
+    ScopedStatsSuppression& operator=(const ScopedStatsSuppression&) = delete;
+};
+
+// Receives trace sections. On device, the default sink forwards sections to ATrace
+// (see initTracing()), and a custom sink can be installed on host to collect them
+struct TraceSink {
+    void* context;
+    bool (*isEnabled)(void* context);
+    void (*beginSection)(void* context, const char* name);
+    void (*endSection)(void* context);
+};
+
+// Installs the specified sink, or removes the current sink if sink is null. The sink
+// must outlive all the trace sections emitted while it is installed
+void setTraceSink(const TraceSink* sink) noexcept;
+
+// Installs the ATrace sink when available (API 23+)
+void initTracing() noexcept;
+
+extern std::atomic<const TraceSink*> gTraceSink;
+
+class ScopedTrace {
+public:
+    explicit ScopedTrace(const char* name) noexcept
+            : mSink(gTraceSink.load(std::memory_order_acquire)) {
+        if (mSink && (!mSink->isEnabled || mSink->isEnabled(mSink->context))) {
+            mSink->beginSection(mSink->context, name);
+        } else {
+            mSink = nullptr;
+        }
+    }
+
+    ~ScopedTrace() noexcept {
+        if (mSink) mSink->endSection(mSink->context);
+    }
+
+    ScopedTrace(const ScopedTrace&) = delete;
+    ScopedTrace& operator=(const ScopedTrace&) = delete;
+
+private:
+    const TraceSink* mSink;
+};
+
+#define PATHWAY_CONCAT_(a, b) a##b
+#define PATHWAY_CONCAT(a, b) PATHWAY_CONCAT_(a, b)
+
+#if PATHWAY_STATS
+#define PATHWAY_TRACE(name) ScopedTrace PATHWAY_CONCAT(__trace, __COUNTER__)(name)
+#define PATHWAY_TIMER(stat) ScopedTimer PATHWAY_CONCAT(__timer, __COUNTER__)(stat)
+#else
+#define PATHWAY_TRACE(name)
+#define PATHWAY_TIMER(stat)
+#endif
+
+#endif //PATHWAY_STATS_H
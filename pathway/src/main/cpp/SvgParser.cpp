@@ -0,0 +1,457 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SvgParser.h"
+
+#include <cmath>
+#include <cstring>
+
+#include <stdint.h>
+
+void PackedPath::conicTo(Point p1, Point p2, float weight) noexcept {
+    if (mConicEvaluation == PathIterator::ConicEvaluation::AsConic) {
+        mVerbs.push(Verb::Conic);
+        Point* points = mPoints.grow(2);
+        points[0] = p1;
+        points[1] = p2;
+        mConicWeights.push(weight);
+        return;
+    }
+
+    const Point conic[3] = { mPoints.back(), p1, p2 };
+    if (mConicEvaluation == PathIterator::ConicEvaluation::AsCubics) {
+        const Point* cubics = mConverter.toCubics(conic, weight, mTolerance);
+        for (int i = 0; i < mConverter.cubicCount(); i++) {
+            cubicTo(cubics[i * 3 + 1], cubics[i * 3 + 2], cubics[i * 3 + 3]);
+        }
+    } else {
+        const Point* quadratics = mConverter.toQuadratics(conic, weight, mTolerance);
+        for (int i = 0; i < mConverter.quadraticCount(); i++) {
+            quadTo(quadratics[i * 2 + 1], quadratics[i * 2 + 2]);
+        }
+    }
+}
+
+static inline bool isSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+static inline bool isDigit(char c) noexcept {
+    return uint8_t(c - '0') < 10;
+}
+
+static inline bool startsNumber(char c) noexcept {
+    return isDigit(c) || c == '-' || c == '+' || c == '.';
+}
+
+static inline bool isCommand(char c) noexcept {
+    switch (c | 0x20) {
+        case 'm': case 'l': case 'h': case 'v': case 'c': case 's':
+        case 'q': case 't': case 'a': case 'z':
+            return true;
+        default:
+            return false;
+    }
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Digits are checked and converted 8 at a time with SWAR (SIMD within a register)
+// arithmetic, see "Fast number parsing, without fallback" (Mushtak, Lemire)
+static inline uint64_t load8(const char* p) noexcept {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline bool isEightDigits(uint64_t v) noexcept {
+    return ((v & 0xF0F0F0F0F0F0F0F0) |
+            (((v + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+static inline uint32_t parseEightDigits(uint64_t v) noexcept {
+    constexpr uint64_t mask = 0x000000FF000000FF;
+    constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+    constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+    v -= 0x3030303030303030;
+    v = (v * 10) + (v >> 8);
+    v = (((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32;
+    return uint32_t(v);
+}
+#endif
+
+// A uint64_t can hold any integer of 19 digits
+constexpr int kMaxDigits = 19;
+
+// Accumulates a run of digits into mantissa. Digits that do not fit are skipped and
+// counted in dropped. Returns the number of digits in the run
+static inline int scanDigits(const char*& p, uint64_t& mantissa, int& digits, int& dropped)
+        noexcept {
+    const char* start = p;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    while (digits + 8 <= kMaxDigits) {
+        const uint64_t v = load8(p);
+        if (!isEightDigits(v)) break;
+        mantissa = mantissa * 100000000 + parseEightDigits(v);
+        // Leading zeros are counted, which only costs a little precision
+        digits += 8;
+        p += 8;
+    }
+#endif
+    while (isDigit(*p)) {
+        if (digits < kMaxDigits) {
+            mantissa = mantissa * 10 + uint64_t(*p - '0');
+            if (mantissa != 0) digits++;
+        } else {
+            dropped++;
+        }
+        p++;
+    }
+    return int(p - start);
+}
+
+static constexpr double kPowersOf10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline float toFloat(uint64_t mantissa, int exponent) noexcept {
+    if (mantissa == 0) return 0.0f;
+
+    double v = double(mantissa);
+    // Values outside of this range are 0 or infinite as floats
+    if (exponent < -64) return 0.0f;
+    if (exponent > 64) return INFINITY;
+    for ( ; exponent > 22; exponent -= 22) v *= 1e22;
+    for ( ; exponent < -22; exponent += 22) v /= 1e22;
+    v = exponent >= 0 ? v * kPowersOf10[exponent] : v / kPowersOf10[-exponent];
+    return float(v);
+}
+
+// Reads a number as defined by the SVG grammar: optional sign, digits with an optional
+// decimal point, and an optional exponent. Returns nullptr if p is not a number
+static const char* parseNumber(const char* p, float& value) noexcept {
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int dropped = 0;
+    int count = scanDigits(p, mantissa, digits, dropped);
+    int exponent = dropped;
+
+    if (*p == '.') {
+        p++;
+        dropped = 0;
+        const int fraction = scanDigits(p, mantissa, digits, dropped);
+        exponent -= fraction - dropped;
+        count += fraction;
+    }
+    if (count == 0) return nullptr;
+
+    // An exponent must have at least one digit, otherwise the 'e' is left unread
+    if ((*p | 0x20) == 'e') {
+        const char* e = p + 1;
+        bool negativeExponent = false;
+        if (*e == '-' || *e == '+') {
+            negativeExponent = *e == '-';
+            e++;
+        }
+        if (isDigit(*e)) {
+            int n = 0;
+            for ( ; isDigit(*e); e++) {
+                if (n < 10000) n = n * 10 + (*e - '0');
+            }
+            exponent += negativeExponent ? -n : n;
+            p = e;
+        }
+    }
+
+    const float v = toFloat(mantissa, exponent);
+    value = negative ? -v : v;
+    return p;
+}
+
+namespace {
+
+// Reads the arguments of the commands. On failure, p points to the invalid character
+struct Scanner {
+    const char* p;
+
+    void skipSpaces() noexcept {
+        while (isSpace(*p)) p++;
+    }
+
+    // Skips white spaces with at most one comma
+    void skipSeparators() noexcept {
+        skipSpaces();
+        if (*p == ',') {
+            p++;
+            skipSpaces();
+        }
+    }
+
+    bool number(float& value) noexcept {
+        skipSeparators();
+        const char* next = parseNumber(p, value);
+        if (!next) return false;
+        p = next;
+        return true;
+    }
+
+    bool point(Point& point) noexcept {
+        return number(point.x) && number(point.y);
+    }
+
+    // Flags are a single 0 or 1, and do not need to be followed by a separator
+    bool flag(bool& value) noexcept {
+        skipSeparators();
+        if (*p != '0' && *p != '1') return false;
+        value = *p++ == '1';
+        return true;
+    }
+};
+
+}
+
+static inline Point add(Point a, Point b) noexcept {
+    return { a.x + b.x, a.y + b.y };
+}
+
+static inline Point reflect(Point p, Point center) noexcept {
+    return { 2.0f * center.x - p.x, 2.0f * center.y - p.y };
+}
+
+// Converts an elliptical arc from its endpoint parameterization to conics, see
+// https://www.w3.org/TR/SVG11/implnote.html#ArcImplementationNotes
+static void arcTo(PackedPath& path, Point from, float rx, float ry, float angle,
+        bool largeArc, bool sweep, Point to) noexcept {
+    if (from.x == to.x && from.y == to.y) return;
+
+    rx = std::abs(rx);
+    ry = std::abs(ry);
+    if (rx == 0.0f || ry == 0.0f) {
+        path.lineTo(to);
+        return;
+    }
+
+    const float phi = angle * float(M_PI / 180.0);
+    const float cosPhi = std::cos(phi);
+    const float sinPhi = std::sin(phi);
+
+    // Endpoints in the coordinate space of the ellipse, centered on their midpoint
+    const float dx = (from.x - to.x) * 0.5f;
+    const float dy = (from.y - to.y) * 0.5f;
+    const float x1 = cosPhi * dx + sinPhi * dy;
+    const float y1 = -sinPhi * dx + cosPhi * dy;
+
+    // Scale up the radii if no ellipse can go through both endpoints, the center of the
+    // ellipse is then the midpoint of the endpoints
+    float k = 0.0f;
+    const float lambda = (x1 * x1) / (rx * rx) + (y1 * y1) / (ry * ry);
+    if (lambda >= 1.0f) {
+        const float scale = std::sqrt(lambda);
+        rx *= scale;
+        ry *= scale;
+    } else {
+        const float rx2 = rx * rx;
+        const float ry2 = ry * ry;
+        const float numerator = rx2 * ry2 - rx2 * y1 * y1 - ry2 * x1 * x1;
+        const float denominator = rx2 * y1 * y1 + ry2 * x1 * x1;
+        const float ratio = numerator / denominator;
+        k = ratio > 0.0f ? std::sqrt(ratio) : 0.0f;
+        if (largeArc == sweep) k = -k;
+    }
+
+    const float cx1 = k * rx * y1 / ry;
+    const float cy1 = -k * ry * x1 / rx;
+    const float cx = cosPhi * cx1 - sinPhi * cy1 + (from.x + to.x) * 0.5f;
+    const float cy = sinPhi * cx1 + cosPhi * cy1 + (from.y + to.y) * 0.5f;
+
+    const float theta = std::atan2((y1 - cy1) / ry, (x1 - cx1) / rx);
+    float delta = std::atan2((-y1 - cy1) / ry, (-x1 - cx1) / rx) - theta;
+    if (sweep && delta < 0.0f) delta += float(2.0 * M_PI);
+    if (!sweep && delta > 0.0f) delta -= float(2.0 * M_PI);
+
+    // One conic per quarter of ellipse at most, a conic can represent up to half an
+    // ellipse but its weight gets close to 0
+    int count = int(std::ceil(std::abs(delta) / float(M_PI / 2.0) - 1e-4f));
+    if (count < 1) count = 1;
+    const float step = delta / float(count);
+    const float weight = std::cos(step * 0.5f);
+
+    // Maps a point of the unit circle to the ellipse
+    auto map = [=](float u, float v) -> Point {
+        const float x = u * rx;
+        const float y = v * ry;
+        return { cosPhi * x - sinPhi * y + cx, sinPhi * x + cosPhi * y + cy };
+    };
+
+    for (int i = 0; i < count; i++) {
+        const float t0 = theta + step * float(i);
+        const float middle = t0 + step * 0.5f;
+        // The control point is the intersection of the tangents at both ends
+        const Point control = map(std::cos(middle) / weight, std::sin(middle) / weight);
+        const Point end = i == count - 1 ?
+                to : map(std::cos(t0 + step), std::sin(t0 + step));
+        path.conicTo(control, end, weight);
+    }
+}
+
+int parseSvgPath(const char* data, int length, PackedPath& path) noexcept {
+    const char* end = data + length;
+    Scanner scanner = { data };
+
+    Point current = { 0.0f, 0.0f };
+    Point start = { 0.0f, 0.0f };
+    // Last control point of a cubic or quadratic, reflected by shorthand commands
+    Point control = { 0.0f, 0.0f };
+
+    char command = 0;
+    char previous = 0;
+    bool closed = false;
+
+    while (true) {
+        scanner.skipSeparators();
+        if (scanner.p >= end) break;
+
+        const char c = *scanner.p;
+        if (isCommand(c)) {
+            command = c;
+            scanner.p++;
+        } else if (command == 0 || (command | 0x20) == 'z' || !startsNumber(c)) {
+            // Arguments can only follow a command that takes arguments
+            return int(scanner.p - data);
+        }
+
+        const char type = char(command & ~0x20);
+        const bool relative = command != type;
+        const Point origin = relative ? current : Point{ 0.0f, 0.0f };
+
+        if (type == 'M') {
+            Point p;
+            if (!scanner.point(p)) return int(scanner.p - data);
+            current = start = add(origin, p);
+            path.moveTo(current);
+            closed = false;
+            // Subsequent pairs of coordinates are implicit line commands
+            command = relative ? 'l' : 'L';
+            previous = 'M';
+            continue;
+        }
+
+        // The path data must start with a move
+        if (previous == 0) return int(scanner.p - 1 - data);
+
+        if (type == 'Z') {
+            path.close();
+            current = start;
+            closed = true;
+            previous = 'Z';
+            continue;
+        }
+
+        const char* segment = scanner.p;
+        Point p1, p2, p3;
+        switch (type) {
+            case 'L':
+                if (!scanner.point(p1)) return int(scanner.p - data);
+                p1 = add(origin, p1);
+                break;
+            case 'H':
+                if (!scanner.number(p1.x)) return int(scanner.p - data);
+                p1 = { origin.x + p1.x, current.y };
+                break;
+            case 'V':
+                if (!scanner.number(p1.y)) return int(scanner.p - data);
+                p1 = { current.x, origin.y + p1.y };
+                break;
+            case 'C':
+                if (!scanner.point(p1) || !scanner.point(p2) || !scanner.point(p3)) {
+                    return int(scanner.p - data);
+                }
+                p1 = add(origin, p1);
+                p2 = add(origin, p2);
+                p3 = add(origin, p3);
+                break;
+            case 'S':
+                if (!scanner.point(p2) || !scanner.point(p3)) return int(scanner.p - data);
+                p1 = previous == 'C' || previous == 'S' ? reflect(control, current) : current;
+                p2 = add(origin, p2);
+                p3 = add(origin, p3);
+                break;
+            case 'Q':
+                if (!scanner.point(p1) || !scanner.point(p2)) return int(scanner.p - data);
+                p1 = add(origin, p1);
+                p2 = add(origin, p2);
+                break;
+            case 'T':
+                if (!scanner.point(p2)) return int(scanner.p - data);
+                p1 = previous == 'Q' || previous == 'T' ? reflect(control, current) : current;
+                p2 = add(origin, p2);
+                break;
+            case 'A': {
+                bool largeArc, sweep;
+                if (!scanner.number(p1.x) || !scanner.number(p1.y) || !scanner.number(p2.x) ||
+                        !scanner.flag(largeArc) || !scanner.flag(sweep) ||
+                        !scanner.point(p3)) {
+                    return int(scanner.p - data);
+                }
+                p3 = add(origin, p3);
+                if (closed) path.moveTo(start);
+                closed = false;
+                arcTo(path, current, p1.x, p1.y, p2.x, largeArc, sweep, p3);
+                current = p3;
+                previous = 'A';
+                continue;
+            }
+            default:
+                return int(segment - data);
+        }
+
+        // Like Skia, continue the closed subpath from its start
+        if (closed) path.moveTo(start);
+        closed = false;
+
+        switch (type) {
+            case 'L':
+            case 'H':
+            case 'V':
+                path.lineTo(p1);
+                current = p1;
+                break;
+            case 'C':
+            case 'S':
+                path.cubicTo(p1, p2, p3);
+                control = p2;
+                current = p3;
+                break;
+            case 'Q':
+            case 'T':
+                path.quadTo(p1, p2);
+                control = p1;
+                current = p2;
+                break;
+            default:
+                break;
+        }
+        previous = type;
+    }
+
+    return -1;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_SVG_PARSER_H
+#define PATHWAY_SVG_PARSER_H
+
+#include "Array.h"
+#include "Conic.h"
+#include "PathIterator.h"
+
+// Number of bytes that must be readable, and set to 0, after the end of the path data
+// passed to parseSvgPath(). Digits are scanned 8 at a time
+constexpr int kSvgPathPadding = 8;
+
+// Geometry stored with the layout Skia uses for paths: one verb per segment, the points
+// of the segments (segments other than moves share their first point with the previous
+// segment) and the weights of the conics, in order.
+class PackedPath {
+public:
+    explicit PackedPath(
+            PathIterator::ConicEvaluation conicEvaluation = PathIterator::ConicEvaluation::AsConic,
+            float tolerance = 0.25f) noexcept
+            : mConicEvaluation(conicEvaluation), mTolerance(tolerance) { }
+
+    PackedPath(const PackedPath&) = delete;
+    PackedPath& operator=(const PackedPath&) = delete;
+
+    const Array<Verb>& verbs() const noexcept { return mVerbs; }
+    const Array<Point>& points() const noexcept { return mPoints; }
+    const Array<float>& conicWeights() const noexcept { return mConicWeights; }
+
+    void moveTo(Point p) noexcept {
+        mVerbs.push(Verb::Move);
+        mPoints.push(p);
+    }
+
+    void lineTo(Point p) noexcept {
+        mVerbs.push(Verb::Line);
+        mPoints.push(p);
+    }
+
+    void quadTo(Point p1, Point p2) noexcept {
+        mVerbs.push(Verb::Quadratic);
+        Point* points = mPoints.grow(2);
+        points[0] = p1;
+        points[1] = p2;
+    }
+
+    // Stores the conic, or its approximation, depending on the conic evaluation
+    void conicTo(Point p1, Point p2, float weight) noexcept;
+
+    void cubicTo(Point p1, Point p2, Point p3) noexcept {
+        mVerbs.push(Verb::Cubic);
+        Point* points = mPoints.grow(3);
+        points[0] = p1;
+        points[1] = p2;
+        points[2] = p3;
+    }
+
+    void close() noexcept {
+        mVerbs.push(Verb::Close);
+    }
+
+    void clear() noexcept {
+        mVerbs.clear();
+        mPoints.clear();
+        mConicWeights.clear();
+    }
+
+private:
+    Array<Verb> mVerbs;
+    Array<Point> mPoints;
+    Array<float> mConicWeights;
+    ConicConverter mConverter;
+    PathIterator::ConicEvaluation mConicEvaluation;
+    float mTolerance;
+};
+
+// Parses SVG path data (the d attribute of a path element) into the specified path.
+// The whole grammar is supported, including relative and shorthand commands. Elliptical
+// arcs are converted to conics, at most one per quarter of ellipse. Like Skia, a move is
+// inserted after a close when the subpath continues with another command.
+//
+// The data must be followed by kSvgPathPadding bytes set to 0. Returns -1 if the data
+// is valid, or the offset of the first invalid character otherwise, in which case the
+// path contains the segments parsed before the error.
+int parseSvgPath(const char* data, int length, PackedPath& path) noexcept;
+
+#endif //PATHWAY_SVG_PARSER_H
@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Tracer.h"
+#include "Stats.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+constexpr float clamp(float v, float minimumValue, float maximumValue) noexcept {
+    return v < minimumValue ? minimumValue : (v > maximumValue ? maximumValue : v);
+}
+
+template<typename T>
+constexpr T min(T a, T b) noexcept {
+    return a < b ? a : b;
+}
+
+template<typename T>
+constexpr T max(T a, T b) noexcept {
+    return a > b ? a : b;
+}
+
+constexpr int quadKey(int a, int b, int c, int d) noexcept {
+    return a | (b << 1) | (c << 2) | (d << 3);
+}
+
+static inline void addCell(ContourBuilder& contours, int key,
+        float fx0, float fxM, float fx1, float fy0, float fyM, float fy1) noexcept {
+    switch (key) {
+        case 0x1: contours.addLine(fx0, fyM, fxM, fy0); break;
+        case 0x2: contours.addLine(fxM, fy0, fx1, fyM); break;
+        case 0x3: contours.addLine(fx0, fyM, fx1, fyM); break;
+        case 0x4: contours.addLine(fxM, fy1, fx0, fyM); break;
+        case 0x5: contours.addLine(fxM, fy1, fxM, fy0); break;
+        case 0x6:
+            contours.addLine(fxM, fy0, fx1, fyM);
+            contours.addLine(fxM, fy1, fx0, fyM);
+            break;
+        case 0x7: contours.addLine(fxM, fy1, fx1, fyM); break;
+        case 0x8: contours.addLine(fx1, fyM, fxM, fy1); break;
+        case 0x9:
+            contours.addLine(fx0, fyM, fxM, fy0);
+            contours.addLine(fx1, fyM, fxM, fy1);
+            break;
+        case 0xA: contours.addLine(fxM, fy0, fxM, fy1); break;
+        case 0xB: contours.addLine(fx0, fyM, fxM, fy1); break;
+        case 0xC: contours.addLine(fx1, fyM, fx0, fyM); break;
+        case 0xD: contours.addLine(fx1, fyM, fxM, fy0); break;
+        case 0xE: contours.addLine(fxM, fy0, fx0, fyM); break;
+        default: break;
+    }
+}
+
+void marchLevels(const uint8_t* top, const uint8_t* bottom, int x0, int x1, int y,
+        int width, int height, ContourBuilder* contours) noexcept {
+    const float xmax = float(width - 1);
+    const float ymax = float(height - 1);
+
+    const float fy0 = y < 0 ? 0.0f : float(y);
+    const float fyM = clamp(float(y) + 0.5f, 0.0f, ymax);
+    const float fy1 = float(y) + 1.0f > ymax ? ymax : float(y) + 1.0f;
+
+    int x = x0;
+    while (x < x1) {
+        int end = x1;
+#if defined(__ARM_NEON)
+        // Most cells have the same level at all four corners and do not produce any
+        // segment, skip them 16 at a time
+        if (x + 16 <= x1) {
+            const int i = x - x0;
+            const uint8x16_t a = vld1q_u8(top + i);
+            const uint8x16_t b = vld1q_u8(top + i + 1);
+            const uint8x16_t c = vld1q_u8(bottom + i);
+            const uint8x16_t d = vld1q_u8(bottom + i + 1);
+            const uint8x16_t same =
+                    vandq_u8(vandq_u8(vceqq_u8(a, b), vceqq_u8(a, c)), vceqq_u8(a, d));
+            if (vminvq_u8(same) == 0xFF) {
+                x += 16;
+                continue;
+            }
+            end = x + 16;
+        }
+#endif
+
+        for ( ; x < end; x++) {
+            const int i = x - x0;
+            const int a = top[i];
+            const int b = top[i + 1];
+            const int c = bottom[i];
+            const int d = bottom[i + 1];
+
+            // Only the levels in [min, max) cross this cell, the cell is either fully
+            // transparent or fully opaque at every other level
+            const int minLevel = min(min(a, b), min(c, d));
+            const int maxLevel = max(max(a, b), max(c, d));
+            if (minLevel == maxLevel) continue;
+
+            const float fx0 = x < 0 ? 0.0f : float(x);
+            const float fxM = clamp(float(x) + 0.5f, 0.0f, xmax);
+            const float fx1 = float(x) + 1.0f > xmax ? xmax : float(x) + 1.0f;
+
+            for (int level = minLevel; level < maxLevel; level++) {
+                const int key = quadKey(a > level, b > level, c > level, d > level);
+                addCell(contours[level], key, fx0, fxM, fx1, fy0, fyM, fy1);
+            }
+        }
+    }
+}
+
+void marchCells(const uint8_t* top, const uint8_t* bottom, int x0, int x1, int y,
+        int width, int height, ContourBuilder& contours) noexcept {
+    marchLevels(top, bottom, x0, x1, y, width, height, &contours);
+}
+
+bool traceContours(const RowSource& source, ContourSet& contours) noexcept {
+    return traceLevels(source, &contours, 1);
+}
+
+bool traceLevels(const RowSource& source, ContourSet* contours, int levelCount) noexcept {
+    const int w = source.width;
+    const int h = source.height;
+
+    // Two rows of pixels with a guard pixel on each side to handle opaque pixels
+    // at the edges. The rows above and below the image are left empty
+    const int stride = w + 2;
+    auto* storage = static_cast<uint8_t*>(calloc(stride * 2, 1));
+    uint8_t* top = storage;
+    uint8_t* bottom = storage + stride;
+
+    auto* builders = static_cast<ContourBuilder*>(malloc(sizeof(ContourBuilder) * levelCount));
+    for (int i = 0; i < levelCount; i++) {
+        new(&builders[i]) ContourBuilder();
+    }
+
+    bool result = true;
+
+    // Timings are accumulated locally to only touch the shared counters once
+    const bool timed = statsEnabled();
+    uint64_t readTime = 0;
+    uint64_t marchTime = 0;
+
+    for (int y = -1; y < h; y++) {
+        const uint64_t start = timed ? statsTime() : 0;
+
+        if (y + 1 < h) {
+            if (!source.readRow(source.context, y + 1, 0, w, bottom + 1)) {
+                result = false;
+                break;
+            }
+        } else {
+            memset(bottom, 0, stride);
+        }
+
+        const uint64_t read = timed ? statsTime() : 0;
+
+        marchLevels(top, bottom, -1, w, y, w, h, builders);
+
+        if (timed) {
+            const uint64_t end = statsTime();
+            readTime += read - start;
+            marchTime += end - read;
+        }
+
+        uint8_t* t = top;
+        top = bottom;
+        bottom = t;
+    }
+
+    addStat(Stat::TraceReadNanos, readTime);
+    addStat(Stat::TraceMarchNanos, marchTime);
+
+    {
+        PATHWAY_TIMER(Stat::TraceBuildNanos);
+        for (int i = 0; i < levelCount; i++) {
+            builders[i].build(contours[i]);
+            builders[i].~ContourBuilder();
+        }
+    }
+    free(builders);
+
+    free(storage);
+    return result;
+}
+
+#if defined(__ARM_NEON)
+// Classifies 16 alpha values against all the thresholds, each compare yields 0xFF (-1)
+// when the alpha meets the threshold
+static inline uint8x16_t classify(uint8x16_t alpha, const uint8_t* thresholds,
+        int thresholdCount) noexcept {
+    uint8x16_t level = vdupq_n_u8(0);
+    for (int j = 0; j < thresholdCount; j++) {
+        level = vsubq_u8(level, vcgeq_u8(alpha, vdupq_n_u8(thresholds[j])));
+    }
+    return level;
+}
+#endif
+
+static inline uint8_t classify(uint32_t alpha, const uint8_t* thresholds,
+        int thresholdCount) noexcept {
+    int level = 0;
+    while (level < thresholdCount && alpha >= thresholds[level]) level++;
+    return uint8_t(level);
+}
+
+bool Rgba8888Source::readRow(void* context, int y, int x, int count, uint8_t* row) noexcept {
+    auto* source = static_cast<const Rgba8888Source*>(context);
+    const uint8_t* pixels = source->pixels + size_t(y) * source->stride + size_t(x) * 4;
+    const uint8_t* thresholds = source->thresholds;
+    const int thresholdCount = source->thresholdCount;
+
+    int i = 0;
+#if defined(__ARM_NEON)
+    for ( ; i + 16 <= count; i += 16) {
+        const uint8x16_t alpha = vld4q_u8(pixels + i * 4).val[3];
+        vst1q_u8(row + i, classify(alpha, thresholds, thresholdCount));
+    }
+#endif
+
+    for ( ; i < count; i++) {
+        row[i] = classify(pixels[i * 4 + 3], thresholds, thresholdCount);
+    }
+    return true;
+}
+
+bool Alpha8Source::readRow(void* context, int y, int x, int count, uint8_t* row) noexcept {
+    auto* source = static_cast<const Alpha8Source*>(context);
+    const uint8_t* pixels = source->pixels + size_t(y) * source->stride + size_t(x);
+    const uint8_t* thresholds = source->thresholds;
+    const int thresholdCount = source->thresholdCount;
+
+    int i = 0;
+#if defined(__ARM_NEON)
+    for ( ; i + 16 <= count; i += 16) {
+        vst1q_u8(row + i, classify(vld1q_u8(pixels + i), thresholds, thresholdCount));
+    }
+#endif
+
+    for ( ; i < count; i++) {
+        row[i] = classify(pixels[i], thresholds, thresholdCount);
+    }
+    return true;
+}
+
+static float halfToFloat(uint16_t h) noexcept {
+    const int exponent = (h >> 10) & 0x1f;
+    const int mantissa = h & 0x3ff;
+    if (exponent == 0) return std::ldexp(float(mantissa), -24);
+    return std::ldexp(float(mantissa | 0x400), exponent - 25);
+}
+
+uint16_t toHalfAlphaThreshold(float alphaThreshold) noexcept {
+    // Every pixel is inside, including pixels with a negative alpha
+    if (alphaThreshold < 0.0f) return 0x8000;
+    // Half float 1.0
+    if (alphaThreshold >= 1.0f) return 0x3c00;
+
+    // Smallest half float greater than the threshold
+    uint16_t low = 0;
+    uint16_t high = 0x3c00;
+    while (low < high) {
+        const uint16_t middle = uint16_t((low + high) / 2);
+        if (halfToFloat(middle) > alphaThreshold) {
+            high = middle;
+        } else {
+            low = uint16_t(middle + 1);
+        }
+    }
+    return low;
+}
+
+bool RgbaF16Source::readRow(void* context, int y, int x, int count, uint8_t* row) noexcept {
+    auto* source = static_cast<const RgbaF16Source*>(context);
+    const auto* pixels = reinterpret_cast<const uint16_t*>(
+            source->pixels + size_t(y) * source->stride + size_t(x) * 8);
+    const uint16_t* thresholds = source->thresholds;
+    const int thresholdCount = source->thresholdCount;
+
+    int i = 0;
+#if defined(__ARM_NEON)
+    // Compare the bits of 8 alpha values at a time as signed integers, see
+    // toHalfAlphaThreshold()
+    for ( ; i + 8 <= count; i += 8) {
+        const int16x8_t alpha = vreinterpretq_s16_u16(vld4q_u16(pixels + i * 4).val[3]);
+        uint16x8_t level = vdupq_n_u16(0);
+        for (int j = 0; j < thresholdCount; j++) {
+            const int16x8_t threshold = vdupq_n_s16(int16_t(thresholds[j]));
+            level = vsubq_u16(level, vcgeq_s16(alpha, threshold));
+        }
+        vst1_u8(row + i, vmovn_u16(level));
+    }
+#endif
+
+    for ( ; i < count; i++) {
+        const auto alpha = int16_t(pixels[i * 4 + 3]);
+        int level = 0;
+        while (level < thresholdCount && alpha >= int16_t(thresholds[level])) level++;
+        row[i] = uint8_t(level);
+    }
+    return true;
+}
+
+bool Rgba1010102Source::readRow(void* context, int y, int x, int count, uint8_t* row) noexcept {
+    auto* source = static_cast<const Rgba1010102Source*>(context);
+    const auto* pixels = reinterpret_cast<const uint32_t*>(
+            source->pixels + size_t(y) * source->stride + size_t(x) * 4);
+    const uint8_t* thresholds = source->thresholds;
+    const int thresholdCount = source->thresholdCount;
+
+    int i = 0;
+#if defined(__ARM_NEON)
+    // Extract the 2 bit alpha of 16 pixels, in the top bits, and narrow it to bytes
+    for ( ; i + 16 <= count; i += 16) {
+        const uint16x8_t a0 = vcombine_u16(
+                vmovn_u32(vshrq_n_u32(vld1q_u32(pixels + i), 30)),
+                vmovn_u32(vshrq_n_u32(vld1q_u32(pixels + i + 4), 30)));
+        const uint16x8_t a1 = vcombine_u16(
+                vmovn_u32(vshrq_n_u32(vld1q_u32(pixels + i + 8), 30)),
+                vmovn_u32(vshrq_n_u32(vld1q_u32(pixels + i + 12), 30)));
+        const uint8x16_t alpha = vcombine_u8(vmovn_u16(a0), vmovn_u16(a1));
+        vst1q_u8(row + i, classify(alpha, thresholds, thresholdCount));
+    }
+#endif
+
+    for ( ; i < count; i++) {
+        row[i] = classify(pixels[i] >> 30, thresholds, thresholdCount);
+    }
+    return true;
+}
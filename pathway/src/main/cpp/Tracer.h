@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_TRACER_H
+#define PATHWAY_TRACER_H
+
+#include "Contours.h"
+
+#include <stdint.h>
+
+// Provides the pixels to trace one row at a time. readRow() must set row[i] to the level
+// of the pixel at (x + i, y), for i in [0, count). The level of a pixel is the number of
+// thresholds its alpha meets: when tracing a single shape, it is 1 if the pixel is inside
+// the shape (opaque) and 0 otherwise. Returning false aborts the tracing.
+struct RowSource {
+    int width;
+    int height;
+    void* context;
+    bool (*readRow)(void* context, int y, int x, int count, uint8_t* row);
+};
+
+// Converts an alpha threshold between 0.0 and 1.0 into a threshold for alpha values
+// between 0 and maxAlpha (255 for 8 bit alpha). A pixel is inside the shape if its
+// alpha is greater than or equal to the returned value
+constexpr int toAlphaThreshold(float alphaThreshold, int maxAlpha = 255) noexcept {
+    int threshold = int(alphaThreshold * float(maxAlpha) + 1.0f);
+    return threshold < 0 ? 0 : (threshold > maxAlpha ? maxAlpha : threshold);
+}
+
+// Converts an alpha threshold between 0.0 and 1.0 into a threshold for half float alpha
+// values. A pixel is inside the shape if the bits of its alpha, read as a signed 16 bit
+// integer, are greater than or equal to the returned value. This works because the bits
+// of positive half floats are ordered like their values, and negative values are
+// negative integers. Like 8 bit thresholds, a threshold of 1.0 keeps opaque pixels
+uint16_t toHalfAlphaThreshold(float alphaThreshold) noexcept;
+
+// Traces the contours of the shape defined by the specified source using marching
+// squares. Only two rows of pixels are kept in memory at any given time. Returns
+// false if the source aborted the tracing.
+bool traceContours(const RowSource& source, ContourSet& contours) noexcept;
+
+// Traces the contours of several shapes in a single pass over the specified source. The
+// contours of the shape made of the pixels whose level is greater than k are added to
+// contours[k], for k in [0, levelCount). The source must not produce levels greater than
+// levelCount. Returns false if the source aborted the tracing.
+bool traceLevels(const RowSource& source, ContourSet* contours, int levelCount) noexcept;
+
+// Runs marching squares over the cells [x0, x1) of the row of cells y, in an image of
+// size width by height. The cell at x covers the pixels x and x + 1 of the rows y and
+// y + 1, stored respectively in top[x - x0] and bottom[x - x0] (and the next entries).
+// Cells start at -1 to handle opaque pixels at the edges of the image.
+void marchCells(const uint8_t* top, const uint8_t* bottom, int x0, int x1, int y,
+        int width, int height, ContourBuilder& contours) noexcept;
+
+// Same as marchCells() for rows of pixel levels, see traceLevels()
+void marchLevels(const uint8_t* top, const uint8_t* bottom, int x0, int x1, int y,
+        int width, int height, ContourBuilder* contours) noexcept;
+
+// Row source reading the alpha channel of RGBA_8888 pixels. The thresholds, created
+// with toAlphaThreshold(), must be sorted in ascending order
+struct Rgba8888Source {
+    const uint8_t* pixels;
+    uint32_t stride;
+    const uint8_t* thresholds;
+    int thresholdCount;
+
+    static bool readRow(void* context, int y, int x, int count, uint8_t* row) noexcept;
+};
+
+// Row source reading ALPHA_8 pixels, see Rgba8888Source
+struct Alpha8Source {
+    const uint8_t* pixels;
+    uint32_t stride;
+    const uint8_t* thresholds;
+    int thresholdCount;
+
+    static bool readRow(void* context, int y, int x, int count, uint8_t* row) noexcept;
+};
+
+// Row source reading the alpha channel of RGBA_F16 pixels. The thresholds, created with
+// toHalfAlphaThreshold(), must be sorted in ascending order
+struct RgbaF16Source {
+    const uint8_t* pixels;
+    uint32_t stride;
+    const uint16_t* thresholds;
+    int thresholdCount;
+
+    static bool readRow(void* context, int y, int x, int count, uint8_t* row) noexcept;
+};
+
+// Row source reading the 2 bit alpha channel of RGBA_1010102 pixels. The thresholds,
+// created with toAlphaThreshold(alphaThreshold, 3), must be sorted in ascending order
+struct Rgba1010102Source {
+    const uint8_t* pixels;
+    uint32_t stride;
+    const uint8_t* thresholds;
+    int thresholdCount;
+
+    static bool readRow(void* context, int y, int x, int count, uint8_t* row) noexcept;
+};
+
+#endif //PATHWAY_TRACER_H
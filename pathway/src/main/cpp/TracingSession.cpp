@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TracingSession.h"
+
+#include "PointMap.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+// Cells go from -1 to width - 1 (resp. height - 1) to handle opaque pixels at the edges
+// of the image, so there is one more cell than pixels in each direction
+TracingSession::TracingSession(int width, int height, int tileSize) noexcept
+        : mWidth(width),
+          mHeight(height),
+          mTileSize(tileSize),
+          mTileCountX((width + tileSize) / tileSize),
+          mTileCountY((height + tileSize) / tileSize) {
+    const int count = mTileCountX * mTileCountY;
+    mTiles = static_cast<ContourSet*>(malloc(sizeof(ContourSet) * count));
+    for (int i = 0; i < count; i++) {
+        new(&mTiles[i]) ContourSet();
+    }
+}
+
+TracingSession::~TracingSession() noexcept {
+    const int count = mTileCountX * mTileCountY;
+    for (int i = 0; i < count; i++) {
+        mTiles[i].~ContourSet();
+    }
+    free(mTiles);
+}
+
+template<typename T>
+constexpr T clamp(T v, T minimumValue, T maximumValue) noexcept {
+    return v < minimumValue ? minimumValue : (v > maximumValue ? maximumValue : v);
+}
+
+bool TracingSession::update(
+        const RowSource& source, int left, int top, int right, int bottom) noexcept {
+    left = clamp(left, 0, mWidth);
+    top = clamp(top, 0, mHeight);
+    right = clamp(right, 0, mWidth);
+    bottom = clamp(bottom, 0, mHeight);
+    if (left >= right || top >= bottom) return true;
+
+    // The pixel x is covered by the cells x - 1 and x, and the cell x belongs to
+    // the tile (x + 1) / mTileSize
+    const int tx0 = left / mTileSize;
+    const int tx1 = clamp(right / mTileSize, 0, mTileCountX - 1);
+    const int ty0 = top / mTileSize;
+    const int ty1 = clamp(bottom / mTileSize, 0, mTileCountY - 1);
+
+    for (int ty = ty0; ty <= ty1; ty++) {
+        for (int tx = tx0; tx <= tx1; tx++) {
+            if (!traceTile(source, tx, ty)) return false;
+        }
+    }
+
+    return true;
+}
+
+bool TracingSession::traceTile(const RowSource& source, int tx, int ty) noexcept {
+    ContourSet& tile = mTiles[ty * mTileCountX + tx];
+    tile.clear();
+
+    // Range of cells covered by this tile
+    const int cx0 = tx * mTileSize - 1;
+    const int cx1 = cx0 + mTileSize < mWidth ? cx0 + mTileSize : mWidth;
+    const int cy0 = ty * mTileSize - 1;
+    const int cy1 = cy0 + mTileSize < mHeight ? cy0 + mTileSize : mHeight;
+
+    // The cells [cx0, cx1) cover the pixels [cx0, cx1]
+    const int stride = cx1 - cx0 + 1;
+    mRows.resize(stride * 2);
+    uint8_t* top = mRows.data();
+    uint8_t* bottom = top + stride;
+
+    const int px0 = cx0 < 0 ? 0 : cx0;
+    const int px1 = cx1 < mWidth - 1 ? cx1 : mWidth - 1;
+
+    for (int y = cy0; y <= cy1; y++) {
+        memset(bottom, 0, stride);
+        if (y >= 0 && y < mHeight) {
+            if (!source.readRow(source.context, y, px0, px1 - px0 + 1, bottom + (px0 - cx0))) {
+                // Drop the segments of the partially traced tile, which would otherwise
+                // be added to the next tile built
+                mBuilder.clear();
+                return false;
+            }
+        }
+
+        if (y > cy0) {
+            marchCells(top, bottom, cx0, cx1, y - 1, mWidth, mHeight, mBuilder);
+        }
+
+        uint8_t* t = top;
+        top = bottom;
+        bottom = t;
+    }
+
+    mBuilder.build(tile);
+    return true;
+}
+
+void TracingSession::stitch(ContourSet& contours) const noexcept {
+    // Open chains are the edges of a graph whose vertices are their end points. Virtual
+    // edges are added from every vertex with more chains entering than leaving to a vertex
+    // with more chains leaving than entering, which makes every vertex balanced. Walking
+    // Eulerian circuits through that graph (Hierholzer's algorithm) and cutting them at
+    // the virtual edges yields the smallest possible number of open contours
+    struct Chain {
+        Contour contour; // Empty for virtual edges
+        int to;   // Vertex the chain ends at
+        int next; // Next chain leaving the same vertex
+    };
+
+    struct Vertex {
+        int head;    // First chain leaving this vertex that has not been walked yet
+        int balance; // Number of chains leaving this vertex minus chains entering it
+    };
+
+    Array<Chain> chains;
+    Array<Vertex> vertices;
+    PointMap ids;
+
+    auto vertexOf = [&](Point p) {
+        int* id = ids.find(p);
+        if (id) return *id;
+        vertices.push({ -1, 0 });
+        ids.insert(p, vertices.size() - 1);
+        return vertices.size() - 1;
+    };
+
+    auto addEdge = [&](Contour contour, int from, int to) {
+        chains.push({ contour, to, vertices[from].head });
+        vertices[from].head = chains.size() - 1;
+        vertices[from].balance++;
+        vertices[to].balance--;
+    };
+
+    // Closed contours that fit in a single tile are complete and emitted as is
+    const int count = mTileCountX * mTileCountY;
+    for (int i = 0; i < count; i++) {
+        const ContourSet& tile = mTiles[i];
+        for (int j = 0; j < tile.size(); j++) {
+            const Contour contour = tile[j];
+            const Point& first = contour.points[0];
+            if (contour.endsWith(first.x, first.y)) {
+                contours.addContour(contour.points, contour.count);
+            } else {
+                const int from = vertexOf(first);
+                addEdge(contour, from, vertexOf(contour.points[contour.count - 1]));
+            }
+        }
+    }
+
+    int source = 0;
+    int sink = 0;
+    while (true) {
+        while (source < vertices.size() && vertices[source].balance <= 0) source++;
+        while (sink < vertices.size() && vertices[sink].balance >= 0) sink++;
+        if (source == vertices.size() || sink == vertices.size()) break;
+        addEdge({ nullptr, 0 }, sink, source);
+    }
+
+    struct Step {
+        int vertex;
+        int chain; // Chain walked to reach the vertex, -1 for the start of the circuit
+    };
+
+    Array<Step> stack;
+    Array<int> circuit;
+
+    for (int v = 0; v < vertices.size(); v++) {
+        if (vertices[v].head < 0) continue;
+
+        stack.push({ v, -1 });
+        while (!stack.empty()) {
+            Vertex& vertex = vertices[stack.back().vertex];
+            if (vertex.head >= 0) {
+                const int chain = vertex.head;
+                vertex.head = chains[chain].next;
+                stack.push({ chains[chain].to, chain });
+            } else {
+                // The circuit is built backward
+                if (stack.back().chain >= 0) circuit.push(stack.back().chain);
+                stack.pop();
+            }
+        }
+
+        // Start right after a virtual edge, if any, so that open contours are not cut
+        const int size = circuit.size();
+        int start = size - 1;
+        for (int i = 0; i < size; i++) {
+            if (chains[circuit[i]].contour.count == 0) {
+                start = i - 1;
+                break;
+            }
+        }
+
+        bool started = false;
+        for (int i = 0; i < size; i++) {
+            const Contour& chain = chains[circuit[(start - i + size) % size]].contour;
+            if (chain.count == 0) {
+                started = false;
+            } else if (!started) {
+                contours.addContour(chain.points, chain.count);
+                started = true;
+            } else {
+                contours.appendPoints(chain.points + 1, chain.count - 1);
+            }
+        }
+        circuit.clear();
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PATHWAY_TRACING_SESSION_H
+#define PATHWAY_TRACING_SESSION_H
+
+#include "Array.h"
+#include "Contours.h"
+#include "Tracer.h"
+
+// A tracing session keeps the result of marching squares for an image split in square
+// tiles of cells. When a region of the image changes, only the tiles intersecting that
+// region are traced again. The pieces of contours crossing tile borders are then
+// stitched back together by stitch().
+class TracingSession {
+public:
+    TracingSession(int width, int height, int tileSize) noexcept;
+    ~TracingSession() noexcept;
+
+    TracingSession(const TracingSession&) = delete;
+    TracingSession& operator=(const TracingSession&) = delete;
+
+    int width() const noexcept { return mWidth; }
+    int height() const noexcept { return mHeight; }
+
+    // Traces again all the tiles affected by a change of the pixels in the rectangle
+    // [left, right) x [top, bottom). Returns false if the source aborted the tracing
+    bool update(const RowSource& source, int left, int top, int right, int bottom) noexcept;
+
+    // Joins the pieces of contours stored in all the tiles into complete contours
+    void stitch(ContourSet& contours) const noexcept;
+
+private:
+    bool traceTile(const RowSource& source, int tx, int ty) noexcept;
+
+    const int mWidth;
+    const int mHeight;
+    const int mTileSize;
+    const int mTileCountX;
+    const int mTileCountY;
+    ContourSet* mTiles;
+    ContourBuilder mBuilder;
+    Array<uint8_t> mRows;
+};
+
+#endif //PATHWAY_TRACING_SESSION_H
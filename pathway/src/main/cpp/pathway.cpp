@@ -14,77 +14,160 @@
  * limitations under the License.
  */
 
+#include "BatchTracer.h"
+#include "BorderTracer.h"
+#include "Complexity.h"
+#include "ConvexHull.h"
+#include "DistanceField.h"
+#include "Intersections.h"
+#include "Moments.h"
+#include "Morph.h"
 #include "PathIterator.h"
+#include "Rasterizer.h"
+#include "Stats.h"
+#include "SvgParser.h"
+#include "Tracer.h"
+#include "TracingSession.h"
 
 #include <jni.h>
 
 #include <android/api-level.h>
+#include <android/bitmap.h>
 
 #include <cstdlib>
 #include <new>
 
 #define JNI_CLASS_NAME "dev/romainguy/graphics/path/Paths"
+#define JNI_MORPH_CLASS_NAME "dev/romainguy/graphics/path/Morph"
+#define JNI_IMAGE_CLASS_NAME "dev/romainguy/graphics/path/ImageKt"
+#define JNI_TRACING_CLASS_NAME "dev/romainguy/graphics/path/Tracing"
+#define JNI_STATS_CLASS_NAME "dev/romainguy/graphics/path/Stats"
+#define JNI_STORAGE_CLASS_NAME "dev/romainguy/graphics/path/Storage"
+#define JNI_BATCH_CLASS_NAME "dev/romainguy/graphics/path/Batch"
+#define JNI_SVG_CLASS_NAME "dev/romainguy/graphics/path/Svg"
+#define JNI_DISTANCE_FIELD_CLASS_NAME "dev/romainguy/graphics/path/DistanceField"
+#define JNI_RASTERIZER_CLASS_NAME "dev/romainguy/graphics/path/Rasterizer"
+#define JNI_INTERSECTIONS_CLASS_NAME "dev/romainguy/graphics/path/Intersections"
+#define JNI_CONVEX_HULL_CLASS_NAME "dev/romainguy/graphics/path/ConvexHull"
+#define JNI_MOMENTS_CLASS_NAME "dev/romainguy/graphics/path/Moments"
+#define JNI_INDEX_CLASS_NAME "dev/romainguy/graphics/path/Indexing"
+#define JNI_COMPLEXITY_CLASS_NAME "dev/romainguy/graphics/path/Complexity"
+#define JNI_COMPONENTS_CLASS_NAME "dev/romainguy/graphics/path/Components"
+
+#define JNI_TRACED_CONTOURS "Ldev/romainguy/graphics/path/TracedContours;"
+#define JNI_TRACED_COMPONENTS "Ldev/romainguy/graphics/path/TracedComponents;"
 
 struct {
     jclass jniClass;
     jfieldID nativePath;
+    jclass byteBufferClass;
 } sPath{};
 
-static jlong createPathIterator(JNIEnv* env, jclass,
-        jobject path_, jint conicEvaluation_, jfloat tolerance_) {
+struct {
+    jclass tracedContoursClass;
+    jmethodID tracedContours;
+    jclass tracedComponentsClass;
+    jmethodID tracedComponents;
+    jmethodID getRow;
+} sImage{};
 
-    auto nativePath = static_cast<intptr_t>(env->GetLongField(path_, sPath.nativePath));
-    auto* path = reinterpret_cast<Path*>(nativePath);
+struct {
+    jclass packedPathClass;
+    jmethodID packedPath;
+} sSvg{};
+
+struct {
+    jclass packedIntersectionsClass;
+    jmethodID packedIntersections;
+} sIntersections{};
 
+struct PathData {
     Point* points;
     Verb* verbs;
     float* conicWeights;
     int count;
     PathIterator::VerbDirection direction;
+    // Used to detect changes to the path, see isPathStorageValid()
+    const void* ref;
+    uint32_t generationId;
+};
+
+static void getPathData(JNIEnv* env, jobject path_, PathData* data) {
+    auto nativePath = static_cast<intptr_t>(env->GetLongField(path_, sPath.nativePath));
+    auto* path = reinterpret_cast<Path*>(nativePath);
 
     const uint32_t apiLevel = android_get_device_api_level();
     if (apiLevel >= 34) {
         auto* ref = reinterpret_cast<PathRef34*>(path->pathRef);
-        points = ref->points;
-        verbs = ref->verbs;
-        conicWeights = ref->conicWeights;
-        count = ref->verbSize;
-        direction = PathIterator::VerbDirection::Forward;
+        data->points = ref->points;
+        data->verbs = ref->verbs;
+        data->conicWeights = ref->conicWeights;
+        data->count = ref->verbSize;
+        data->direction = PathIterator::VerbDirection::Forward;
+        data->ref = ref;
+        data->generationId = ref->generationId;
     } else if (apiLevel >= 30) {
         auto* ref = reinterpret_cast<PathRef30*>(path->pathRef);
-        points = ref->points;
-        verbs = ref->verbs;
-        conicWeights = ref->conicWeights;
-        count = ref->verbCount;
-        direction = PathIterator::VerbDirection::Forward;
+        data->points = ref->points;
+        data->verbs = ref->verbs;
+        data->conicWeights = ref->conicWeights;
+        data->count = ref->verbCount;
+        data->direction = PathIterator::VerbDirection::Forward;
+        data->ref = ref;
+        data->generationId = ref->generationId;
     } else if (apiLevel >= 26) {
         auto* ref = reinterpret_cast<PathRef26*>(path->pathRef);
-        points = ref->points;
-        verbs = ref->verbs;
-        conicWeights = ref->conicWeights;
-        count = ref->verbCount;
-        direction = PathIterator::VerbDirection::Backward;
+        data->points = ref->points;
+        data->verbs = ref->verbs;
+        data->conicWeights = ref->conicWeights;
+        data->count = ref->verbCount;
+        data->direction = PathIterator::VerbDirection::Backward;
+        data->ref = ref;
+        data->generationId = ref->generationId;
     } else if (apiLevel >= 24) {
         auto* ref = reinterpret_cast<PathRef24*>(path->pathRef);
-        points = ref->points;
-        verbs = ref->verbs;
-        conicWeights = ref->conicWeights;
-        count = ref->verbCount;
-        direction = PathIterator::VerbDirection::Backward;
+        data->points = ref->points;
+        data->verbs = ref->verbs;
+        data->conicWeights = ref->conicWeights;
+        data->count = ref->verbCount;
+        data->direction = PathIterator::VerbDirection::Backward;
+        data->ref = ref;
+        data->generationId = ref->generationId;
     } else {
         auto* ref = path->pathRef;
-        points = ref->points;
-        verbs = ref->verbs;
-        conicWeights = ref->conicWeights;
-        count = ref->verbCount;
-        direction = PathIterator::VerbDirection::Backward;
+        data->points = ref->points;
+        data->verbs = ref->verbs;
+        data->conicWeights = ref->conicWeights;
+        data->count = ref->verbCount;
+        data->direction = PathIterator::VerbDirection::Backward;
+        data->ref = ref;
+        data->generationId = ref->generationId;
     }
+}
+
+static PathIterator makePathIterator(
+        const PathData& data,
+        PathIterator::ConicEvaluation conicEvaluation,
+        float tolerance = 0.25f,
+        PathIterator::CubicEvaluation cubicEvaluation = PathIterator::CubicEvaluation::AsCubic,
+        bool cleanup = false,
+        bool monotonic = false) {
+    return PathIterator(
+            data.points, data.verbs, data.conicWeights, data.count, data.direction,
+            conicEvaluation, tolerance, cubicEvaluation, cleanup, monotonic
+    );
+}
+
+static jlong createPathIterator(JNIEnv* env, jclass, jobject path_, jint conicEvaluation_,
+        jfloat tolerance_, jint cubicEvaluation_, jboolean cleanup_, jboolean monotonic_) {
+    PathData data;
+    getPathData(env, path_, &data);
 
     PathIterator* iterator = static_cast<PathIterator*>(malloc(sizeof(PathIterator)));
-    return jlong(new(iterator) PathIterator(
-            points, verbs, conicWeights, count, direction,
-            PathIterator::ConicEvaluation(conicEvaluation_), tolerance_
-    ));
+    return jlong(new(iterator) PathIterator(makePathIterator(
+            data, PathIterator::ConicEvaluation(conicEvaluation_), tolerance_,
+            PathIterator::CubicEvaluation(cubicEvaluation_), cleanup_, monotonic_
+    )));
 }
 
 static void destroyPathIterator(JNIEnv*, jclass, jlong pathIterator_) {
@@ -111,6 +194,28 @@ static jint pathIteratorNext(
     return static_cast<jint>(verb);
 }
 
+// Fills types with the verbs of up to types.length segments, and points with 8 floats
+// per segment, and returns the number of segments. Returns 0 when the iteration is done
+static jint pathIteratorNextBatch(JNIEnv* env, jclass, jlong pathIterator_,
+        jbyteArray types_, jfloatArray points_) {
+    auto pathIterator = reinterpret_cast<PathIterator*>(pathIterator_);
+    const int capacity = env->GetArrayLength(types_);
+
+    auto* types = static_cast<jbyte*>(env->GetPrimitiveArrayCritical(types_, nullptr));
+    auto* points = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(points_, nullptr));
+
+    int count = 0;
+    while (count < capacity && pathIterator->hasNext()) {
+        types[count] = jbyte(pathIterator->next(reinterpret_cast<Point*>(points + count * 8)));
+        count++;
+    }
+
+    env->ReleasePrimitiveArrayCritical(points_, points, 0);
+    env->ReleasePrimitiveArrayCritical(types_, types, 0);
+
+    return count;
+}
+
 static jint pathIteratorPeek(JNIEnv*, jclass, jlong pathIterator_) {
     return static_cast<jint>(reinterpret_cast<PathIterator *>(pathIterator_)->peek());
 }
@@ -123,6 +228,1018 @@ static jint pathIteratorSize(JNIEnv*, jclass, jlong pathIterator_) {
     return static_cast<jint>(reinterpret_cast<PathIterator *>(pathIterator_)->count());
 }
 
+static void pathIteratorSeek(JNIEnv*, jclass, jlong pathIterator_, jlong pathIndex_,
+        jint verb_) {
+    reinterpret_cast<PathIterator*>(pathIterator_)->seek(
+            *reinterpret_cast<PathIndex*>(pathIndex_), verb_);
+}
+
+static void pathIteratorSeekContour(JNIEnv*, jclass, jlong pathIterator_, jlong pathIndex_,
+        jint contour_) {
+    reinterpret_cast<PathIterator*>(pathIterator_)->seek(
+            reinterpret_cast<PathIndex*>(pathIndex_)->contour(contour_));
+}
+
+static jlong createPathIndex(JNIEnv* env, jclass, jobject path_, jint interval_) {
+    PathData data;
+    getPathData(env, path_, &data);
+
+    PathIndex* index = new(malloc(sizeof(PathIndex))) PathIndex();
+    index->build(data.verbs, data.count,
+            data.direction == PathIterator::VerbDirection::Forward, interval_);
+    return jlong(index);
+}
+
+static void destroyPathIndex(JNIEnv*, jclass, jlong pathIndex_) {
+    PathIndex* index = reinterpret_cast<PathIndex*>(pathIndex_);
+    index->~PathIndex();
+    free(index);
+}
+
+static jint pathIndexVerbCount(JNIEnv*, jclass, jlong pathIndex_) {
+    return static_cast<jint>(reinterpret_cast<PathIndex*>(pathIndex_)->verbCount());
+}
+
+static jint pathIndexContourCount(JNIEnv*, jclass, jlong pathIndex_) {
+    return static_cast<jint>(reinterpret_cast<PathIndex*>(pathIndex_)->contourCount());
+}
+
+static jint pathIndexContourStart(JNIEnv*, jclass, jlong pathIndex_, jint contour_) {
+    return static_cast<jint>(reinterpret_cast<PathIndex*>(pathIndex_)->contour(contour_).verb);
+}
+
+static jint pathIndexContourOf(JNIEnv*, jclass, jlong pathIndex_, jint verb_) {
+    return static_cast<jint>(reinterpret_cast<PathIndex*>(pathIndex_)->contourOf(verb_));
+}
+
+static jlong createPathMorph(JNIEnv* env, jclass,
+        jobject from_, jobject to_, jboolean normalize_, jfloat tolerance_) {
+    PathData fromData;
+    getPathData(env, from_, &fromData);
+    PathData toData;
+    getPathData(env, to_, &toData);
+
+    PathIterator from = makePathIterator(fromData, PathIterator::ConicEvaluation::AsConic);
+    PathIterator to = makePathIterator(toData, PathIterator::ConicEvaluation::AsConic);
+
+    PathMorph* morph = new(malloc(sizeof(PathMorph))) PathMorph();
+    auto normalization = normalize_ ?
+            PathMorph::Normalization::Cubics : PathMorph::Normalization::None;
+    if (!morph->set(from, to, normalization, tolerance_)) {
+        morph->~PathMorph();
+        free(morph);
+        return 0;
+    }
+    return jlong(morph);
+}
+
+static void destroyPathMorph(JNIEnv*, jclass, jlong pathMorph_) {
+    PathMorph* morph = reinterpret_cast<PathMorph*>(pathMorph_);
+    morph->~PathMorph();
+    free(morph);
+}
+
+static jint pathMorphVerbCount(JNIEnv*, jclass, jlong pathMorph_) {
+    return static_cast<jint>(reinterpret_cast<PathMorph*>(pathMorph_)->verbCount());
+}
+
+static jint pathMorphValueCount(JNIEnv*, jclass, jlong pathMorph_) {
+    return static_cast<jint>(reinterpret_cast<PathMorph*>(pathMorph_)->valueCount());
+}
+
+static void pathMorphVerbs(JNIEnv* env, jclass, jlong pathMorph_, jbyteArray verbs_) {
+    auto morph = reinterpret_cast<PathMorph*>(pathMorph_);
+    env->SetByteArrayRegion(verbs_, 0, morph->verbCount(),
+            reinterpret_cast<const jbyte*>(morph->verbs()));
+}
+
+static void pathMorphInterpolate(
+        JNIEnv* env, jclass, jlong pathMorph_, jfloat t_, jfloatArray points_) {
+    auto morph = reinterpret_cast<PathMorph*>(pathMorph_);
+    // Interpolate straight into the Java array to avoid an intermediate copy
+    auto* points = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(points_, nullptr));
+    morph->interpolate(t_, points);
+    env->ReleasePrimitiveArrayCritical(points_, points, 0);
+}
+
+// Layout of the LongArray describing a path storage, must match PathStorage.kt
+enum PathStorageInfo {
+    kStorageVerbCount,
+    kStoragePointCount,
+    kStorageConicWeightCount,
+    kStorageDirection,
+    kStorageRef,
+    kStorageVerbs,
+    kStoragePoints,
+    kStorageGenerationId,
+    kStorageInfoCount
+};
+
+static jobjectArray createPathStorage(JNIEnv* env, jclass, jobject path_, jlongArray info_) {
+    PathData data;
+    getPathData(env, path_, &data);
+
+    // On API < 30 the verbs are stored in reverse order, before the address we read
+    const bool forward = data.direction == PathIterator::VerbDirection::Forward;
+    Verb* verbs = forward ? data.verbs : data.verbs - data.count;
+
+    int pointCount = 0;
+    int conicWeightCount = 0;
+    for (int i = 0; i < data.count; i++) {
+        switch (verbs[i]) {
+            case Verb::Move:
+            case Verb::Line:
+                pointCount += 1;
+                break;
+            case Verb::Conic:
+                conicWeightCount++;
+                [[fallthrough]];
+            case Verb::Quadratic:
+                pointCount += 2;
+                break;
+            case Verb::Cubic:
+                pointCount += 3;
+                break;
+            case Verb::Close:
+            case Verb::Done:
+                break;
+        }
+    }
+
+    jobjectArray buffers = env->NewObjectArray(3, sPath.byteBufferClass, nullptr);
+    jobject buffer = env->NewDirectByteBuffer(verbs, jlong(data.count));
+    env->SetObjectArrayElement(buffers, 0, buffer);
+    env->DeleteLocalRef(buffer);
+    buffer = env->NewDirectByteBuffer(data.points, jlong(sizeof(Point) * pointCount));
+    env->SetObjectArrayElement(buffers, 1, buffer);
+    env->DeleteLocalRef(buffer);
+    buffer = env->NewDirectByteBuffer(data.conicWeights, jlong(sizeof(float) * conicWeightCount));
+    env->SetObjectArrayElement(buffers, 2, buffer);
+    env->DeleteLocalRef(buffer);
+
+    jlong info[kStorageInfoCount];
+    info[kStorageVerbCount] = data.count;
+    info[kStoragePointCount] = pointCount;
+    info[kStorageConicWeightCount] = conicWeightCount;
+    info[kStorageDirection] = jlong(data.direction);
+    info[kStorageRef] = jlong(data.ref);
+    info[kStorageVerbs] = jlong(data.verbs);
+    info[kStoragePoints] = jlong(data.points);
+    info[kStorageGenerationId] = data.generationId;
+    env->SetLongArrayRegion(info_, 0, kStorageInfoCount, info);
+
+    return buffers;
+}
+
+// Checks that the storage described by info_ still matches the storage of the path. Skia
+// resets the generation ID of a path when it is modified, and only computes a new one
+// when requested, for instance when the path is drawn. An ID of 0 is therefore not
+// reliable and only the addresses and size of the storage are compared in that case
+static jboolean isPathStorageValid(JNIEnv* env, jclass, jobject path_, jlongArray info_) {
+    PathData data;
+    getPathData(env, path_, &data);
+
+    jlong info[kStorageInfoCount];
+    env->GetLongArrayRegion(info_, 0, kStorageInfoCount, info);
+
+    const uint32_t generationId = uint32_t(info[kStorageGenerationId]);
+    return info[kStorageRef] == jlong(data.ref) &&
+            info[kStorageVerbs] == jlong(data.verbs) &&
+            info[kStoragePoints] == jlong(data.points) &&
+            info[kStorageVerbCount] == data.count &&
+            (generationId == 0 || generationId == data.generationId);
+}
+
+// Creates a TracedContours object holding the points of all the contours in a single
+// array, simplified if minAngle is >= 1. When hierarchy is true and traced is null, the
+// hierarchy is computed from the contours
+static jobject toTracedContours(JNIEnv* env, const ContourSet& contours, float minAngle,
+        bool hierarchy = false, const ContourHierarchy* traced = nullptr) {
+    PATHWAY_TRACE("pathway::toTracedContours");
+    PATHWAY_TIMER(Stat::TraceOutputNanos);
+
+    const int size = contours.size();
+
+    jintArray offsets = env->NewIntArray(size + 1);
+    jint* offsetsData = env->GetIntArrayElements(offsets, nullptr);
+
+    jfloatArray points;
+    if (minAngle >= 1.0f) {
+        Array<Point> simplified;
+        simplified.resize(contours.pointCount());
+
+        int count = 0;
+        for (int i = 0; i < size; i++) {
+            offsetsData[i] = count;
+            count += simplify(contours[i], minAngle, simplified.data() + count);
+        }
+        offsetsData[size] = count;
+
+        points = env->NewFloatArray(count * 2);
+        env->SetFloatArrayRegion(points, 0, count * 2,
+                reinterpret_cast<const jfloat*>(simplified.data()));
+    } else {
+        memcpy(offsetsData, contours.offsets(), sizeof(jint) * size);
+        offsetsData[size] = contours.pointCount();
+
+        const int count = contours.pointCount();
+        points = env->NewFloatArray(count * 2);
+        env->SetFloatArrayRegion(points, 0, count * 2,
+                reinterpret_cast<const jfloat*>(contours.points()));
+    }
+
+    env->ReleaseIntArrayElements(offsets, offsetsData, 0);
+
+    // The hierarchy is computed before simplification, which preserves the nesting
+    // of the contours but could in theory make them intersect
+    jintArray parents = nullptr;
+    jintArray depths = nullptr;
+    jfloatArray areas = nullptr;
+    if (hierarchy) {
+        ContourHierarchy computed;
+        if (traced == nullptr) {
+            computeHierarchy(contours, computed);
+            traced = &computed;
+        }
+
+        parents = env->NewIntArray(size);
+        env->SetIntArrayRegion(parents, 0, size, traced->parents.data());
+        depths = env->NewIntArray(size);
+        env->SetIntArrayRegion(depths, 0, size, traced->depths.data());
+        areas = env->NewFloatArray(size);
+        env->SetFloatArrayRegion(areas, 0, size, traced->areas.data());
+    }
+
+    jobject result = env->NewObject(sImage.tracedContoursClass, sImage.tracedContours,
+            points, offsets, parents, depths, areas);
+    env->DeleteLocalRef(points);
+    env->DeleteLocalRef(offsets);
+    if (hierarchy) {
+        env->DeleteLocalRef(parents);
+        env->DeleteLocalRef(depths);
+        env->DeleteLocalRef(areas);
+    }
+    return result;
+}
+
+// Converts the specified alpha thresholds into sorted 8 bit thresholds
+static void toAlphaThresholds(JNIEnv* env, jfloatArray thresholds_, Array<uint8_t>& thresholds) {
+    const int count = env->GetArrayLength(thresholds_);
+    thresholds.resize(count);
+
+    jfloat* alphaThresholds = env->GetFloatArrayElements(thresholds_, nullptr);
+    for (int i = 0; i < count; i++) {
+        thresholds[i] = uint8_t(toAlphaThreshold(alphaThresholds[i]));
+    }
+    env->ReleaseFloatArrayElements(thresholds_, alphaThresholds, JNI_ABORT);
+}
+
+// Must match the order of the TracingMethod enum in Image.kt
+enum class TracingMethod {
+    MarchingSquares,
+    BorderFollowing
+};
+
+// Traces the contours of the specified source at each of its levels with marching
+// squares, or follows the borders of its single level, in which case the hierarchy and
+// the connected components of the contours are also stored if not null
+static bool traceSource(const RowSource& source, ContourSet* contours, int count,
+        TracingMethod method, ContourHierarchy* hierarchy, ConnectedComponents* components) {
+    if (method == TracingMethod::BorderFollowing && count == 1) {
+        return followBorders(source, contours[0], hierarchy, components);
+    }
+    return traceLevels(source, contours, count);
+}
+
+// Traces the contours of the bitmap at each of the specified alpha thresholds, which
+// are converted to the precision of the alpha channel of the bitmap. Returns false if
+// the pixels of the bitmap cannot be read directly
+static bool traceBitmapContours(JNIEnv* env, jobject bitmap_,
+        const float* alphaThresholds, int count, ContourSet* contours,
+        TracingMethod method = TracingMethod::MarchingSquares,
+        ContourHierarchy* hierarchy = nullptr, ConnectedComponents* components = nullptr) {
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap_, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return false;
+    }
+
+    const int32_t format = info.format;
+    if (format != ANDROID_BITMAP_FORMAT_RGBA_8888 && format != ANDROID_BITMAP_FORMAT_A_8 &&
+            format != ANDROID_BITMAP_FORMAT_RGBA_F16 &&
+            format != ANDROID_BITMAP_FORMAT_RGBA_1010102) {
+        return false;
+    }
+
+    // Half float thresholds for RGBA_F16, 8 bit or 2 bit thresholds otherwise
+    Array<uint8_t> thresholds;
+    Array<uint16_t> halfThresholds;
+    thresholds.resize(count);
+    halfThresholds.resize(format == ANDROID_BITMAP_FORMAT_RGBA_F16 ? count : 0);
+    const int maxAlpha = format == ANDROID_BITMAP_FORMAT_RGBA_1010102 ? 3 : 255;
+    for (int i = 0; i < count; i++) {
+        if (format == ANDROID_BITMAP_FORMAT_RGBA_F16) {
+            halfThresholds[i] = toHalfAlphaThreshold(alphaThresholds[i]);
+        } else {
+            thresholds[i] = uint8_t(toAlphaThreshold(alphaThresholds[i], maxAlpha));
+        }
+    }
+
+    void* pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap_, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return false;
+    }
+
+    PATHWAY_TRACE("pathway::traceBitmap");
+    addStat(Stat::BitmapsTraced, 1);
+
+    // Read the pixels straight from the bitmap, two rows at a time, with a kernel
+    // dedicated to the format of the bitmap
+    const auto* data = static_cast<const uint8_t*>(pixels);
+    const int width = int(info.width);
+    const int height = int(info.height);
+    switch (format) {
+        case ANDROID_BITMAP_FORMAT_A_8: {
+            Alpha8Source alpha8 = { data, info.stride, thresholds.data(), count };
+            RowSource source = { width, height, &alpha8, Alpha8Source::readRow };
+            traceSource(source, contours, count, method, hierarchy, components);
+            break;
+        }
+        case ANDROID_BITMAP_FORMAT_RGBA_F16: {
+            RgbaF16Source f16 = { data, info.stride, halfThresholds.data(), count };
+            RowSource source = { width, height, &f16, RgbaF16Source::readRow };
+            traceSource(source, contours, count, method, hierarchy, components);
+            break;
+        }
+        case ANDROID_BITMAP_FORMAT_RGBA_1010102: {
+            Rgba1010102Source rgba1010102 = { data, info.stride, thresholds.data(), count };
+            RowSource source = { width, height, &rgba1010102, Rgba1010102Source::readRow };
+            traceSource(source, contours, count, method, hierarchy, components);
+            break;
+        }
+        default: {
+            Rgba8888Source rgba8888 = { data, info.stride, thresholds.data(), count };
+            RowSource source = { width, height, &rgba8888, Rgba8888Source::readRow };
+            traceSource(source, contours, count, method, hierarchy, components);
+            break;
+        }
+    }
+
+    AndroidBitmap_unlockPixels(env, bitmap_);
+
+    return true;
+}
+
+static jobject traceBitmap(JNIEnv* env, jclass,
+        jobject bitmap_, jfloat alphaThreshold_, jfloat minAngle_, jboolean hierarchy_,
+        jint method_) {
+    const auto method = TracingMethod(method_);
+
+    // Following borders gives the hierarchy for free
+    ContourHierarchy nesting;
+    ContourHierarchy* traced =
+            hierarchy_ && method == TracingMethod::BorderFollowing ? &nesting : nullptr;
+
+    ContourSet contours;
+    if (!traceBitmapContours(env, bitmap_, &alphaThreshold_, 1, &contours, method, traced)) {
+        return nullptr;
+    }
+    return toTracedContours(env, contours, minAngle_, hierarchy_ == JNI_TRUE, traced);
+}
+
+struct JavaRowSource {
+    JNIEnv* env;
+    jobject provider;
+    jintArray row;
+    jint* pixels;
+    int width;
+    const uint8_t* thresholds;
+    int thresholdCount;
+
+    // The provider always produces full rows, x and count are ignored
+    static bool readRow(void* context, int y, int, int, uint8_t* row) noexcept {
+        auto* source = static_cast<JavaRowSource*>(context);
+        JNIEnv* env = source->env;
+
+        env->CallVoidMethod(source->provider, sImage.getRow, y, source->row);
+        if (env->ExceptionCheck()) return false;
+
+        env->GetIntArrayRegion(source->row, 0, source->width, source->pixels);
+
+        const jint* pixels = source->pixels;
+        const uint8_t* thresholds = source->thresholds;
+        const int thresholdCount = source->thresholdCount;
+        for (int x = 0; x < source->width; x++) {
+            const uint32_t alpha = uint32_t(pixels[x]) >> 24;
+            int level = 0;
+            while (level < thresholdCount && alpha >= thresholds[level]) level++;
+            row[x] = uint8_t(level);
+        }
+        return true;
+    }
+};
+
+// Traces the contours of the image produced by the specified row provider at each of the
+// specified thresholds. Returns false if the provider threw an exception
+static bool traceRowContours(JNIEnv* env, jobject provider_, jint width_, jint height_,
+        const uint8_t* thresholds, int count, ContourSet* contours,
+        TracingMethod method = TracingMethod::MarchingSquares,
+        ContourHierarchy* hierarchy = nullptr, ConnectedComponents* components = nullptr) {
+    jintArray row = env->NewIntArray(width_);
+    if (row == nullptr) return false;
+
+    auto* pixels = static_cast<jint*>(malloc(sizeof(jint) * width_));
+
+    PATHWAY_TRACE("pathway::traceRows");
+    addStat(Stat::BitmapsTraced, 1);
+
+    JavaRowSource data = { env, provider_, row, pixels, width_, thresholds, count };
+    RowSource source = { width_, height_, &data, JavaRowSource::readRow };
+
+    bool traced = traceSource(source, contours, count, method, hierarchy, components);
+
+    free(pixels);
+    env->DeleteLocalRef(row);
+
+    return traced;
+}
+
+static jobject traceRows(JNIEnv* env, jclass,
+        jobject provider_, jint width_, jint height_, jfloat alphaThreshold_, jfloat minAngle_,
+        jboolean hierarchy_, jint method_) {
+    const uint8_t threshold = toAlphaThreshold(alphaThreshold_);
+    const auto method = TracingMethod(method_);
+
+    ContourHierarchy nesting;
+    ContourHierarchy* traced =
+            hierarchy_ && method == TracingMethod::BorderFollowing ? &nesting : nullptr;
+
+    ContourSet contours;
+    // An exception is pending if the trace was aborted
+    if (!traceRowContours(env, provider_, width_, height_, &threshold, 1, &contours,
+            method, traced)) {
+        return nullptr;
+    }
+    return toTracedContours(env, contours, minAngle_, hierarchy_ == JNI_TRUE, traced);
+}
+
+// Creates a TracedComponents object holding the contours, their hierarchy, and the
+// statistics of the connected components they bound
+static jobject toTracedComponents(JNIEnv* env, const ContourSet& contours,
+        const ContourHierarchy& hierarchy, const ConnectedComponents& components,
+        float minAngle) {
+    jobject traced = toTracedContours(env, contours, minAngle, true, &hierarchy);
+
+    const int statsCount = components.stats.size() * kComponentStatsSize;
+    jintArray stats = env->NewIntArray(statsCount);
+    env->SetIntArrayRegion(stats, 0, statsCount,
+            reinterpret_cast<const jint*>(components.stats.data()));
+
+    const int contourCount = components.contourComponents.size();
+    jintArray contourComponents = env->NewIntArray(contourCount);
+    env->SetIntArrayRegion(contourComponents, 0, contourCount,
+            components.contourComponents.data());
+
+    jobject result = env->NewObject(sImage.tracedComponentsClass, sImage.tracedComponents,
+            traced, stats, contourComponents);
+    env->DeleteLocalRef(traced);
+    env->DeleteLocalRef(stats);
+    env->DeleteLocalRef(contourComponents);
+    return result;
+}
+
+// Returns null if the pixels of the bitmap cannot be read directly. The labels array is
+// optional, and must contain width * height entries
+static jobject traceBitmapComponents(JNIEnv* env, jclass,
+        jobject bitmap_, jfloat alphaThreshold_, jfloat minAngle_, jintArray labels_) {
+    ContourSet contours;
+    ContourHierarchy hierarchy;
+    ConnectedComponents components;
+    components.labels = labels_ ? env->GetIntArrayElements(labels_, nullptr) : nullptr;
+
+    const bool traced = traceBitmapContours(env, bitmap_, &alphaThreshold_, 1, &contours,
+            TracingMethod::BorderFollowing, &hierarchy, &components);
+
+    if (labels_) {
+        env->ReleaseIntArrayElements(labels_, components.labels, traced ? 0 : JNI_ABORT);
+    }
+    if (!traced) return nullptr;
+
+    return toTracedComponents(env, contours, hierarchy, components, minAngle_);
+}
+
+// Returns null if the provider threw an exception, see traceRows()
+static jobject traceRowComponents(JNIEnv* env, jclass,
+        jobject provider_, jint width_, jint height_, jfloat alphaThreshold_, jfloat minAngle_,
+        jintArray labels_) {
+    const uint8_t threshold = toAlphaThreshold(alphaThreshold_);
+
+    ContourSet contours;
+    ContourHierarchy hierarchy;
+    ConnectedComponents components;
+    components.labels = labels_ ? env->GetIntArrayElements(labels_, nullptr) : nullptr;
+
+    const bool traced = traceRowContours(env, provider_, width_, height_, &threshold, 1,
+            &contours, TracingMethod::BorderFollowing, &hierarchy, &components);
+
+    if (labels_) {
+        env->ReleaseIntArrayElements(labels_, components.labels, traced ? 0 : JNI_ABORT);
+    }
+    if (!traced) return nullptr;
+
+    return toTracedComponents(env, contours, hierarchy, components, minAngle_);
+}
+
+static ContourSet* createContourSets(int count) {
+    auto* contours = static_cast<ContourSet*>(malloc(sizeof(ContourSet) * count));
+    for (int i = 0; i < count; i++) {
+        new(&contours[i]) ContourSet();
+    }
+    return contours;
+}
+
+static void destroyContourSets(ContourSet* contours, int count) {
+    for (int i = 0; i < count; i++) {
+        contours[i].~ContourSet();
+    }
+    free(contours);
+}
+
+static jobjectArray toTracedContoursArray(
+        JNIEnv* env, const ContourSet* contours, int count, float minAngle) {
+    jobjectArray result = env->NewObjectArray(count, sImage.tracedContoursClass, nullptr);
+    for (int i = 0; i < count; i++) {
+        jobject level = toTracedContours(env, contours[i], minAngle);
+        env->SetObjectArrayElement(result, i, level);
+        env->DeleteLocalRef(level);
+    }
+    return result;
+}
+
+static jobjectArray traceBitmapLevels(JNIEnv* env, jclass,
+        jobject bitmap_, jfloatArray alphaThresholds_, jfloat minAngle_) {
+    const int count = env->GetArrayLength(alphaThresholds_);
+    ContourSet* contours = createContourSets(count);
+
+    jfloat* alphaThresholds = env->GetFloatArrayElements(alphaThresholds_, nullptr);
+    const bool traced = traceBitmapContours(env, bitmap_, alphaThresholds, count, contours);
+    env->ReleaseFloatArrayElements(alphaThresholds_, alphaThresholds, JNI_ABORT);
+
+    jobjectArray result = nullptr;
+    if (traced) {
+        result = toTracedContoursArray(env, contours, count, minAngle_);
+    }
+
+    destroyContourSets(contours, count);
+    return result;
+}
+
+static jobjectArray traceRowLevels(JNIEnv* env, jclass, jobject provider_,
+        jint width_, jint height_, jfloatArray alphaThresholds_, jfloat minAngle_) {
+    Array<uint8_t> thresholds;
+    toAlphaThresholds(env, alphaThresholds_, thresholds);
+
+    const int count = thresholds.size();
+    ContourSet* contours = createContourSets(count);
+
+    jobjectArray result = nullptr;
+    if (traceRowContours(env, provider_, width_, height_, thresholds.data(), count, contours)) {
+        result = toTracedContoursArray(env, contours, count, minAngle_);
+    }
+
+    destroyContourSets(contours, count);
+    return result;
+}
+
+static jlong createTracingSession(JNIEnv*, jclass, jint width_, jint height_, jint tileSize_) {
+    return jlong(new(malloc(sizeof(TracingSession))) TracingSession(width_, height_, tileSize_));
+}
+
+static void destroyTracingSession(JNIEnv*, jclass, jlong session_) {
+    TracingSession* session = reinterpret_cast<TracingSession*>(session_);
+    session->~TracingSession();
+    free(session);
+}
+
+static jboolean tracingSessionUpdate(JNIEnv* env, jclass, jlong session_, jobject bitmap_,
+        jfloat alphaThreshold_, jint left_, jint top_, jint right_, jint bottom_) {
+    auto session = reinterpret_cast<TracingSession*>(session_);
+
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap_, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+    if (info.format != ANDROID_BITMAP_FORMAT_RGBA_8888) return JNI_FALSE;
+    if (int(info.width) != session->width() || int(info.height) != session->height()) {
+        return JNI_FALSE;
+    }
+
+    void* pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap_, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+
+    PATHWAY_TRACE("pathway::TracingSession::update");
+
+    const uint8_t threshold = toAlphaThreshold(alphaThreshold_);
+    Rgba8888Source data = { static_cast<const uint8_t*>(pixels), info.stride, &threshold, 1 };
+    RowSource source = { int(info.width), int(info.height), &data, Rgba8888Source::readRow };
+
+    const bool updated = session->update(source, left_, top_, right_, bottom_);
+
+    AndroidBitmap_unlockPixels(env, bitmap_);
+
+    return updated ? JNI_TRUE : JNI_FALSE;
+}
+
+static jobject tracingSessionContours(
+        JNIEnv* env, jclass, jlong session_, jfloat minAngle_) {
+    ContourSet contours;
+    {
+        PATHWAY_TRACE("pathway::TracingSession::stitch");
+        reinterpret_cast<TracingSession*>(session_)->stitch(contours);
+    }
+    return toTracedContours(env, contours, minAngle_);
+}
+
+static void unlockBitmaps(JNIEnv* env, jobjectArray bitmaps_, int count) {
+    for (int i = 0; i < count; i++) {
+        jobject bitmap = env->GetObjectArrayElement(bitmaps_, i);
+        if (bitmap != nullptr) {
+            AndroidBitmap_unlockPixels(env, bitmap);
+            env->DeleteLocalRef(bitmap);
+        }
+    }
+}
+
+// Each item of the batch is either a bitmap, or a buffer whose width, height and stride
+// are stored in sizes_. The pixels of the bitmaps stay locked until the batch is destroyed.
+// Returns 0 if the pixels of an item cannot be read
+static jlong createBatchTracer(JNIEnv* env, jclass, jobjectArray bitmaps_,
+        jobjectArray buffers_, jintArray sizes_, jfloatArray parameters_) {
+    const int count = env->GetArrayLength(bitmaps_);
+    auto* tracer = new(malloc(sizeof(BatchTracer))) BatchTracer(count);
+
+    jint* sizes = env->GetIntArrayElements(sizes_, nullptr);
+    jfloat* parameters = env->GetFloatArrayElements(parameters_, nullptr);
+
+    // Number of items whose pixels were successfully acquired
+    int locked = 0;
+    bool valid = true;
+    for (int i = 0; i < count && valid; i++) {
+        BatchItem& item = (*tracer)[i];
+        item.threshold = uint8_t(toAlphaThreshold(parameters[i * 2]));
+        item.minAngle = parameters[i * 2 + 1];
+
+        jobject bitmap = env->GetObjectArrayElement(bitmaps_, i);
+        if (bitmap != nullptr) {
+            AndroidBitmapInfo info;
+            void* pixels;
+            valid = AndroidBitmap_getInfo(env, bitmap, &info) == ANDROID_BITMAP_RESULT_SUCCESS &&
+                    info.format == ANDROID_BITMAP_FORMAT_RGBA_8888 &&
+                    AndroidBitmap_lockPixels(env, bitmap, &pixels) ==
+                            ANDROID_BITMAP_RESULT_SUCCESS;
+            if (valid) {
+                item.pixels = static_cast<const uint8_t*>(pixels);
+                item.stride = info.stride;
+                item.width = int(info.width);
+                item.height = int(info.height);
+            }
+            env->DeleteLocalRef(bitmap);
+        } else {
+            jobject buffer = env->GetObjectArrayElement(buffers_, i);
+            item.pixels = static_cast<const uint8_t*>(env->GetDirectBufferAddress(buffer));
+            item.width = sizes[i * 3];
+            item.height = sizes[i * 3 + 1];
+            item.stride = uint32_t(sizes[i * 3 + 2]);
+            valid = item.pixels != nullptr;
+            env->DeleteLocalRef(buffer);
+        }
+
+        if (valid) locked = i + 1;
+    }
+
+    env->ReleaseFloatArrayElements(parameters_, parameters, JNI_ABORT);
+    env->ReleaseIntArrayElements(sizes_, sizes, JNI_ABORT);
+
+    if (!valid) {
+        unlockBitmaps(env, bitmaps_, locked);
+        tracer->~BatchTracer();
+        free(tracer);
+        return 0;
+    }
+
+    tracer->start(0);
+    return jlong(tracer);
+}
+
+static void destroyBatchTracer(JNIEnv* env, jclass, jlong tracer_, jobjectArray bitmaps_) {
+    auto* tracer = reinterpret_cast<BatchTracer*>(tracer_);
+    const int count = tracer->size();
+    // Wait for the threads before unlocking the pixels they may be reading
+    tracer->~BatchTracer();
+    free(tracer);
+    unlockBitmaps(env, bitmaps_, count);
+}
+
+static jint batchTracerNext(JNIEnv*, jclass, jlong tracer_) {
+    return reinterpret_cast<BatchTracer*>(tracer_)->next();
+}
+
+static jobject batchTracerContours(JNIEnv* env, jclass, jlong tracer_, jint index_) {
+    ContourSet& contours = (*reinterpret_cast<BatchTracer*>(tracer_))[index_].contours;
+    // The contours were already simplified
+    jobject result = toTracedContours(env, contours, 0.0f);
+    // Release the memory of the contours as soon as possible in large batches
+    contours.~ContourSet();
+    new(&contours) ContourSet();
+    return result;
+}
+
+static jobject parseSvgPathData(JNIEnv* env, jclass,
+        jstring pathData_, jint conicEvaluation_, jfloat tolerance_) {
+    PATHWAY_TRACE("pathway::parseSvgPathData");
+
+    // The parser works on bytes, characters outside of the ASCII range are invalid
+    const int length = env->GetStringLength(pathData_);
+    auto* data = static_cast<char*>(malloc(length + kSvgPathPadding));
+    const jchar* chars = env->GetStringCritical(pathData_, nullptr);
+    for (int i = 0; i < length; i++) {
+        data[i] = chars[i] < 0x80 ? char(chars[i]) : char(0x80);
+    }
+    env->ReleaseStringCritical(pathData_, chars);
+    memset(data + length, 0, kSvgPathPadding);
+
+    PackedPath path(PathIterator::ConicEvaluation(conicEvaluation_), tolerance_);
+    const int error = parseSvgPath(data, length, path);
+    free(data);
+
+    const int verbCount = path.verbs().size();
+    jbyteArray verbs = env->NewByteArray(verbCount);
+    env->SetByteArrayRegion(verbs, 0, verbCount,
+            reinterpret_cast<const jbyte*>(path.verbs().data()));
+
+    const int pointCount = path.points().size();
+    jfloatArray points = env->NewFloatArray(pointCount * 2);
+    env->SetFloatArrayRegion(points, 0, pointCount * 2,
+            reinterpret_cast<const jfloat*>(path.points().data()));
+
+    const int conicWeightCount = path.conicWeights().size();
+    jfloatArray conicWeights = env->NewFloatArray(conicWeightCount);
+    env->SetFloatArrayRegion(conicWeights, 0, conicWeightCount, path.conicWeights().data());
+
+    jobject result = env->NewObject(sSvg.packedPathClass, sSvg.packedPath,
+            verbs, points, conicWeights, error);
+    env->DeleteLocalRef(verbs);
+    env->DeleteLocalRef(points);
+    env->DeleteLocalRef(conicWeights);
+    return result;
+}
+
+// The fill type is the ordinal of Path.FillType: bit 0 is set for the even-odd rule
+// and bit 1 for inverse fill types. The field is rendered on one thread per core.
+// Returns false if the bitmap cannot be written to directly, or if its format does not
+// match the type of field
+static jboolean pathToDistanceField(JNIEnv* env, jclass, jobject path_, jint fillType_,
+        jobject bitmap_, jfloat range_, jboolean multiChannel_) {
+    const bool multiChannel = multiChannel_ == JNI_TRUE;
+
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap_, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+    const int32_t format = multiChannel ?
+            ANDROID_BITMAP_FORMAT_RGBA_8888 : ANDROID_BITMAP_FORMAT_A_8;
+    if (info.format != format) return JNI_FALSE;
+
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+
+    DistanceField field;
+    field.setPath(iterator, (fillType_ & 1) != 0, (fillType_ & 2) != 0);
+
+    void* pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap_, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+
+    field.render(static_cast<uint8_t*>(pixels), info.stride, int(info.width), int(info.height),
+            range_, multiChannel ?
+                    DistanceField::Type::MultiChannel : DistanceField::Type::SingleChannel,
+            0);
+
+    AndroidBitmap_unlockPixels(env, bitmap_);
+
+    return JNI_TRUE;
+}
+
+static jboolean pathToAlphaMask(JNIEnv* env, jclass, jobject path_, jint fillType_,
+        jobject bitmap_, jfloat tolerance_) {
+    AndroidBitmapInfo info;
+    if (AndroidBitmap_getInfo(env, bitmap_, &info) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+    if (info.format != ANDROID_BITMAP_FORMAT_A_8) return JNI_FALSE;
+
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(
+            data, PathIterator::ConicEvaluation::AsQuadratics, tolerance_);
+
+    Rasterizer rasterizer;
+    rasterizer.setPath(iterator, tolerance_);
+
+    void* pixels;
+    if (AndroidBitmap_lockPixels(env, bitmap_, &pixels) != ANDROID_BITMAP_RESULT_SUCCESS) {
+        return JNI_FALSE;
+    }
+
+    rasterizer.render(static_cast<uint8_t*>(pixels), info.stride,
+            int(info.width), int(info.height), (fillType_ & 1) != 0, (fillType_ & 2) != 0);
+
+    AndroidBitmap_unlockPixels(env, bitmap_);
+
+    return JNI_TRUE;
+}
+
+static void pathToAlphaMaskArray(JNIEnv* env, jclass, jobject path_, jint fillType_,
+        jbyteArray pixels_, jint width_, jint height_, jint stride_, jfloat tolerance_) {
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(
+            data, PathIterator::ConicEvaluation::AsQuadratics, tolerance_);
+
+    // Flatten the path before entering the critical section
+    Rasterizer rasterizer;
+    rasterizer.setPath(iterator, tolerance_);
+
+    auto* pixels = static_cast<jbyte*>(env->GetPrimitiveArrayCritical(pixels_, nullptr));
+    rasterizer.render(reinterpret_cast<uint8_t*>(pixels), uint32_t(stride_), width_, height_,
+            (fillType_ & 1) != 0, (fillType_ & 2) != 0);
+    env->ReleasePrimitiveArrayCritical(pixels_, pixels, 0);
+}
+
+// Intersects the segments of path with the segments of other, or with themselves if other
+// is null. The result stores the position and the parameters of each intersection in a
+// float array (x, y, t1, t2) and the indices of the segments in an int array
+static jobject pathIntersections(JNIEnv* env, jclass,
+        jobject path_, jobject other_, jfloat tolerance_) {
+    Intersector intersector;
+
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+    intersector.addPath(iterator, 0);
+
+    if (other_ != nullptr) {
+        PathData otherData;
+        getPathData(env, other_, &otherData);
+        PathIterator otherIterator = makePathIterator(
+                otherData, PathIterator::ConicEvaluation::AsConic);
+        intersector.addPath(otherIterator, 1);
+    }
+
+    intersector.intersect(other_ == nullptr, tolerance_);
+
+    const Array<Intersector::Intersection>& intersections = intersector.intersections();
+    const int count = intersections.size();
+
+    jfloatArray values_ = env->NewFloatArray(count * 4);
+    jintArray segments_ = env->NewIntArray(count * 2);
+
+    auto* values = static_cast<jfloat*>(env->GetPrimitiveArrayCritical(values_, nullptr));
+    auto* segments = static_cast<jint*>(env->GetPrimitiveArrayCritical(segments_, nullptr));
+    for (int i = 0; i < count; i++) {
+        const Intersector::Intersection& intersection = intersections[i];
+        values[i * 4    ] = intersection.x;
+        values[i * 4 + 1] = intersection.y;
+        values[i * 4 + 2] = intersection.t0;
+        values[i * 4 + 3] = intersection.t1;
+        segments[i * 2    ] = intersection.segment0;
+        segments[i * 2 + 1] = intersection.segment1;
+    }
+    env->ReleasePrimitiveArrayCritical(segments_, segments, 0);
+    env->ReleasePrimitiveArrayCritical(values_, values, 0);
+
+    jobject result = env->NewObject(sIntersections.packedIntersectionsClass,
+            sIntersections.packedIntersections, values_, segments_);
+    env->DeleteLocalRef(values_);
+    env->DeleteLocalRef(segments_);
+    return result;
+}
+
+// Returns the points of the convex hull of the path as pairs of x and y coordinates
+static jfloatArray pathConvexHull(JNIEnv* env, jclass, jobject path_, jfloat tolerance_) {
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+
+    Array<Point> hull;
+    convexHull(iterator, tolerance_, hull);
+
+    jfloatArray points = env->NewFloatArray(hull.size() * 2);
+    env->SetFloatArrayRegion(points, 0, hull.size() * 2,
+            reinterpret_cast<const jfloat*>(hull.data()));
+    return points;
+}
+
+// Stores the center, size and angle in radians of the minimum-area oriented box of the
+// path in box_
+static void pathOrientedBoundingBox(JNIEnv* env, jclass,
+        jobject path_, jfloat tolerance_, jfloatArray box_) {
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+
+    Array<Point> hull;
+    convexHull(iterator, tolerance_, hull);
+    const OrientedBox box = orientedBoundingBox(hull);
+
+    const jfloat values[5] = { box.center.x, box.center.y, box.width, box.height, box.angle };
+    env->SetFloatArrayRegion(box_, 0, 5, values);
+}
+
+// Returns the moments of each contour of the path, kContourMomentsSize floats per contour
+static jfloatArray pathMoments(JNIEnv* env, jclass, jobject path_) {
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+
+    Array<ContourMoments> moments;
+    computeMoments(iterator, moments);
+
+    const int count = moments.size() * kContourMomentsSize;
+    jfloatArray values = env->NewFloatArray(count);
+    env->SetFloatArrayRegion(values, 0, count, reinterpret_cast<const jfloat*>(moments.data()));
+    return values;
+}
+
+// Fills values_ with the kPathComplexitySize ints of PathComplexity, and bounds_ with the
+// bounds of the control points of the path
+static void pathComplexity(JNIEnv* env, jclass, jobject path_, jfloat tolerance_,
+        jintArray values_, jfloatArray bounds_) {
+    PathData data;
+    getPathData(env, path_, &data);
+    PathIterator iterator = makePathIterator(data, PathIterator::ConicEvaluation::AsConic);
+
+    PathComplexity complexity;
+    ControlBounds bounds;
+    analyzeComplexity(iterator, tolerance_, complexity, bounds);
+
+    env->SetIntArrayRegion(values_, 0, kPathComplexitySize,
+            reinterpret_cast<const jint*>(&complexity));
+    env->SetFloatArrayRegion(bounds_, 0, 4, reinterpret_cast<const jfloat*>(&bounds));
+}
+
+static jboolean statsAvailable(JNIEnv*, jclass) {
+    return PATHWAY_STATS ? JNI_TRUE : JNI_FALSE;
+}
+
+static jboolean statsIsEnabled(JNIEnv*, jclass) {
+    return statsEnabled() ? JNI_TRUE : JNI_FALSE;
+}
+
+static void statsSetEnabled(JNIEnv*, jclass, jboolean enabled_) {
+    setStatsEnabled(PATHWAY_STATS && enabled_ == JNI_TRUE);
+}
+
+static void statsReset(JNIEnv*, jclass) {
+    resetStats();
+}
+
+static void statsSnapshot(JNIEnv* env, jclass, jlongArray values_) {
+    uint64_t values[kStatCount];
+    snapshotStats(values);
+    const int count = env->GetArrayLength(values_);
+    env->SetLongArrayRegion(values_, 0, count < kStatCount ? count : kStatCount,
+            reinterpret_cast<const jlong*>(values));
+}
+
+// Methods whose signature starts with '!' are fast native methods. On API 26+ the
+// marker is removed since the Kotlin declarations use the @FastNative annotation
+static jint registerNatives(JNIEnv* env, const char* className,
+        const JNINativeMethod* methods, int count) {
+    jclass jniClass = env->FindClass(className);
+    if (jniClass == nullptr) return JNI_ERR;
+
+    auto* registered = static_cast<JNINativeMethod*>(malloc(sizeof(JNINativeMethod) * count));
+
+    const uint32_t apiLevel = android_get_device_api_level();
+    for (int i = 0; i < count; i++) {
+        registered[i] = methods[i];
+        if (apiLevel >= 26 && registered[i].signature[0] == '!') { // Android 8.0
+            registered[i].signature++;
+        }
+    }
+
+    jint result = env->RegisterNatives(jniClass, registered, count);
+
+    free(registered);
+    env->DeleteLocalRef(jniClass);
+
+    return result;
+}
+
 JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void*) {
     JNIEnv* env;
     if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) != JNI_OK) {
@@ -136,97 +1253,495 @@ JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void*) {
     if (sPath.nativePath == nullptr) return JNI_ERR;
 
     {
-        jclass pathsClass = env->FindClass(JNI_CLASS_NAME);
-        if (pathsClass == nullptr) return JNI_ERR;
-
-        jint result;
-
-        const uint32_t apiLevel = android_get_device_api_level();
-        if (apiLevel >= 26) { // Android 8.0
-            static const JNINativeMethod methods[] = {
-                    {
-                            (char *) "createInternalPathIterator",
-                            (char *) "(Landroid/graphics/Path;IF)J",
-                            reinterpret_cast<void *>(createPathIterator)
-                    },
-                    {
-                            (char *) "destroyInternalPathIterator",
-                            (char *) "(J)V",
-                            reinterpret_cast<void *>(destroyPathIterator)
-                    },
-                    {
-                            (char *) "internalPathIteratorHasNext",
-                            (char *) "(J)Z",
-                            reinterpret_cast<void *>(pathIteratorHasNext)
-                    },
-                    {
-                            (char *) "internalPathIteratorNext",
-                            (char *) "(J[FI)I",
-                            reinterpret_cast<void *>(pathIteratorNext)
-                    },
-                    {
-                            (char *) "internalPathIteratorPeek",
-                            (char *) "(J)I",
-                            reinterpret_cast<void *>(pathIteratorPeek)
-                    },
-                    {
-                            (char *) "internalPathIteratorRawSize",
-                            (char *) "(J)I",
-                            reinterpret_cast<void *>(pathIteratorRawSize)
-                    },
-                    {
-                            (char *) "internalPathIteratorSize",
-                            (char *) "(J)I",
-                            reinterpret_cast<void *>(pathIteratorSize)
-                    },
-            };
-
-            result = env->RegisterNatives(
-                    pathsClass, methods, sizeof(methods) / sizeof(JNINativeMethod)
-            );
-        } else {
-            static const JNINativeMethod methods[] = {
-                    {
-                            (char *) "createInternalPathIterator",
-                            (char *) "(Landroid/graphics/Path;IF)J",
-                            reinterpret_cast<void *>(createPathIterator)
-                    },
-                    {
-                            (char *) "destroyInternalPathIterator",
-                            (char *) "!(J)V",
-                            reinterpret_cast<void *>(destroyPathIterator)
-                    },
-                    {
-                            (char *) "internalPathIteratorHasNext",
-                            (char *) "!(J)Z",
-                            reinterpret_cast<void *>(pathIteratorHasNext)
-                    },
-                    {
-                            (char *) "internalPathIteratorNext",
-                            (char *) "!(J[FI)I",
-                            reinterpret_cast<void *>(pathIteratorNext)
-                    },
-                    {
-                            (char *) "internalPathIteratorPeek",
-                            (char *) "!(J)I",
-                            reinterpret_cast<void *>(pathIteratorPeek)
-                    },
-                    {
-                            (char *) "internalPathIteratorRawSize",
-                            (char *) "!(J)I",
-                            reinterpret_cast<void *>(pathIteratorRawSize)
-                    },
-                    {
-                            (char *) "internalPathIteratorSize",
-                            (char *) "!(J)I",
-                            reinterpret_cast<void *>(pathIteratorSize)
-                    },
-            };
-        }
+        jclass byteBufferClass = env->FindClass("java/nio/ByteBuffer");
+        if (byteBufferClass == nullptr) return JNI_ERR;
+        sPath.byteBufferClass = static_cast<jclass>(env->NewGlobalRef(byteBufferClass));
+        env->DeleteLocalRef(byteBufferClass);
+    }
+
+    {
+        jclass tracedContoursClass = env->FindClass("dev/romainguy/graphics/path/TracedContours");
+        if (tracedContoursClass == nullptr) return JNI_ERR;
+        sImage.tracedContoursClass =
+                static_cast<jclass>(env->NewGlobalRef(tracedContoursClass));
+        env->DeleteLocalRef(tracedContoursClass);
+
+        sImage.tracedContours = env->GetMethodID(sImage.tracedContoursClass, "<init>",
+                "([F[I[I[I[F)V");
+        if (sImage.tracedContours == nullptr) return JNI_ERR;
+
+        jclass tracedComponentsClass =
+                env->FindClass("dev/romainguy/graphics/path/TracedComponents");
+        if (tracedComponentsClass == nullptr) return JNI_ERR;
+        sImage.tracedComponentsClass =
+                static_cast<jclass>(env->NewGlobalRef(tracedComponentsClass));
+        env->DeleteLocalRef(tracedComponentsClass);
+
+        sImage.tracedComponents = env->GetMethodID(sImage.tracedComponentsClass, "<init>",
+                "(" JNI_TRACED_CONTOURS "[I[I)V");
+        if (sImage.tracedComponents == nullptr) return JNI_ERR;
+
+        jclass rowProviderClass = env->FindClass("dev/romainguy/graphics/path/RowProvider");
+        if (rowProviderClass == nullptr) return JNI_ERR;
+        sImage.getRow = env->GetMethodID(rowProviderClass, "getRow", "(I[I)V");
+        if (sImage.getRow == nullptr) return JNI_ERR;
+        env->DeleteLocalRef(rowProviderClass);
+    }
+
+    {
+        jclass packedPathClass = env->FindClass("dev/romainguy/graphics/path/PackedPath");
+        if (packedPathClass == nullptr) return JNI_ERR;
+        sSvg.packedPathClass = static_cast<jclass>(env->NewGlobalRef(packedPathClass));
+        env->DeleteLocalRef(packedPathClass);
+
+        sSvg.packedPath = env->GetMethodID(sSvg.packedPathClass, "<init>", "([B[F[FI)V");
+        if (sSvg.packedPath == nullptr) return JNI_ERR;
+    }
+
+    {
+        jclass packedIntersectionsClass =
+                env->FindClass("dev/romainguy/graphics/path/PackedIntersections");
+        if (packedIntersectionsClass == nullptr) return JNI_ERR;
+        sIntersections.packedIntersectionsClass =
+                static_cast<jclass>(env->NewGlobalRef(packedIntersectionsClass));
+        env->DeleteLocalRef(packedIntersectionsClass);
+
+        sIntersections.packedIntersections = env->GetMethodID(
+                sIntersections.packedIntersectionsClass, "<init>", "([F[I)V");
+        if (sIntersections.packedIntersections == nullptr) return JNI_ERR;
+    }
+
+    jint result;
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalPathIterator",
+                        (char *) "(Landroid/graphics/Path;IFIZZ)J",
+                        reinterpret_cast<void *>(createPathIterator)
+                },
+                {
+                        (char *) "destroyInternalPathIterator",
+                        (char *) "!(J)V",
+                        reinterpret_cast<void *>(destroyPathIterator)
+                },
+                {
+                        (char *) "internalPathIteratorHasNext",
+                        (char *) "!(J)Z",
+                        reinterpret_cast<void *>(pathIteratorHasNext)
+                },
+                {
+                        (char *) "internalPathIteratorNext",
+                        (char *) "!(J[FI)I",
+                        reinterpret_cast<void *>(pathIteratorNext)
+                },
+                {
+                        (char *) "internalPathIteratorNextBatch",
+                        (char *) "!(J[B[F)I",
+                        reinterpret_cast<void *>(pathIteratorNextBatch)
+                },
+                {
+                        (char *) "internalPathIteratorPeek",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathIteratorPeek)
+                },
+                {
+                        (char *) "internalPathIteratorRawSize",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathIteratorRawSize)
+                },
+                {
+                        (char *) "internalPathIteratorSize",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathIteratorSize)
+                },
+                {
+                        (char *) "internalPathIteratorSeek",
+                        (char *) "!(JJI)V",
+                        reinterpret_cast<void *>(pathIteratorSeek)
+                },
+                {
+                        (char *) "internalPathIteratorSeekContour",
+                        (char *) "!(JJI)V",
+                        reinterpret_cast<void *>(pathIteratorSeekContour)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalPathMorph",
+                        (char *) "(Landroid/graphics/Path;Landroid/graphics/Path;ZF)J",
+                        reinterpret_cast<void *>(createPathMorph)
+                },
+                {
+                        (char *) "destroyInternalPathMorph",
+                        (char *) "!(J)V",
+                        reinterpret_cast<void *>(destroyPathMorph)
+                },
+                {
+                        (char *) "internalPathMorphVerbCount",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathMorphVerbCount)
+                },
+                {
+                        (char *) "internalPathMorphValueCount",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathMorphValueCount)
+                },
+                {
+                        (char *) "internalPathMorphVerbs",
+                        (char *) "!(J[B)V",
+                        reinterpret_cast<void *>(pathMorphVerbs)
+                },
+                {
+                        (char *) "internalPathMorphInterpolate",
+                        (char *) "!(JF[F)V",
+                        reinterpret_cast<void *>(pathMorphInterpolate)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_MORPH_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "traceBitmap",
+                        (char *) "(Landroid/graphics/Bitmap;FFZI)" JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(traceBitmap)
+                },
+                {
+                        (char *) "traceRows",
+                        (char *) "(Ldev/romainguy/graphics/path/RowProvider;IIFFZI)"
+                                JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(traceRows)
+                },
+                {
+                        (char *) "traceBitmapLevels",
+                        (char *) "(Landroid/graphics/Bitmap;[FF)[" JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(traceBitmapLevels)
+                },
+                {
+                        (char *) "traceRowLevels",
+                        (char *) "(Ldev/romainguy/graphics/path/RowProvider;II[FF)["
+                                JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(traceRowLevels)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_IMAGE_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalTracingSession",
+                        (char *) "!(III)J",
+                        reinterpret_cast<void *>(createTracingSession)
+                },
+                {
+                        (char *) "destroyInternalTracingSession",
+                        (char *) "!(J)V",
+                        reinterpret_cast<void *>(destroyTracingSession)
+                },
+                {
+                        (char *) "internalTracingSessionUpdate",
+                        (char *) "(JLandroid/graphics/Bitmap;FIIII)Z",
+                        reinterpret_cast<void *>(tracingSessionUpdate)
+                },
+                {
+                        (char *) "internalTracingSessionContours",
+                        (char *) "(JF)" JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(tracingSessionContours)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_TRACING_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "statsAvailable",
+                        (char *) "!()Z",
+                        reinterpret_cast<void *>(statsAvailable)
+                },
+                {
+                        (char *) "statsIsEnabled",
+                        (char *) "!()Z",
+                        reinterpret_cast<void *>(statsIsEnabled)
+                },
+                {
+                        (char *) "statsSetEnabled",
+                        (char *) "!(Z)V",
+                        reinterpret_cast<void *>(statsSetEnabled)
+                },
+                {
+                        (char *) "statsReset",
+                        (char *) "!()V",
+                        reinterpret_cast<void *>(statsReset)
+                },
+                {
+                        (char *) "statsSnapshot",
+                        (char *) "!([J)V",
+                        reinterpret_cast<void *>(statsSnapshot)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_STATS_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalPathStorage",
+                        (char *) "(Landroid/graphics/Path;[J)[Ljava/nio/ByteBuffer;",
+                        reinterpret_cast<void *>(createPathStorage)
+                },
+                {
+                        (char *) "isInternalPathStorageValid",
+                        (char *) "!(Landroid/graphics/Path;[J)Z",
+                        reinterpret_cast<void *>(isPathStorageValid)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_STORAGE_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
         if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalBatchTracer",
+                        (char *) "([Landroid/graphics/Bitmap;[Ljava/nio/ByteBuffer;[I[F)J",
+                        reinterpret_cast<void *>(createBatchTracer)
+                },
+                {
+                        (char *) "destroyInternalBatchTracer",
+                        (char *) "(J[Landroid/graphics/Bitmap;)V",
+                        reinterpret_cast<void *>(destroyBatchTracer)
+                },
+                {
+                        (char *) "internalBatchTracerNext",
+                        (char *) "(J)I",
+                        reinterpret_cast<void *>(batchTracerNext)
+                },
+                {
+                        (char *) "internalBatchTracerContours",
+                        (char *) "(JI)" JNI_TRACED_CONTOURS,
+                        reinterpret_cast<void *>(batchTracerContours)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_BATCH_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "parseInternalSvgPathData",
+                        (char *) "(Ljava/lang/String;IF)Ldev/romainguy/graphics/path/PackedPath;",
+                        reinterpret_cast<void *>(parseSvgPathData)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_SVG_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathToDistanceField",
+                        (char *) "(Landroid/graphics/Path;ILandroid/graphics/Bitmap;FZ)Z",
+                        reinterpret_cast<void *>(pathToDistanceField)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_DISTANCE_FIELD_CLASS_NAME, methods,
+                sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathToAlphaMask",
+                        (char *) "(Landroid/graphics/Path;ILandroid/graphics/Bitmap;F)Z",
+                        reinterpret_cast<void *>(pathToAlphaMask)
+                },
+                {
+                        (char *) "internalPathToAlphaMaskArray",
+                        (char *) "(Landroid/graphics/Path;I[BIIIF)V",
+                        reinterpret_cast<void *>(pathToAlphaMaskArray)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_RASTERIZER_CLASS_NAME, methods,
+                sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathIntersections",
+                        (char *) "(Landroid/graphics/Path;Landroid/graphics/Path;F)"
+                                 "Ldev/romainguy/graphics/path/PackedIntersections;",
+                        reinterpret_cast<void *>(pathIntersections)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_INTERSECTIONS_CLASS_NAME, methods,
+                sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathConvexHull",
+                        (char *) "(Landroid/graphics/Path;F)[F",
+                        reinterpret_cast<void *>(pathConvexHull)
+                },
+                {
+                        (char *) "internalPathOrientedBoundingBox",
+                        (char *) "(Landroid/graphics/Path;F[F)V",
+                        reinterpret_cast<void *>(pathOrientedBoundingBox)
+                },
+        };
 
-        env->DeleteLocalRef(pathsClass);
+        result = registerNatives(
+                env, JNI_CONVEX_HULL_CLASS_NAME, methods,
+                sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
     }
 
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathMoments",
+                        (char *) "(Landroid/graphics/Path;)[F",
+                        reinterpret_cast<void *>(pathMoments)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_MOMENTS_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "createInternalPathIndex",
+                        (char *) "(Landroid/graphics/Path;I)J",
+                        reinterpret_cast<void *>(createPathIndex)
+                },
+                {
+                        (char *) "destroyInternalPathIndex",
+                        (char *) "!(J)V",
+                        reinterpret_cast<void *>(destroyPathIndex)
+                },
+                {
+                        (char *) "internalPathIndexVerbCount",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathIndexVerbCount)
+                },
+                {
+                        (char *) "internalPathIndexContourCount",
+                        (char *) "!(J)I",
+                        reinterpret_cast<void *>(pathIndexContourCount)
+                },
+                {
+                        (char *) "internalPathIndexContourStart",
+                        (char *) "!(JI)I",
+                        reinterpret_cast<void *>(pathIndexContourStart)
+                },
+                {
+                        (char *) "internalPathIndexContourOf",
+                        (char *) "!(JI)I",
+                        reinterpret_cast<void *>(pathIndexContourOf)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_INDEX_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "internalPathComplexity",
+                        (char *) "(Landroid/graphics/Path;F[I[F)V",
+                        reinterpret_cast<void *>(pathComplexity)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_COMPLEXITY_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    {
+        static const JNINativeMethod methods[] = {
+                {
+                        (char *) "traceBitmapComponents",
+                        (char *) "(Landroid/graphics/Bitmap;FF[I)" JNI_TRACED_COMPONENTS,
+                        reinterpret_cast<void *>(traceBitmapComponents)
+                },
+                {
+                        (char *) "traceRowComponents",
+                        (char *) "(Ldev/romainguy/graphics/path/RowProvider;IIFF[I)"
+                                JNI_TRACED_COMPONENTS,
+                        reinterpret_cast<void *>(traceRowComponents)
+                },
+        };
+
+        result = registerNatives(
+                env, JNI_COMPONENTS_CLASS_NAME, methods, sizeof(methods) / sizeof(JNINativeMethod)
+        );
+        if (result != JNI_OK) return result;
+    }
+
+    initTracing();
+
     return JNI_VERSION_1_6;
 }
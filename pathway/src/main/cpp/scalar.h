@@ -56,6 +56,15 @@ constexpr bool isFinite(const float array[], int count) noexcept {
     return prod == 0.0f;
 }
 
+// Checks the coordinates of the points one at a time with the bit-based isFinite(), which
+// unlike the product above cannot be folded to true when building with -ffast-math
+static inline bool areFinite(const Point points[], int count) noexcept {
+    for (int i = 0; i < count; i++) {
+        if (!isFinite(points[i].x) || !isFinite(points[i].y)) return false;
+    }
+    return true;
+}
+
 template<typename T>
 constexpr T tabs(T value) noexcept {
     if (value < 0) {
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Batch")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Path
+import java.nio.ByteBuffer
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * An image to trace with [traceAll], and the parameters used to trace it. See [Bitmap.toPaths]
+ * for a description of [alphaThreshold] and [minAngle].
+ */
+class TraceRequest private constructor(
+    val bitmap: Bitmap?,
+    val pixels: ByteBuffer?,
+    val width: Int,
+    val height: Int,
+    val stride: Int,
+    val alphaThreshold: Float,
+    val minAngle: Float
+) {
+    /**
+     * Creates a request to trace the specified [bitmap]. Bitmaps whose configuration is not
+     * [Bitmap.Config.ARGB_8888] are converted before tracing.
+     */
+    constructor(bitmap: Bitmap, alphaThreshold: Float = 0.0f, minAngle: Float = 15.0f) :
+        this(bitmap, null, bitmap.width, bitmap.height, 0, alphaThreshold, minAngle)
+
+    /**
+     * Creates a request to trace an image of size [width] by [height] whose pixels are
+     * stored in a direct [ByteBuffer], with 4 bytes per pixel and the alpha channel stored
+     * in the fourth byte of each pixel (the layout of [Bitmap.Config.ARGB_8888] in memory).
+     * Each row of pixels starts [stride] bytes after the previous one. The buffer must not
+     * be modified until it is traced.
+     */
+    constructor(
+        pixels: ByteBuffer,
+        width: Int,
+        height: Int,
+        stride: Int = width * 4,
+        alphaThreshold: Float = 0.0f,
+        minAngle: Float = 15.0f
+    ) : this(null, pixels, width, height, stride, alphaThreshold, minAngle) {
+        require(pixels.isDirect) { "The pixels must be stored in a direct ByteBuffer" }
+        require(width > 0 && height > 0) { "The image size must be > 0: $width*$height" }
+        require(stride >= width * 4) { "The stride must be >= width * 4: $stride" }
+        require(pixels.capacity().toLong() >= stride.toLong() * (height - 1) + width * 4) {
+            "The buffer is too small for an image of $width*$height pixels"
+        }
+    }
+}
+
+/**
+ * Extracts the contours of many images at once, as if [Bitmap.toPaths] was invoked on each
+ * image. The images are traced in parallel on a pool of native threads, one per core, which
+ * is much faster than tracing the images one after the other, including when the batch
+ * contains many small images.
+ *
+ * This function blocks until all the images are traced. When [onTraced] is specified, it is
+ * invoked on the calling thread with the index of each request and its contours as soon as
+ * they are available, in the order the images finish tracing, while the remaining images
+ * are still being traced.
+ *
+ * @param requests The images to trace and their parameters.
+ * @param onTraced Optional callback invoked as each image finishes tracing.
+ *
+ * @return A list containing, for each request and in the same order as [requests], the list
+ * of contours detected in the image as separate paths.
+ */
+fun traceAll(
+    requests: List<TraceRequest>,
+    onTraced: ((index: Int, paths: List<Path>) -> Unit)? = null
+): List<List<Path>> {
+    val results = arrayOfNulls<List<Path>>(requests.size)
+
+    // Images without alpha are handled here, the other images are traced by native code.
+    // indices maps the index of a traced image to the index of its request
+    val indices = IntArray(requests.size)
+    var count = 0
+    requests.forEachIndexed { index, request ->
+        val bitmap = request.bitmap
+        if (bitmap != null && !bitmap.hasAlpha()) {
+            val paths = listOf(
+                Path().apply {
+                    addRect(0.0f, 0.0f, bitmap.width.toFloat(), bitmap.height.toFloat(),
+                        Path.Direction.CCW)
+                }
+            )
+            results[index] = paths
+            onTraced?.invoke(index, paths)
+        } else {
+            indices[count++] = index
+        }
+    }
+
+    if (count > 0) {
+        val bitmaps = arrayOfNulls<Bitmap>(count)
+        val buffers = arrayOfNulls<ByteBuffer>(count)
+        val sizes = IntArray(count * 3)
+        val parameters = FloatArray(count * 2)
+
+        for (i in 0 until count) {
+            val request = requests[indices[i]]
+            val bitmap = request.bitmap
+            if (bitmap != null) {
+                bitmaps[i] = if (bitmap.config == Bitmap.Config.ARGB_8888) {
+                    bitmap
+                } else {
+                    checkNotNull(bitmap.copy(Bitmap.Config.ARGB_8888, false)) {
+                        "The bitmap at index ${indices[i]} could not be converted to ARGB_8888"
+                    }
+                }
+            } else {
+                buffers[i] = request.pixels
+                sizes[i * 3] = request.width
+                sizes[i * 3 + 1] = request.height
+                sizes[i * 3 + 2] = request.stride
+            }
+            parameters[i * 2] = request.alphaThreshold
+            parameters[i * 2 + 1] = request.minAngle
+        }
+
+        val batch = createInternalBatchTracer(bitmaps, buffers, sizes, parameters)
+        check(batch != 0L) { "The pixels of the images could not be read" }
+
+        try {
+            while (true) {
+                val i = internalBatchTracerNext(batch)
+                if (i < 0) break
+
+                val index = indices[i]
+                val paths = internalBatchTracerContours(batch, i).toPaths()
+                results[index] = paths
+                onTraced?.invoke(index, paths)
+            }
+        } finally {
+            destroyInternalBatchTracer(batch, bitmaps)
+        }
+    }
+
+    @Suppress("UNCHECKED_CAST")
+    return results.asList() as List<List<Path>>
+}
+
+/**
+ * Extracts the contours of all the bitmaps in this list, with the same parameters. See
+ * [traceAll] and [Bitmap.toPaths].
+ */
+fun List<Bitmap>.toPathsBatch(
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+): List<List<Path>> = traceAll(map { TraceRequest(it, alphaThreshold, minAngle) })
+
+private external fun createInternalBatchTracer(
+    bitmaps: Array<Bitmap?>,
+    buffers: Array<ByteBuffer?>,
+    sizes: IntArray,
+    parameters: FloatArray
+): Long
+
+private external fun destroyInternalBatchTracer(batch: Long, bitmaps: Array<Bitmap?>)
+
+private external fun internalBatchTracerNext(batch: Long): Int
+
+private external fun internalBatchTracerContours(batch: Long, index: Int): TracedContours
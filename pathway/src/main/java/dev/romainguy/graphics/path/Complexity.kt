@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Complexity")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import android.graphics.RectF
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Summary of the structure of a path, computed by [Path.complexity], used to estimate the
+ * cost of processing the path before sending it to an expensive pipeline (tessellation,
+ * distance fields, export, etc.), or to reject pathological paths early.
+ *
+ * @property tolerance The tolerance used to compute [quadraticsFromConics] and
+ * [flattenedLineCount].
+ * @property bounds Bounds of the control points of the path, which contain the path. The
+ * bounds exclude non-finite points, and are empty if the path has no finite point.
+ */
+class PathComplexity internal constructor(
+    val tolerance: Float,
+    private val values: IntArray,
+    val bounds: RectF
+) {
+    /** Number of [Move][PathSegment.Type.Move] verbs. */
+    val moveCount: Int get() = values[0]
+
+    /** Number of [Line][PathSegment.Type.Line] verbs. */
+    val lineCount: Int get() = values[1]
+
+    /** Number of [Quadratic][PathSegment.Type.Quadratic] verbs. */
+    val quadraticCount: Int get() = values[2]
+
+    /** Number of [Conic][PathSegment.Type.Conic] verbs. */
+    val conicCount: Int get() = values[3]
+
+    /** Number of [Cubic][PathSegment.Type.Cubic] verbs. */
+    val cubicCount: Int get() = values[4]
+
+    /** Number of [Close][PathSegment.Type.Close] verbs. */
+    val closeCount: Int get() = values[5]
+
+    /** Total number of verbs in the path. */
+    val verbCount: Int get() = moveCount + lineCount + quadraticCount + conicCount +
+        cubicCount + closeCount
+
+    /** Number of contours, each starting with a move. */
+    val contourCount: Int get() = values[6]
+
+    /**
+     * Number of contours that do not contain any line or curve, made of a single move, or
+     * of a move followed by a close.
+     */
+    val emptyContourCount: Int get() = values[7]
+
+    /**
+     * Number of quadratics produced by converting every conic of the path to quadratics at
+     * [tolerance], as done by [PathIterator.ConicEvaluation.AsQuadratics].
+     */
+    val quadraticsFromConics: Int get() = values[8]
+
+    /**
+     * Estimated number of lines required to approximate the path within [tolerance],
+     * including the lines that close contours. The estimate is derived from a bound of the
+     * curvature of each curve and is conservative.
+     */
+    val flattenedLineCount: Int get() = values[9]
+
+    /** Number of lines of length 0 and of curves whose points are all identical. */
+    val degenerateSegmentCount: Int get() = values[10]
+
+    /**
+     * Number of points with a NaN or infinite coordinate, plus the number of conic weights
+     * that are not finite or not positive.
+     */
+    val nonFiniteCount: Int get() = values[11]
+
+    /** Returns `true` if all the points and conic weights of the path are finite. */
+    val isFinite: Boolean get() = nonFiniteCount == 0
+
+    override fun toString(): String {
+        return "PathComplexity(moveCount=$moveCount, lineCount=$lineCount, " +
+            "quadraticCount=$quadraticCount, conicCount=$conicCount, " +
+            "cubicCount=$cubicCount, closeCount=$closeCount, " +
+            "contourCount=$contourCount, emptyContourCount=$emptyContourCount, " +
+            "quadraticsFromConics=$quadraticsFromConics, " +
+            "flattenedLineCount=$flattenedLineCount, " +
+            "degenerateSegmentCount=$degenerateSegmentCount, " +
+            "nonFiniteCount=$nonFiniteCount, bounds=$bounds)"
+    }
+
+    internal companion object {
+        // Must match kPathComplexitySize in Complexity.h
+        const val Size = 12
+    }
+}
+
+/**
+ * Analyzes the structure of this path in a single native pass over its verbs. Conics are
+ * split into quadratics to count them, while the number of lines required to flatten the
+ * path is only estimated: no curve is flattened. See [PathComplexity] for the information
+ * returned.
+ *
+ * @param tolerance The tolerance used to estimate the number of quadratics per conic, and
+ * the number of lines required to flatten the path, 0.25 by default.
+ */
+fun Path.complexity(tolerance: Float = 0.25f): PathComplexity {
+    require(tolerance > 0.0f) { "The tolerance must be greater than 0" }
+    val values = IntArray(PathComplexity.Size)
+    val bounds = FloatArray(4)
+    internalPathComplexity(this, tolerance, values, bounds)
+    return PathComplexity(tolerance, values, RectF(bounds[0], bounds[1], bounds[2], bounds[3]))
+}
+
+private external fun internalPathComplexity(
+    path: Path,
+    tolerance: Float,
+    values: IntArray,
+    bounds: FloatArray
+)
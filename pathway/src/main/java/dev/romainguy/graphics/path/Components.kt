@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Components")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Path
+import android.graphics.Rect
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Contours and connected components produced by the native tracer. The statistics of the
+ * components are stored in [stats], [ConnectedComponents.RecordSize] values per component.
+ */
+internal class TracedComponents(
+    val contours: TracedContours,
+    val stats: IntArray,
+    val contourComponents: IntArray
+)
+
+/**
+ * The connected components of the opaque pixels of an image, also called blobs, along with
+ * their contours. Two opaque pixels belong to the same component if they are connected
+ * through their left, right, top or bottom neighbors, which matches how contours are traced:
+ * each component is bounded by exactly one outer contour, and by one contour per hole.
+ *
+ * Components are identified by their index, between 0 and [size] (exclusive), in the order
+ * of their outer contours in [tree]. Connected components are created with
+ * [Bitmap.toConnectedComponents] or [RowProvider.toConnectedComponents].
+ *
+ * @property width Width of the traced image, in pixels.
+ * @property height Height of the traced image, in pixels.
+ * @property tree The contours of the components and how they are nested.
+ * @property labels When requested, the label of each pixel of the image, stored at the index
+ * `y * width + x`. The label of a pixel is the index of its component + 1, or 0 if the pixel
+ * is transparent.
+ */
+class ConnectedComponents internal constructor(
+    val width: Int,
+    val height: Int,
+    val tree: ContourTree,
+    private val stats: IntArray,
+    private val contourComponents: IntArray,
+    val labels: IntArray?
+) {
+    internal constructor(width: Int, height: Int, traced: TracedComponents, labels: IntArray?) :
+        this(
+            width,
+            height,
+            ContourTree(traced.contours),
+            traced.stats,
+            traced.contourComponents,
+            labels
+        )
+
+    /** Number of components. */
+    val size: Int
+        get() = stats.size / RecordSize
+
+    /** Returns the number of pixels of the component at [index]. */
+    fun area(index: Int): Int = stats[index * RecordSize]
+
+    /**
+     * Returns the bounds of the pixels of the component at [index]. The right and bottom
+     * coordinates are exclusive.
+     */
+    fun bounds(index: Int): Rect {
+        val offset = index * RecordSize
+        return Rect(stats[offset + 1], stats[offset + 2], stats[offset + 3], stats[offset + 4])
+    }
+
+    /** Returns the index in [tree] of the outer contour of the component at [index]. */
+    fun contour(index: Int): Int = stats[index * RecordSize + 5]
+
+    /** Returns the outer contour of the component at [index] as a [Path]. */
+    fun path(index: Int): Path = tree.paths[contour(index)]
+
+    /** Returns the indices in [tree] of the contours of the holes of the component at [index]. */
+    fun holes(index: Int): List<Int> = tree.children(contour(index))
+
+    /** Returns the index of the component bounded by the contour at index [contour] in [tree]. */
+    fun componentOf(contour: Int): Int = contourComponents[contour]
+
+    /**
+     * Returns the index of the component containing the pixel at ([x], [y]), or -1 if the
+     * pixel is transparent or outside of the image. The labels must have been requested
+     * when tracing the image.
+     */
+    fun componentAt(x: Int, y: Int): Int {
+        val labels = checkNotNull(labels) { "The labels of the pixels were not requested" }
+        if (x < 0 || y < 0 || x >= width || y >= height) return -1
+        return labels[y * width + x] - 1
+    }
+
+    internal companion object {
+        // Must match kComponentStatsSize in BorderTracer.h
+        const val RecordSize = 6
+    }
+}
+
+/**
+ * Extract the contours of this [Bitmap], as [Bitmap.toContourTree], along with the pixel area
+ * and bounds of each connected component of opaque pixels, and optionally the component of
+ * each pixel. The components are labelled during the same pass over the pixels as the
+ * contours, with [TracingMethod.BorderFollowing]. See [Bitmap.toPath] for a description of
+ * [alphaThreshold] and [minAngle].
+ *
+ * @param labels If `true`, [ConnectedComponents.labels] contains the label of every pixel,
+ * for hit testing with [ConnectedComponents.componentAt].
+ */
+fun Bitmap.toConnectedComponents(
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    labels: Boolean = false
+): ConnectedComponents {
+    val pixelLabels = if (labels) IntArray(width * height) else null
+
+    if (!hasAlpha()) {
+        val w = width.toFloat()
+        val h = height.toFloat()
+        pixelLabels?.fill(1)
+        return ConnectedComponents(
+            width,
+            height,
+            TracedComponents(
+                TracedContours(
+                    floatArrayOf(0.0f, 0.0f, 0.0f, h, w, h, w, 0.0f, 0.0f, 0.0f),
+                    intArrayOf(0, 5),
+                    intArrayOf(-1),
+                    intArrayOf(0),
+                    floatArrayOf(-w * h)
+                ),
+                intArrayOf(width * height, 0, 0, width, height, 0),
+                intArrayOf(0)
+            ),
+            pixelLabels
+        )
+    }
+
+    // Bitmaps we cannot read directly are fetched one row at a time through getPixels(),
+    // the labels array is reused since every pixel is labelled again
+    val traced = traceBitmapComponents(this, alphaThreshold, minAngle, pixelLabels)
+        ?: return RowProvider { y, row ->
+            getPixels(row, 0, width, 0, y, width, 1)
+        }.toConnectedComponents(width, height, alphaThreshold, minAngle, pixelLabels)
+    return ConnectedComponents(width, height, traced, pixelLabels)
+}
+
+/**
+ * Extract the contours and connected components of the image of size [width] by [height]
+ * whose pixels are supplied by this [RowProvider]. See [Bitmap.toConnectedComponents].
+ */
+fun RowProvider.toConnectedComponents(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    labels: Boolean = false
+): ConnectedComponents {
+    require(width > 0 && height > 0) { "The image size must be > 0: $width*$height" }
+    val pixelLabels = if (labels) IntArray(width * height) else null
+    return toConnectedComponents(width, height, alphaThreshold, minAngle, pixelLabels)
+}
+
+private fun RowProvider.toConnectedComponents(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float,
+    minAngle: Float,
+    pixelLabels: IntArray?
+): ConnectedComponents {
+    // traceRowComponents() only returns null if getRow() threw an exception, which is
+    // rethrown as soon as we return from the native call
+    val traced = traceRowComponents(this, width, height, alphaThreshold, minAngle, pixelLabels)
+        ?: TracedComponents(TracedContours.Empty, IntArray(0), IntArray(0))
+    return ConnectedComponents(width, height, traced, pixelLabels)
+}
+
+private external fun traceBitmapComponents(
+    bitmap: Bitmap,
+    alphaThreshold: Float,
+    minAngle: Float,
+    labels: IntArray?
+): TracedComponents?
+
+private external fun traceRowComponents(
+    provider: RowProvider,
+    width: Int,
+    height: Int,
+    alphaThreshold: Float,
+    minAngle: Float,
+    labels: IntArray?
+): TracedComponents?
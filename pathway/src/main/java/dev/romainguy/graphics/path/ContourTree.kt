@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+
+/**
+ * The contours extracted from an image, and how they are nested in each other. Contours are
+ * identified by their index, between 0 and [size] (exclusive), in the order of [paths].
+ *
+ * Traced contours never intersect: each contour is either at the top level of the image, or
+ * enclosed by another contour, its [parent]. The contours at an even [depth] are the outer
+ * boundaries of shapes, the contours at an odd depth are holes in the shape defined by their
+ * parent. Outer boundaries are counter-clockwise and holes are clockwise.
+ *
+ * A contour tree is created with [Bitmap.toContourTree][android.graphics.Bitmap.toContourTree]
+ * or [RowProvider.toContourTree].
+ */
+class ContourTree internal constructor(private val contours: TracedContours) {
+    private val parents = contours.parents ?: IntArray(0)
+    private val depths = contours.depths ?: IntArray(0)
+    private val areas = contours.areas ?: FloatArray(0)
+
+    // The children of contour i are stored in children from childOffsets[i + 1] until
+    // childOffsets[i + 2], the roots from childOffsets[0] until childOffsets[1]
+    private val childOffsets = IntArray(size + 2)
+    private val children = IntArray(size)
+
+    init {
+        for (parent in parents) childOffsets[parent + 2]++
+        for (i in 2 until childOffsets.size) childOffsets[i] += childOffsets[i - 1]
+        val cursors = childOffsets.copyOf()
+        for (i in parents.indices) children[cursors[parents[i] + 1]++] = i
+    }
+
+    /** Number of contours in this tree. */
+    val size: Int
+        get() = contours.size
+
+    /** The contours as separate paths, see [Bitmap.toPaths][android.graphics.Bitmap.toPaths]. */
+    val paths: List<Path> by lazy { contours.toPaths() }
+
+    /** Indices of the contours that are not enclosed by any other contour. */
+    val roots: List<Int>
+        get() = children(-1)
+
+    /**
+     * Returns the index of the innermost contour enclosing the contour at [index], or -1
+     * if the contour is at the top level.
+     */
+    fun parent(index: Int): Int = parents[index]
+
+    /**
+     * Returns the indices of the contours directly enclosed by the contour at [index],
+     * in ascending order. Passing -1 returns the [roots].
+     */
+    fun children(index: Int): List<Int> =
+        children.copyOfRange(childOffsets[index + 1], childOffsets[index + 2]).asList()
+
+    /** Returns the number of contours enclosing the contour at [index]. */
+    fun depth(index: Int): Int = depths[index]
+
+    /** Returns `true` if the contour at [index] is a hole in the shape of its [parent]. */
+    fun isHole(index: Int): Boolean = depths[index] and 1 == 1
+
+    /**
+     * Returns the signed area of the contour at [index], in pixels. The area is negative
+     * for counter-clockwise contours and positive for clockwise contours.
+     */
+    fun signedArea(index: Int): Float = areas[index]
+
+    /** Returns the winding direction of the contour at [index]. */
+    fun direction(index: Int): Path.Direction =
+        if (areas[index] < 0.0f) Path.Direction.CCW else Path.Direction.CW
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("ConvexHull")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import kotlin.math.cos
+import kotlin.math.sin
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * A rectangle rotated by [angle] degrees around its center ([centerX], [centerY]). The
+ * [width] of the rectangle is measured along the direction given by [angle], and its
+ * [height] perpendicular to it.
+ */
+class OrientedBoundingBox internal constructor(
+    val centerX: Float,
+    val centerY: Float,
+    val width: Float,
+    val height: Float,
+    val angle: Float
+) {
+    /**
+     * Returns the 4 corners of the box as pairs of x and y coordinates, in the same
+     * order as the points of [Path.convexHullPoints].
+     */
+    fun corners(): FloatArray {
+        val radians = Math.toRadians(angle.toDouble())
+        val ex = cos(radians).toFloat() * width * 0.5f
+        val ey = sin(radians).toFloat() * width * 0.5f
+        val nx = -sin(radians).toFloat() * height * 0.5f
+        val ny = cos(radians).toFloat() * height * 0.5f
+        return floatArrayOf(
+            centerX - ex - nx, centerY - ey - ny,
+            centerX + ex - nx, centerY + ey - ny,
+            centerX + ex + nx, centerY + ey + ny,
+            centerX - ex + nx, centerY - ey + ny
+        )
+    }
+
+    override fun toString(): String {
+        return "OrientedBoundingBox(centerX=$centerX, centerY=$centerY, " +
+                "width=$width, height=$height, angle=$angle)"
+    }
+}
+
+/**
+ * Computes the convex hull of this path and returns its points as pairs of x and y
+ * coordinates, clockwise on screen and without collinear points. The hull of an empty path
+ * is empty.
+ *
+ * The hull is computed natively, directly from the storage of the path. A first pass
+ * discards the segments that cannot touch the hull because their control points are
+ * inside the polygon formed by the extreme points of the path. The remaining curves are
+ * then evaluated exactly within [tolerance], which makes the hull tighter than the hull of
+ * the control points.
+ *
+ * @param tolerance Maximum distance between the hull and the curves of the path.
+ */
+fun Path.convexHullPoints(tolerance: Float = 0.25f): FloatArray {
+    require(tolerance > 0.0f) { "The tolerance must be greater than 0" }
+    return internalPathConvexHull(this, tolerance)
+}
+
+/**
+ * Computes the convex hull of this path and returns it as a closed polygon in [hull]. See
+ * [convexHullPoints] for more information.
+ *
+ * @param tolerance Maximum distance between the hull and the curves of the path.
+ * @param hull The path to add the hull to, a new path by default.
+ */
+fun Path.convexHull(tolerance: Float = 0.25f, hull: Path = Path()): Path {
+    val points = convexHullPoints(tolerance)
+    if (points.isNotEmpty()) {
+        hull.moveTo(points[0], points[1])
+        for (i in 2 until points.size step 2) {
+            hull.lineTo(points[i], points[i + 1])
+        }
+        hull.close()
+    }
+    return hull
+}
+
+/**
+ * Computes the rectangle of minimum area that contains this path, with rotating calipers
+ * over the edges of its [convex hull][convexHullPoints]. One side of the rectangle is
+ * always collinear with an edge of the hull.
+ *
+ * @param tolerance Maximum distance between the hull and the curves of the path.
+ */
+fun Path.orientedBoundingBox(tolerance: Float = 0.25f): OrientedBoundingBox {
+    require(tolerance > 0.0f) { "The tolerance must be greater than 0" }
+    val box = FloatArray(5)
+    internalPathOrientedBoundingBox(this, tolerance, box)
+    return OrientedBoundingBox(
+        box[0], box[1], box[2], box[3], Math.toDegrees(box[4].toDouble()).toFloat()
+    )
+}
+
+private external fun internalPathConvexHull(path: Path, tolerance: Float): FloatArray
+
+private external fun internalPathOrientedBoundingBox(path: Path, tolerance: Float, box: FloatArray)
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("DistanceField")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Path
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Type of the distance fields generated by [Path.toDistanceField].
+ */
+enum class DistanceFieldType {
+    /**
+     * The signed distance to the outline of the path, stored in a bitmap of configuration
+     * [Bitmap.Config.ALPHA_8].
+     */
+    SingleChannel,
+
+    /**
+     * A multi-channel signed distance field (MSDF), stored in a bitmap of configuration
+     * [Bitmap.Config.ARGB_8888]. The red, green and blue channels contain distances to
+     * different edges of the outline, and the median of the three channels is the signed
+     * distance to the outline. Unlike single-channel fields, multi-channel fields preserve
+     * sharp corners when magnified. The alpha channel contains the same signed distance as
+     * a single-channel field.
+     */
+    MultiChannel
+}
+
+/**
+ * Generates a signed distance field of this path, in a new bitmap of size [width] by
+ * [height]. See the overload that takes a [Bitmap] for a description of [range] and [type].
+ */
+fun Path.toDistanceField(
+    width: Int,
+    height: Int,
+    range: Float = 4.0f,
+    type: DistanceFieldType = DistanceFieldType.SingleChannel
+): Bitmap {
+    val config = if (type == DistanceFieldType.SingleChannel) {
+        Bitmap.Config.ALPHA_8
+    } else {
+        Bitmap.Config.ARGB_8888
+    }
+    return toDistanceField(Bitmap.createBitmap(width, height, config), range, type)
+}
+
+/**
+ * Generates a signed distance field of this path, typically to render icons or glyphs at
+ * any scale with a distance field shader, and stores it in [bitmap]. The bitmap must be
+ * mutable, and its configuration must be [Bitmap.Config.ALPHA_8] for single-channel fields
+ * and [Bitmap.Config.ARGB_8888] for multi-channel fields, in which case the bitmap is
+ * marked as not premultiplied.
+ *
+ * The pixel at (x, y) contains the signed distance between the point (x + 0.5, y + 0.5) of
+ * the path and its outline, positive inside the path as defined by its fill type. The
+ * distance is mapped to the 0..1 range: 0.5 on the outline, 1.0 at [range] pixels or more
+ * inside the path and 0.0 at [range] pixels or more outside. Transform the path before
+ * calling this method to choose the area and scale of the field.
+ *
+ * Distances to lines and quadratics are computed exactly, while distances to cubics and
+ * conics are approximated with Newton iterations from several starting points. The bitmap
+ * is divided in tiles rendered in parallel by native threads, one per core, started for
+ * each call.
+ *
+ * @param bitmap The bitmap to write the distance field to.
+ * @param range Distance in pixels, greater than 0, at which the field saturates.
+ * @param type The type of distance field to generate.
+ *
+ * @return The [bitmap] passed as a parameter.
+ */
+fun Path.toDistanceField(
+    bitmap: Bitmap,
+    range: Float = 4.0f,
+    type: DistanceFieldType = DistanceFieldType.SingleChannel
+): Bitmap {
+    require(range > 0.0f) { "The range must be greater than 0" }
+    require(bitmap.isMutable) { "The bitmap must be mutable" }
+
+    val config = if (type == DistanceFieldType.SingleChannel) {
+        Bitmap.Config.ALPHA_8
+    } else {
+        Bitmap.Config.ARGB_8888
+    }
+    require(bitmap.config == config) { "A $type distance field requires a $config bitmap" }
+
+    if (type == DistanceFieldType.MultiChannel) bitmap.isPremultiplied = false
+
+    check(internalPathToDistanceField(
+        this, fillType.ordinal, bitmap, range, type == DistanceFieldType.MultiChannel
+    )) {
+        "The pixels of the bitmap could not be written"
+    }
+
+    return bitmap
+}
+
+private external fun internalPathToDistanceField(
+    path: Path,
+    fillType: Int,
+    bitmap: Bitmap,
+    range: Float,
+    multiChannel: Boolean
+): Boolean
@@ -18,8 +18,47 @@ package dev.romainguy.graphics.path
 
 import android.graphics.Bitmap
 import android.graphics.Path
-import kotlin.math.max
-import kotlin.math.min
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * A row provider supplies the pixels of an image one row at a time. It can be used to extract
+ * contours from images that are not stored in a [Bitmap], or that are too large to fit in
+ * memory at once (tiled or decoded on demand images for instance).
+ */
+fun interface RowProvider {
+    /**
+     * Fills [row] with the colors of the row of pixels at index [y], in the ARGB format used
+     * by [Bitmap.getPixels]. The [row] array contains exactly as many entries as the width of
+     * the image. Rows are requested in order, from top to bottom.
+     */
+    fun getRow(y: Int, row: IntArray)
+}
+
+/**
+ * Algorithm used to extract the contours of an image.
+ */
+enum class TracingMethod {
+    /**
+     * Runs marching squares over the image, two rows of pixels at a time, and joins the
+     * segments produced by each cell into contours. The memory required is proportional to
+     * the width of the image.
+     */
+    MarchingSquares,
+
+    /**
+     * Scans the image once and follows each border as soon as it is found, which produces
+     * closed contours directly, in order, and their nesting for free. Straight borders
+     * produce a single segment. The contours describe the same shapes as the contours
+     * produced by [MarchingSquares], but start at different points, can be ordered
+     * differently, and contain fewer points. This is typically several times faster than
+     * [MarchingSquares], especially for images with long straight borders or when a
+     * [ContourTree] is requested, but the whole image is kept in memory, using 5 bytes
+     * per pixel.
+     */
+    BorderFollowing
+}
 
 /**
  * Extract the contours of this [Bitmap] as a [Path]. The contours are traced by following opaque
@@ -31,10 +70,18 @@ import kotlin.math.min
  * before they are collapsed. For instance, passing a [minAngle] of 45 means that the final path
  * will not contain adjacent segments with an angle greater than 45 degrees.
  *
+ * The pixels are read two rows at a time, directly from the bitmap when its configuration is
+ * [Bitmap.Config.ARGB_8888], [Bitmap.Config.ALPHA_8], [Bitmap.Config.RGBA_F16] or
+ * [Bitmap.Config.RGBA_1010102], which keeps the memory required to trace the contours
+ * proportional to the width of the bitmap. The alpha channel is compared to [alphaThreshold] in
+ * its own precision: half floats for [Bitmap.Config.RGBA_F16], and 2 bits for
+ * [Bitmap.Config.RGBA_1010102].
+ *
  * @param alphaThreshold Maximum alpha channel value a pixel might have before being considered
  * opaque. This value is between 0.0 and 1.0.
  * @param minAngle Minimum angle in degrees between two segments in the contour before they are
  * collapsed to simplify the final geometry.
+ * @param method Algorithm used to extract the contours, see [TracingMethod].
  *
  * @return A [Path] containing all the contours detected in this [Bitmap], separated by `moveTo`
  * commands inside the path.
@@ -42,6 +89,7 @@ import kotlin.math.min
 fun Bitmap.toPath(
     alphaThreshold: Float = 0.0f,
     minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
 ): Path {
     if (!hasAlpha()) {
         return Path().apply {
@@ -49,16 +97,7 @@ fun Bitmap.toPath(
         }
     }
 
-    val contours = toContourSet(alphaThreshold)
-
-    val path = Path()
-    val size = contours.size
-    for (i in 0 until size) {
-        val contour = if (minAngle < 1.0f) contours[i] else contours[i].simplify(minAngle)
-        contour.toPath(path)
-    }
-
-    return path
+    return toContours(alphaThreshold, minAngle, method).toPath()
 }
 
 /**
@@ -75,6 +114,7 @@ fun Bitmap.toPath(
  * opaque. This value is between 0.0 and 1.0.
  * @param minAngle Minimum angle in degrees between two segments in the contour before they are
  * collapsed to simplify the final geometry.
+ * @param method Algorithm used to extract the contours, see [TracingMethod].
  *
  * @return A list of [Path] containing all the contours detected in this [Bitmap] as separate
  * paths.
@@ -82,6 +122,7 @@ fun Bitmap.toPath(
 fun Bitmap.toPaths(
     alphaThreshold: Float = 0.0f,
     minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
 ): List<Path> {
     if (!hasAlpha()) {
         return listOf(
@@ -91,94 +132,209 @@ fun Bitmap.toPaths(
         )
     }
 
-    val contours = toContourSet(alphaThreshold)
-    val paths = mutableListOf<Path>()
+    return toContours(alphaThreshold, minAngle, method).toPaths()
+}
+
+/**
+ * Extract the contours of the image of size [width] by [height] whose pixels are supplied by this
+ * [RowProvider], as a [Path]. Unless [method] is [TracingMethod.BorderFollowing], only two rows
+ * of pixels are kept in memory at any given time. See [Bitmap.toPath] for a description of
+ * [alphaThreshold], [minAngle] and [method].
+ *
+ * @return A [Path] containing all the contours detected in the image, separated by `moveTo`
+ * commands inside the path.
+ */
+fun RowProvider.toPath(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
+): Path = toContours(width, height, alphaThreshold, minAngle, method).toPath()
+
+/**
+ * Extract the contours of the image of size [width] by [height] whose pixels are supplied by this
+ * [RowProvider], as a list of [Path]. Unless [method] is [TracingMethod.BorderFollowing], only
+ * two rows of pixels are kept in memory at any given time. See [Bitmap.toPaths] for a
+ * description of [alphaThreshold], [minAngle] and [method].
+ *
+ * @return A list of [Path] containing all the contours detected in the image as separate paths.
+ */
+fun RowProvider.toPaths(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
+): List<Path> = toContours(width, height, alphaThreshold, minAngle, method).toPaths()
 
-    val size = contours.size
-    for (i in 0 until size) {
-        val path = Path()
-        val contour = if (minAngle < 1.0f) contours[i] else contours[i].simplify(minAngle)
-        contour.toPath(path)
-        paths += path
+/**
+ * Extract the contours of this [Bitmap] as a [ContourTree], which describes how the contours
+ * are nested in each other: which contours are holes, and in which shapes. The contours are
+ * the same as the contours returned by [Bitmap.toPaths], in the same order. See
+ * [Bitmap.toPaths] for a description of [alphaThreshold], [minAngle] and [method]. With
+ * [TracingMethod.BorderFollowing], the nesting is found while tracing the contours.
+ */
+fun Bitmap.toContourTree(
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
+): ContourTree {
+    if (!hasAlpha()) {
+        val w = width.toFloat()
+        val h = height.toFloat()
+        return ContourTree(
+            TracedContours(
+                floatArrayOf(0.0f, 0.0f, 0.0f, h, w, h, w, 0.0f, 0.0f, 0.0f),
+                intArrayOf(0, 5),
+                intArrayOf(-1),
+                intArrayOf(0),
+                floatArrayOf(-w * h)
+            )
+        )
     }
 
-    return paths
+    return ContourTree(toContours(alphaThreshold, minAngle, method, true))
 }
 
-private fun Bitmap.toContourSet(alphaThreshold: Float): ContourSet {
-    val w = width
-    val h = height
-
-    val pixels = IntArray(w * h)
-    getPixels(pixels, 0, w, 0, 0, w, h)
-
-    // Increase threshold by 1 to make the branchless function sample() work
-    val threshold = (alphaThreshold * 255.0f + 1).toInt().coerceIn(0, 255)
-
-    val contours = ContourSet()
-
-    val xmax = (w - 1).toFloat()
-    val ymax = (h - 1).toFloat()
-
-    // Pretend we have a guard band to handle opaque pixels at the edges
-    for (y in -1 until h) {
-        val y0 = max(0.0f, y.toFloat())
-        val yM = (y + 0.5f).clamp(0.0f, ymax)
-        val y1 = min(ymax, y + 1.0f)
-
-        for (x in -1 until w) {
-            val x0 = max(0.0f, x.toFloat())
-            val xM = (x + 0.5f).clamp(0.0f, xmax)
-            val x1 = min(xmax, x + 1.0f)
-
-            val a = pixels.sample(w, h, x, y, threshold)
-            val b = pixels.sample(w, h, x + 1, y, threshold)
-            val c = pixels.sample(w, h, x, y + 1, threshold)
-            val d = pixels.sample(w, h, x + 1, y + 1, threshold)
-
-            when (quadKey(a, b, c, d)) {
-                // 0x0 -> fully transparent, skip
-                0x1 -> contours.addLine(x0, yM, xM, y0)
-                0x2 -> contours.addLine(xM, y0, x1, yM)
-                0x3 -> contours.addLine(x0, yM, x1, yM)
-                0x4 -> contours.addLine(xM, y1, x0, yM)
-                0x5 -> contours.addLine(xM, y1, xM, y0)
-                0x6 -> {
-                    contours.addLine(xM, y0, x1, yM)
-                    contours.addLine(x0, y1, x0, yM)
-                }
-                0x7 -> contours.addLine(xM, y1, x1, yM)
-                0x8 -> contours.addLine(x1, yM, xM, y1)
-                0x9 -> {
-                    contours.addLine(x0, yM, xM, y0)
-                    contours.addLine(x1, yM, xM, y1)
-                }
-                0xA -> contours.addLine(xM, y0, xM, y1)
-                0xB -> contours.addLine(x0, yM, xM, y1)
-                0xC -> contours.addLine(x1, yM, x0, yM)
-                0xD -> contours.addLine(x1, yM, xM, y0)
-                0xE -> contours.addLine(xM, y0, x0, yM)
-                // 0xF -> fully opaque, skip
+/**
+ * Extract the contours of the image of size [width] by [height] whose pixels are supplied by this
+ * [RowProvider], as a [ContourTree]. See [Bitmap.toContourTree].
+ */
+fun RowProvider.toContourTree(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float = 0.0f,
+    minAngle: Float = 15.0f,
+    method: TracingMethod = TracingMethod.MarchingSquares,
+): ContourTree = ContourTree(toContours(width, height, alphaThreshold, minAngle, method, true))
+
+/**
+ * Extract the contours of this [Bitmap] at several alpha thresholds at once, for instance to
+ * build outline, shadow and hit regions from the same image. The pixels of the bitmap are read
+ * and classified against all the thresholds in a single pass, which is faster than calling
+ * [Bitmap.toPath] once per threshold.
+ *
+ * @param alphaThresholds Alpha thresholds, sorted in ascending order, see [Bitmap.toPath].
+ * @param minAngle Minimum angle in degrees between two segments in the contour before they are
+ * collapsed to simplify the final geometry.
+ *
+ * @return A list containing one [Path] per threshold, in the same order as [alphaThresholds].
+ */
+fun Bitmap.toPathLevels(
+    alphaThresholds: FloatArray,
+    minAngle: Float = 15.0f,
+): List<Path> {
+    checkThresholds(alphaThresholds)
+
+    if (!hasAlpha()) {
+        return alphaThresholds.map {
+            Path().apply {
+                addRect(0.0f, 0.0f, width.toFloat(), height.toFloat(), Path.Direction.CCW)
             }
         }
     }
 
-    return contours
+    val levels = traceBitmapLevels(this, alphaThresholds, minAngle) ?: RowProvider { y, row ->
+        getPixels(row, 0, width, 0, y, width, 1)
+    }.toContourLevels(width, height, alphaThresholds, minAngle)
+    return levels.map { it.toPath() }
 }
 
-@Suppress("NOTHING_TO_INLINE")
-private inline fun IntArray.sample(w: Int, h: Int, x: Int, y: Int, threshold: Int) =
-    if (x < 0 || x >= w || y < 0 || y >= h)
-        0
-    else
-        (((this[y * w + x] ushr 24) - threshold) ushr 31) xor 1
-
-@Suppress("NOTHING_TO_INLINE")
-private inline fun quadKey(a: Int, b: Int, c: Int, d: Int) =
-    a or (b shl 1) or (c shl 2) or (d shl 3)
-
-private fun Float.clamp(minimumValue: Float, maximumValue: Float): Float {
-    if (this < minimumValue) return minimumValue
-    if (this > maximumValue) return maximumValue
-    return this
+/**
+ * Extract the contours of the image of size [width] by [height] whose pixels are supplied by this
+ * [RowProvider] at several alpha thresholds at once. See [Bitmap.toPathLevels].
+ *
+ * @return A list containing one [Path] per threshold, in the same order as [alphaThresholds].
+ */
+fun RowProvider.toPathLevels(
+    width: Int,
+    height: Int,
+    alphaThresholds: FloatArray,
+    minAngle: Float = 15.0f,
+): List<Path> {
+    checkThresholds(alphaThresholds)
+    return toContourLevels(width, height, alphaThresholds, minAngle).map { it.toPath() }
+}
+
+private fun checkThresholds(alphaThresholds: FloatArray) {
+    require(alphaThresholds.size in 1..255) {
+        "Between 1 and 255 thresholds must be specified: ${alphaThresholds.size}"
+    }
+    for (i in 1 until alphaThresholds.size) {
+        require(alphaThresholds[i - 1] <= alphaThresholds[i]) {
+            "The thresholds must be sorted in ascending order"
+        }
+    }
+}
+
+private fun Bitmap.toContours(
+    alphaThreshold: Float,
+    minAngle: Float,
+    method: TracingMethod,
+    hierarchy: Boolean = false
+): TracedContours {
+    // Bitmaps we cannot read directly are fetched one row at a time through getPixels()
+    return traceBitmap(this, alphaThreshold, minAngle, hierarchy, method.ordinal)
+        ?: RowProvider { y, row ->
+            getPixels(row, 0, width, 0, y, width, 1)
+        }.toContours(width, height, alphaThreshold, minAngle, method, hierarchy)
 }
+
+private fun RowProvider.toContours(
+    width: Int,
+    height: Int,
+    alphaThreshold: Float,
+    minAngle: Float,
+    method: TracingMethod,
+    hierarchy: Boolean = false
+): TracedContours {
+    require(width > 0 && height > 0) { "The image size must be > 0: $width*$height" }
+    // traceRows() only returns null if getRow() threw an exception, which is rethrown
+    // as soon as we return from the native call
+    return traceRows(this, width, height, alphaThreshold, minAngle, hierarchy, method.ordinal)
+        ?: TracedContours.Empty
+}
+
+private fun RowProvider.toContourLevels(
+    width: Int,
+    height: Int,
+    alphaThresholds: FloatArray,
+    minAngle: Float
+): Array<TracedContours> {
+    require(width > 0 && height > 0) { "The image size must be > 0: $width*$height" }
+    // See toContours()
+    return traceRowLevels(this, width, height, alphaThresholds, minAngle) ?: emptyArray()
+}
+
+private external fun traceBitmap(
+    bitmap: Bitmap,
+    alphaThreshold: Float,
+    minAngle: Float,
+    hierarchy: Boolean,
+    method: Int
+): TracedContours?
+
+private external fun traceRows(
+    provider: RowProvider,
+    width: Int,
+    height: Int,
+    alphaThreshold: Float,
+    minAngle: Float,
+    hierarchy: Boolean,
+    method: Int
+): TracedContours?
+
+private external fun traceBitmapLevels(
+    bitmap: Bitmap,
+    alphaThresholds: FloatArray,
+    minAngle: Float
+): Array<TracedContours>?
+
+private external fun traceRowLevels(
+    provider: RowProvider,
+    width: Int,
+    height: Int,
+    alphaThresholds: FloatArray,
+    minAngle: Float
+): Array<TracedContours>?
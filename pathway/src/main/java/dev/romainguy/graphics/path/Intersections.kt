@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Intersections")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * An intersection between two segments, found by [Path.intersections] or
+ * [Path.selfIntersections].
+ *
+ * Segments are identified by their index in the sequence of segments returned by
+ * `path.iterator(PathIterator.ConicEvaluation.AsConic)`, which includes move and close
+ * segments. A [close][PathSegment.Type.Close] segment is treated as the line that joins the
+ * last point of the contour to its first point.
+ *
+ * @property x The x coordinate of the intersection.
+ * @property y The y coordinate of the intersection.
+ * @property segment1 Index of the segment in the first path.
+ * @property t1 Parameter of the intersection on the segment of the first path, between 0 and 1.
+ * @property segment2 Index of the segment in the second path.
+ * @property t2 Parameter of the intersection on the segment of the second path, between 0 and 1.
+ */
+class PathIntersection internal constructor(
+    val x: Float,
+    val y: Float,
+    val segment1: Int,
+    val t1: Float,
+    val segment2: Int,
+    val t2: Float
+) {
+    override fun toString(): String {
+        return "PathIntersection(x=$x, y=$y, " +
+                "segment1=$segment1, t1=$t1, segment2=$segment2, t2=$t2)"
+    }
+}
+
+/**
+ * Intersections produced by the native intersector. The intersection `i` is made of the
+ * values `x, y, t1, t2` at `values[i * 4]` and of the segments at `segments[i * 2]`.
+ */
+internal class PackedIntersections(val values: FloatArray, val segments: IntArray) {
+    fun toList(): List<PathIntersection> {
+        val count = segments.size / 2
+        val list = ArrayList<PathIntersection>(count)
+        for (i in 0 until count) {
+            list += PathIntersection(
+                values[i * 4], values[i * 4 + 1],
+                segments[i * 2], values[i * 4 + 2],
+                segments[i * 2 + 1], values[i * 4 + 3]
+            )
+        }
+        return list
+    }
+}
+
+/**
+ * Finds the points where the segments of this path intersect the segments of [other]. The
+ * segments of this path are described by [PathIntersection.segment1] and
+ * [PathIntersection.t1], the segments of [other] by [PathIntersection.segment2] and
+ * [PathIntersection.t2]. Intersections are sorted by segment in this path, then by
+ * parameter along the segment.
+ *
+ * Segments are first split into parts monotonic in x and y. Candidate pairs of parts are
+ * found with a sweep over their bounds, then each pair is refined by subdivision until the
+ * parts are flat within [tolerance]. This scales to paths made of tens of thousands of
+ * segments. Segments that overlap report the end points of the overlap.
+ *
+ * @param other The path to intersect with this path.
+ * @param tolerance Maximum error of the intersections, in the coordinate space of the paths.
+ * Intersections closer than [tolerance] on adjacent segments are merged.
+ */
+fun Path.intersections(other: Path, tolerance: Float = 1e-3f): List<PathIntersection> {
+    require(tolerance > 0.0f) { "The tolerance must be greater than 0" }
+    return internalPathIntersections(this, other, tolerance).toList()
+}
+
+/**
+ * Finds the points where the segments of this path intersect each other, for instance to
+ * detect a self-intersecting outline. Adjacent segments are not considered to intersect at
+ * the point they share. For each intersection, [PathIntersection.segment1] is less than or
+ * equal to [PathIntersection.segment2], and both are equal when a curve intersects itself.
+ * See [Path.intersections] for more information.
+ *
+ * @param tolerance Maximum error of the intersections, in the coordinate space of the path.
+ */
+fun Path.selfIntersections(tolerance: Float = 1e-3f): List<PathIntersection> {
+    require(tolerance > 0.0f) { "The tolerance must be greater than 0" }
+    return internalPathIntersections(this, null, tolerance).toList()
+}
+
+private external fun internalPathIntersections(
+    path: Path,
+    other: Path?,
+    tolerance: Float
+): PackedIntersections
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Moments")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import kotlin.math.atan2
+import kotlin.math.sign
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Geometric moments of the contours of a path, computed by [Path.contourMoments]. The
+ * moments are stored in [values], [RecordSize] floats per contour, in the following order:
+ * signed area, x and y coordinates of the centroid, perimeter, and second moments about the
+ * centroid mu20, mu11 and mu02.
+ *
+ * The area and second moments are signed: they are positive for contours that are
+ * clockwise on screen, such as the contours added with [Path.Direction.CW], and negative
+ * otherwise. With the even-odd or non-zero fill rules, holes are usually the contours
+ * whose orientation is opposite to the orientation of the outer contours, and summing the
+ * moments of all the contours of a shape gives the moments of the filled shape.
+ */
+class ContourMoments internal constructor(val values: FloatArray) {
+    /** Number of contours. */
+    val size: Int
+        get() = values.size / RecordSize
+
+    /** Signed area of the [contour]. */
+    fun area(contour: Int) = values[contour * RecordSize]
+
+    /**
+     * X coordinate of the centroid of the area of the [contour]. For contours of area 0,
+     * the centroid of the outline.
+     */
+    fun centroidX(contour: Int) = values[contour * RecordSize + 1]
+
+    /**
+     * Y coordinate of the centroid of the area of the [contour]. For contours of area 0,
+     * the centroid of the outline.
+     */
+    fun centroidY(contour: Int) = values[contour * RecordSize + 2]
+
+    /**
+     * Length of the outline of the [contour]. The line that joins the last point to the
+     * first point is only included if the contour is closed.
+     */
+    fun perimeter(contour: Int) = values[contour * RecordSize + 3]
+
+    /** Integral over the area of the [contour] of `(x - cx)^2`, signed like the area. */
+    fun mu20(contour: Int) = values[contour * RecordSize + 4]
+
+    /** Integral over the area of the [contour] of `(x - cx) (y - cy)`, signed like the area. */
+    fun mu11(contour: Int) = values[contour * RecordSize + 5]
+
+    /** Integral over the area of the [contour] of `(y - cy)^2`, signed like the area. */
+    fun mu02(contour: Int) = values[contour * RecordSize + 6]
+
+    /** True if the [contour] is clockwise on screen. */
+    fun isClockwise(contour: Int) = area(contour) > 0.0f
+
+    /**
+     * Angle in degrees between the x axis and the major axis of the [contour], derived from
+     * its second moments, between -90 and 90 degrees. The result does not depend on the
+     * direction of the contour.
+     */
+    fun orientation(contour: Int): Float {
+        // The second moments are signed like the area, make them positive so that counter
+        // clockwise contours do not give the angle of their minor axis
+        val sign = sign(area(contour)).toDouble()
+        val angle = 0.5 * atan2(
+            2.0 * sign * mu11(contour),
+            sign * (mu20(contour) - mu02(contour))
+        )
+        return Math.toDegrees(angle).toFloat()
+    }
+
+    companion object {
+        /** Number of floats per contour in [values]. */
+        const val RecordSize = 7
+    }
+}
+
+/**
+ * Computes the signed area, centroid, perimeter and second moments of every contour of
+ * this path in a single native traversal of the path. Move segments start new contours,
+ * and open contours are implicitly closed for the area integrals, as they are when the
+ * path is filled. Contours without any segment are skipped.
+ *
+ * The area integrals are computed exactly for lines, quadratics and cubics, without
+ * flattening the curves, and to near float precision for conics. The perimeter is
+ * computed by adaptive integration of the arc length of the curves.
+ */
+fun Path.contourMoments(): ContourMoments = ContourMoments(internalPathMoments(this))
+
+private external fun internalPathMoments(path: Path): FloatArray
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Morph")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import dalvik.annotation.optimization.FastNative
+
+/**
+ * A path morph interpolates between two paths that share the same structure, for instance
+ * two states of an animated icon. The two paths are validated and matched segment by segment
+ * once, when the morph is created. Each call to [interpolate] afterwards only performs a
+ * linear interpolation of the packed points.
+ *
+ * Two paths are compatible if they contain the same sequence of segments. Conics are always
+ * converted to quadratics, using the same number of quadratics in both paths. When [normalize]
+ * is set to `true`, mismatched curves (a line in one path and a cubic in the other for
+ * instance) are raised to cubics, and subdivided if needed, to make the paths compatible.
+ *
+ * @param from The path returned by [interpolate] for a fraction of 0.0.
+ * @param to The path returned by [interpolate] for a fraction of 1.0.
+ * @param normalize Whether mismatched curves should be converted to cubics.
+ * @param tolerance Tolerance of the conic to quadratic conversion.
+ *
+ * @throws IllegalArgumentException if the two paths are not compatible.
+ */
+class PathMorph(
+    from: Path,
+    to: Path,
+    val normalize: Boolean = false,
+    val tolerance: Float = 0.25f
+) {
+    private companion object {
+        init {
+            System.loadLibrary("pathway")
+        }
+    }
+
+    private val internalPathMorph: Long =
+        createInternalPathMorph(from, to, normalize, tolerance)
+
+    init {
+        require(internalPathMorph != 0L) {
+            "The two paths are not compatible and cannot be interpolated"
+        }
+    }
+
+    private val verbs = ByteArray(internalPathMorphVerbCount(internalPathMorph)).apply {
+        internalPathMorphVerbs(internalPathMorph, this)
+    }
+
+    private val pointsData by lazy(LazyThreadSafetyMode.NONE) { FloatArray(size) }
+
+    /**
+     * Number of floats required to hold the points produced by [interpolate].
+     */
+    val size = internalPathMorphValueCount(internalPathMorph)
+
+    /**
+     * Returns the type of each segment of the interpolated path. The points of each segment
+     * are stored in the array returned by [interpolate] in the same order.
+     */
+    val types: List<PathSegment.Type>
+        get() = verbs.map { PathSegment.Type.entries[it.toInt()] }
+
+    /**
+     * Interpolates the points of the two paths at the specified [fraction] and stores the
+     * result in [points]. Each segment only stores the points it adds to the path, as a pair
+     * of floats per point:
+     *
+     * - [Move][PathSegment.Type.Move]: 1 pair
+     * - [Line][PathSegment.Type.Line]: 1 pair (end point)
+     * - [Quadratic][PathSegment.Type.Quadratic]: 2 pairs (control point and end point)
+     * - [Cubic][PathSegment.Type.Cubic]: 3 pairs (control points and end point)
+     * - [Close][PathSegment.Type.Close]: 0 pair
+     *
+     * This method does not allocate any memory.
+     *
+     * @param fraction The interpolation fraction, typically between 0.0 and 1.0.
+     * @param points A [FloatArray] large enough to hold [size] floats, throws an
+     *               [IllegalStateException] otherwise.
+     */
+    fun interpolate(fraction: Float, points: FloatArray = FloatArray(size)): FloatArray {
+        check(points.size >= size) { "The points array must contain at least $size floats" }
+        internalPathMorphInterpolate(internalPathMorph, fraction, points)
+        return points
+    }
+
+    /**
+     * Interpolates the two paths at the specified [fraction] and replaces the content of
+     * [path] with the result.
+     */
+    fun interpolate(fraction: Float, path: Path): Path {
+        val p = pointsData
+        internalPathMorphInterpolate(internalPathMorph, fraction, p)
+
+        path.rewind()
+
+        var index = 0
+        for (verb in verbs) {
+            when (verb.toInt()) {
+                MoveVerb -> {
+                    path.moveTo(p[index], p[index + 1])
+                    index += 2
+                }
+                LineVerb -> {
+                    path.lineTo(p[index], p[index + 1])
+                    index += 2
+                }
+                QuadraticVerb -> {
+                    path.quadTo(p[index], p[index + 1], p[index + 2], p[index + 3])
+                    index += 4
+                }
+                CubicVerb -> {
+                    path.cubicTo(
+                        p[index], p[index + 1],
+                        p[index + 2], p[index + 3],
+                        p[index + 4], p[index + 5]
+                    )
+                    index += 6
+                }
+                CloseVerb -> path.close()
+            }
+        }
+
+        return path
+    }
+
+    protected fun finalize() {
+        if (internalPathMorph != 0L) destroyInternalPathMorph(internalPathMorph)
+    }
+}
+
+private const val MoveVerb = 0
+private const val LineVerb = 1
+private const val QuadraticVerb = 2
+private const val CubicVerb = 4
+private const val CloseVerb = 5
+
+private external fun createInternalPathMorph(
+    from: Path, to: Path, normalize: Boolean, tolerance: Float
+): Long
+
+@FastNative
+private external fun destroyInternalPathMorph(internalPathMorph: Long)
+
+@FastNative
+private external fun internalPathMorphVerbCount(internalPathMorph: Long): Int
+
+@FastNative
+private external fun internalPathMorphValueCount(internalPathMorph: Long): Int
+
+@FastNative
+private external fun internalPathMorphVerbs(internalPathMorph: Long, verbs: ByteArray)
+
+@FastNative
+private external fun internalPathMorphInterpolate(
+    internalPathMorph: Long,
+    fraction: Float,
+    points: FloatArray
+)
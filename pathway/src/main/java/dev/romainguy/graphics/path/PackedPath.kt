@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+
+/**
+ * Path geometry packed in arrays, with the same layout as a [PathStorage]: one verb per
+ * segment in [verbs], the points of the segments in [points], and the weights of the conic
+ * segments in [conicWeights]. A packed path is created by [parseSvgPathData].
+ *
+ * @property verbs Verbs of the path, in order. The value of each verb is the ordinal of the
+ * matching [PathSegment.Type].
+ * @property points Points of the path as pairs of floats, in the order they are used by the
+ * verbs. Segments other than moves share their first point with the previous segment.
+ * @property conicWeights Weights of the conic segments, in the order the conics appear in
+ * the path.
+ * @property errorIndex Index of the first invalid character in the data the path was parsed
+ * from, or -1 if the data is valid. When the data is invalid, the path contains the segments
+ * found before the error.
+ */
+class PackedPath internal constructor(
+    val verbs: ByteArray,
+    val points: FloatArray,
+    val conicWeights: FloatArray,
+    val errorIndex: Int
+) {
+    /** Returns `true` if the data this path was parsed from is valid. */
+    val isValid: Boolean
+        get() = errorIndex < 0
+
+    /**
+     * Appends the segments of this packed path to [path], or to a new [Path] by default.
+     * Throws an [IllegalStateException] if this packed path contains conic segments, which
+     * cannot be added to a [Path].
+     */
+    fun toPath(path: Path = Path()): Path {
+        check(conicWeights.isEmpty()) { "Conic segments cannot be added to a Path" }
+
+        var i = 0
+        for (verb in verbs) {
+            when (PathSegment.Type.entries[verb.toInt()]) {
+                PathSegment.Type.Move -> {
+                    path.moveTo(points[i], points[i + 1])
+                    i += 2
+                }
+                PathSegment.Type.Line -> {
+                    path.lineTo(points[i], points[i + 1])
+                    i += 2
+                }
+                PathSegment.Type.Quadratic -> {
+                    path.quadTo(points[i], points[i + 1], points[i + 2], points[i + 3])
+                    i += 4
+                }
+                PathSegment.Type.Cubic -> {
+                    path.cubicTo(
+                        points[i], points[i + 1],
+                        points[i + 2], points[i + 3],
+                        points[i + 4], points[i + 5]
+                    )
+                    i += 6
+                }
+                PathSegment.Type.Close -> path.close()
+                else -> { }
+            }
+        }
+        return path
+    }
+}
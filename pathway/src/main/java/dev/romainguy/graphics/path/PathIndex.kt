@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Indexing")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import dalvik.annotation.optimization.FastNative
+
+/**
+ * A path index lets a [PathIterator] jump to any verb or contour of a path without
+ * iterating over the verbs before it, see [PathIterator.seek] and
+ * [PathIterator.seekToContour]. This is useful to page through very large paths, for
+ * instance to display their segments in a virtualized list.
+ *
+ * The index is built once, in a single pass over the verbs of the path. It records the
+ * position of the points of one verb every [interval] verbs, and the position of the first
+ * verb of every contour. Seeking to a contour is then done in constant time, and seeking to
+ * a verb requires stepping over at most [interval] verbs. Smaller intervals make seeking
+ * faster at the cost of more memory, 12 bytes per checkpoint.
+ *
+ * Verbs are identified by their index in the raw verbs of the path, between 0 and
+ * [verbCount], as returned by a [PathIterator] that does not convert conics or cubics.
+ *
+ * The index does not keep track of changes made to the path after its creation. It must be
+ * recreated when segments are added to or removed from the path.
+ *
+ * @param path The path to index.
+ * @param interval Number of verbs between two checkpoints, must be greater than 0.
+ */
+class PathIndex(val path: Path, val interval: Int = 64) {
+    private companion object {
+        init {
+            System.loadLibrary("pathway")
+        }
+    }
+
+    init {
+        require(interval > 0) { "The interval must be greater than 0" }
+    }
+
+    internal val internalPathIndex: Long = createInternalPathIndex(path, interval)
+
+    /**
+     * Number of raw verbs in the path when the index was created.
+     */
+    val verbCount = internalPathIndexVerbCount(internalPathIndex)
+
+    /**
+     * Number of contours in the path when the index was created. Each contour starts with
+     * a [Move][PathSegment.Type.Move] verb.
+     */
+    val contourCount = internalPathIndexContourCount(internalPathIndex)
+
+    /**
+     * Returns the index of the [Move][PathSegment.Type.Move] verb that starts the
+     * specified [contour].
+     */
+    fun contourStart(contour: Int): Int {
+        require(contour in 0 until contourCount) {
+            "The contour must be between 0 and ${contourCount - 1}, was $contour"
+        }
+        return internalPathIndexContourStart(internalPathIndex, contour)
+    }
+
+    /**
+     * Returns the index of the contour the specified [verb] belongs to, or -1 if the verb
+     * is before the first [Move][PathSegment.Type.Move] verb.
+     */
+    fun contourOf(verb: Int): Int {
+        require(verb in 0 until verbCount) {
+            "The verb must be between 0 and ${verbCount - 1}, was $verb"
+        }
+        return internalPathIndexContourOf(internalPathIndex, verb)
+    }
+
+    override fun toString(): String {
+        return "PathIndex(verbCount=$verbCount, contourCount=$contourCount, interval=$interval)"
+    }
+
+    protected fun finalize() {
+        destroyInternalPathIndex(internalPathIndex)
+    }
+}
+
+private external fun createInternalPathIndex(path: Path, interval: Int): Long
+
+@FastNative
+private external fun destroyInternalPathIndex(internalPathIndex: Long)
+
+@FastNative
+private external fun internalPathIndexVerbCount(internalPathIndex: Long): Int
+
+@FastNative
+private external fun internalPathIndexContourCount(internalPathIndex: Long): Int
+
+@FastNative
+private external fun internalPathIndexContourStart(internalPathIndex: Long, contour: Int): Int
+
+@FastNative
+private external fun internalPathIndexContourOf(internalPathIndex: Long, verb: Int): Int
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Storage")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Path
+import dalvik.annotation.optimization.FastNative
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+import java.nio.FloatBuffer
+
+/**
+ * Creates a [PathStorage] giving direct, read-only access to the verbs, points and conic
+ * weights stored by this [path][android.graphics.Path]. See [PathStorage] for the lifetime
+ * of the returned storage.
+ */
+fun Path.storage(validate: Boolean = false) = PathStorage(this, validate)
+
+/**
+ * A path storage exposes the memory used by a [Path] to store its segments as read-only
+ * direct [ByteBuffer], without copying it. This is useful to run analyses over very large
+ * paths, from Kotlin or from other native code, for instance with [cursor].
+ *
+ * **The buffers are only valid until [path] is modified.** Modifying the path, including
+ * by calling [Path.reset] or [Path.set], may move or free the underlying memory, after
+ * which reading the buffers returns unspecified values. When [validate] is true, [cursor]
+ * checks that the path was not modified before decoding each segment and throws an
+ * [IllegalStateException] otherwise. Since this check requires a JNI call per segment,
+ * it should only be enabled while debugging.
+ *
+ * @param path The path whose storage to expose.
+ * @param validate Enables the validation of the storage by [cursor].
+ */
+class PathStorage(val path: Path, val validate: Boolean = false) {
+    private companion object {
+        init {
+            System.loadLibrary("pathway")
+        }
+    }
+
+    /**
+     * Defines the order in which verbs are stored in [verbs].
+     */
+    enum class VerbDirection {
+        /**
+         * The first verb of the path is stored at index 0 (API 30+).
+         */
+        Forward,
+
+        /**
+         * The first verb of the path is stored at index [verbCount] - 1 (API < 30).
+         */
+        Backward
+    }
+
+    private val info = LongArray(StorageInfoCount)
+    private val buffers = createInternalPathStorage(path, info)
+
+    /**
+     * Verbs of the path, one byte per verb. The value of each verb is the ordinal of the
+     * matching [PathSegment.Type]. See [direction] for the order of the verbs.
+     */
+    val verbs: ByteBuffer = buffers[0].asReadOnlyBuffer()
+
+    /**
+     * Points of the path as pairs of floats in native byte order, in the order they are
+     * used by the verbs. Segments other than moves share their first point with the
+     * previous segment.
+     */
+    val points: ByteBuffer = buffers[1].asReadOnlyBuffer().order(ByteOrder.nativeOrder())
+
+    /**
+     * Weights of the conic segments of the path as floats in native byte order, in the
+     * order the conics appear in the path.
+     */
+    val conicWeights: ByteBuffer =
+        buffers[2].asReadOnlyBuffer().order(ByteOrder.nativeOrder())
+
+    /** Number of verbs in [verbs]. */
+    val verbCount: Int = info[StorageVerbCount].toInt()
+
+    /** Number of points, or pairs of floats, in [points]. */
+    val pointCount: Int = info[StoragePointCount].toInt()
+
+    /** Number of floats in [conicWeights]. */
+    val conicWeightCount: Int = info[StorageConicWeightCount].toInt()
+
+    /** Order in which the verbs are stored in [verbs]. */
+    val direction: VerbDirection = VerbDirection.entries[info[StorageDirection].toInt()]
+
+    /**
+     * Returns `true` if [path] was not modified since this storage was created, as far as
+     * can be detected. Modifications that keep the path's memory in place and do not
+     * change its number of verbs may not be detected.
+     */
+    fun isValid() = isInternalPathStorageValid(path, info)
+
+    /**
+     * Returns a new [PathCursor] to decode the segments of the path from this storage.
+     */
+    fun cursor() = PathCursor(this)
+}
+
+/**
+ * A path cursor decodes the segments of a path from its [PathStorage], without any JNI
+ * call (unless [PathStorage.validate] is set). Conic segments are returned as conics.
+ */
+class PathCursor internal constructor(val storage: PathStorage) {
+    private val verbs = storage.verbs
+    private val points: FloatBuffer = storage.points.asFloatBuffer()
+    private val conicWeights: FloatBuffer = storage.conicWeights.asFloatBuffer()
+    private val forward = storage.direction == PathStorage.VerbDirection.Forward
+
+    private var verbIndex = 0
+    private var pointIndex = 0
+    private var conicIndex = 0
+
+    /**
+     * Returns `true` if the iteration has more segments.
+     */
+    fun hasNext() = verbIndex < storage.verbCount
+
+    /**
+     * Returns the type of the current segment in the iteration, or [Done][PathSegment.Type.Done]
+     * if the iteration is finished.
+     */
+    fun peek(): PathSegment.Type {
+        if (!hasNext()) return PathSegment.Type.Done
+        return PathSegment.Type.entries[verb(verbIndex)]
+    }
+
+    /**
+     * Returns the [type][PathSegment.Type] of the next segment in the iteration and fills
+     * [points] with its points, as described in [PathIterator.next]. This method does not
+     * allocate any memory.
+     *
+     * @param points A [FloatArray] large enough to hold 8 floats starting at [offset],
+     *               throws an [IllegalStateException] otherwise.
+     * @param offset Offset in [points] where to store the result
+     */
+    fun next(points: FloatArray, offset: Int = 0): PathSegment.Type {
+        check(points.size - offset >= 8) { "The points array must contain at least 8 floats" }
+        if (!hasNext()) return PathSegment.Type.Done
+        if (storage.validate) {
+            check(storage.isValid()) { "The path was modified after its storage was created" }
+        }
+
+        val type = PathSegment.Type.entries[verb(verbIndex++)]
+        when (type) {
+            PathSegment.Type.Move -> {
+                copyPoints(pointIndex, points, offset, 1)
+                pointIndex += 1
+            }
+            PathSegment.Type.Line -> {
+                copyPoints(pointIndex - 1, points, offset, 2)
+                pointIndex += 1
+            }
+            PathSegment.Type.Quadratic -> {
+                copyPoints(pointIndex - 1, points, offset, 3)
+                pointIndex += 2
+            }
+            PathSegment.Type.Conic -> {
+                copyPoints(pointIndex - 1, points, offset, 3)
+                val weight = conicWeights.get(conicIndex++)
+                points[offset + 6] = weight
+                points[offset + 7] = weight
+                pointIndex += 2
+            }
+            PathSegment.Type.Cubic -> {
+                copyPoints(pointIndex - 1, points, offset, 4)
+                pointIndex += 3
+            }
+            else -> { }
+        }
+        return type
+    }
+
+    /**
+     * Restarts the iteration from the first segment.
+     */
+    fun reset() {
+        verbIndex = 0
+        pointIndex = 0
+        conicIndex = 0
+    }
+
+    private fun verb(index: Int): Int {
+        return verbs.get(if (forward) index else storage.verbCount - 1 - index).toInt()
+    }
+
+    private fun copyPoints(index: Int, dst: FloatArray, offset: Int, count: Int) {
+        val start = index * 2
+        for (i in 0 until count * 2) {
+            dst[offset + i] = points.get(start + i)
+        }
+    }
+}
+
+// Layout of the info array, must match PathStorageInfo in pathway.cpp
+private const val StorageVerbCount = 0
+private const val StoragePointCount = 1
+private const val StorageConicWeightCount = 2
+private const val StorageDirection = 3
+private const val StorageInfoCount = 8
+
+private external fun createInternalPathStorage(path: Path, info: LongArray): Array<ByteBuffer>
+
+@FastNative
+private external fun isInternalPathStorageValid(path: Path, info: LongArray): Boolean
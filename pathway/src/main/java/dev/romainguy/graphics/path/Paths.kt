@@ -138,20 +138,52 @@ operator fun Path.iterator() = PathIterator(this)
 /**
  * Creates a new [PathIterator] for this [path][android.graphics.Path].
  */
-fun Path.iterator(conicEvaluation: PathIterator.ConicEvaluation, tolerance: Float = 0.25f) =
-    PathIterator(this, conicEvaluation, tolerance)
+fun Path.iterator(
+    conicEvaluation: PathIterator.ConicEvaluation,
+    tolerance: Float = 0.25f,
+    cubicEvaluation: PathIterator.CubicEvaluation = PathIterator.CubicEvaluation.AsCubic,
+    cleanup: Boolean = false,
+    monotonic: Boolean = false
+) = PathIterator(this, conicEvaluation, tolerance, cubicEvaluation, cleanup, monotonic)
 
 /**
  * A path iterator can be used to iterate over all the [segments][PathSegment] that make up
  * a path. Those segments may in turn define multiple contours inside the path. Conic segments
  * are by default evaluated as approximated quadratic segments, to preserve conic segments set
- * [conicEvaluation] to [AsConic][ConicEvaluation.AsConic]. The error of the approximation
- * is controlled by [tolerance].
+ * [conicEvaluation] to [AsConic][ConicEvaluation.AsConic], or to approximate them with cubic
+ * segments set it to [AsCubics][ConicEvaluation.AsCubics]. Cubic segments are returned as
+ * cubics unless [cubicEvaluation] is set to [AsQuadratics][CubicEvaluation.AsQuadratics].
+ * The error of the approximations is controlled by [tolerance].
+ *
+ * When [cleanup] is set to `true`, the iterator removes the segments that do not
+ * contribute to the shape of the path while it iterates, without allocating memory:
+ *
+ * - Lines of length 0 are skipped.
+ * - Quadratics, conics and cubics whose control points are all within [tolerance] of the
+ *   line joining their end points are returned as that line, or skipped if their end points
+ *   are identical.
+ * - Runs of consecutive lines whose points all lie within [tolerance] of the line joining
+ *   the start of the run to its end are returned as that single line. Runs do not extend
+ *   past move and close segments, or past curves.
+ *
+ * Move and close segments are always returned, which preserves the contours of the path.
+ * [size] and [peek] take the cleanup into account.
+ *
+ * When [monotonic] is set to `true`, quadratics, conics and cubics are split at the
+ * extrema of their x and y coordinates, found by solving for the roots of their
+ * derivatives, so that every segment returned by the iterator is monotonic in both x and
+ * y, as required by scanline rasterizers, winding number computations and sweep
+ * algorithms. Conics split this way remain conics, with their own weights. Curves produced
+ * by the conversion of conics and cubics are split as well, and cleanup is applied after
+ * the split. The split does not allocate memory.
  */
 class PathIterator(
     val path: Path,
     val conicEvaluation: ConicEvaluation = ConicEvaluation.AsQuadratics,
-    val tolerance: Float = 0.25f
+    val tolerance: Float = 0.25f,
+    val cubicEvaluation: CubicEvaluation = CubicEvaluation.AsCubic,
+    val cleanup: Boolean = false,
+    val monotonic: Boolean = false
 ) : Iterator<PathSegment> {
     private companion object {
         init {
@@ -172,25 +204,56 @@ class PathIterator(
          * Conic segments are returned as quadratic approximations. The quality of the
          * approximation is defined by a tolerance value.
          */
+        AsQuadratics,
+
+        /**
+         * Conic segments are returned as cubic approximations. The quality of the
+         * approximation is defined by a tolerance value. Cubics approximate conics much
+         * more closely than quadratics, and this mode produces far fewer segments than
+         * [AsQuadratics] for the same tolerance.
+         */
+        AsCubics
+    }
+
+    /**
+     * Defines the type of evaluation to apply to cubic segments during iteration.
+     */
+    enum class CubicEvaluation {
+        /**
+         * Cubic segments are returned as cubic segments.
+         */
+        AsCubic,
+
+        /**
+         * Cubic segments are returned as quadratic approximations, for consumers that only
+         * support quadratic curves (font formats, some GPU renderers, etc.). The number of
+         * quadratics is derived from the third derivative of each cubic so that the error
+         * of the approximation stays under the tolerance value. Cubics produced by
+         * [ConicEvaluation.AsCubics] are not converted.
+         */
         AsQuadratics
     }
 
     private val pointsData = FloatArray(8) // 4 points max -> 8 floats
     private val internalPathIterator: Long =
-        createInternalPathIterator(path, conicEvaluation.ordinal, tolerance)
+        createInternalPathIterator(
+            path, conicEvaluation.ordinal, tolerance, cubicEvaluation.ordinal, cleanup, monotonic
+        )
 
     /**
      * Returns the number of verbs present in this iterator, i.e. the number of calls to
      * [next] required to complete the iteration. If the [conicEvaluation] property is set
-     * to [ConicEvaluation.AsQuadratics], computing the number of verbs requires a full
-     * iteration and conversion of any existing conics in the path. For a faster approximate
+     * to [ConicEvaluation.AsQuadratics] or [ConicEvaluation.AsCubics], or if [cubicEvaluation]
+     * is set to [CubicEvaluation.AsQuadratics], computing the number of verbs requires a full
+     * iteration over the path, as do [cleanup] and [monotonic]. For a faster approximate
      * size, use [rawSize] instead.
      */
     fun size() = internalPathIteratorSize(internalPathIterator)
 
     /**
      * Returns the raw number of verbs present in this iterator's path. If the [conicEvaluation]
-     * property is set to [ConicEvaluation.AsQuadratics], the returned size might be smaller
+     * property is not [ConicEvaluation.AsConic], or if [cubicEvaluation] is not
+     * [CubicEvaluation.AsCubic], the returned size might be smaller
      * than the number of calls to [next] required to fully iterate over the path. An accurate
      * size can be computed by calling [size] instead, at a performance cost.
      */
@@ -234,6 +297,17 @@ class PathIterator(
         return PathSegment.Type.entries[typeValue]
     }
 
+    /**
+     * Stores the types of the next segments in [types], and their points in [points] with
+     * the layout described in [next], 8 floats per segment. Returns the number of segments,
+     * at most `types.size`, or 0 if the iteration is finished. [points] must hold at least
+     * 8 floats per entry in [types].
+     */
+    internal fun next(types: ByteArray, points: FloatArray): Int {
+        check(points.size >= types.size * 8) { "The points array must hold 8 floats per type" }
+        return internalPathIteratorNextBatch(internalPathIterator, types, points)
+    }
+
     /**
      * Returns the next [path segment][PathSegment] in the iteration, or [DoneSegment] if
      * the iteration is finished. If no allocation is desirable, please use the alternative
@@ -284,13 +358,57 @@ class PathIterator(
         return PathSegment(type, points, weight)
     }
 
+    /**
+     * Moves this iterator to the specified raw [verb] of its path, using an [index] of the
+     * path, so that the next call to [next] returns the segment of that verb. A [verb] equal
+     * to [PathIndex.verbCount] moves the iterator to the end of the path. If the verb is a
+     * conic or cubic converted by this iterator, [next] returns the first segment of the
+     * conversion, and the pending segments of the previous conversion are discarded.
+     *
+     * Seeking steps over at most [PathIndex.interval] verbs and does not allocate any
+     * memory.
+     *
+     * @param index An index of [path], created after the last change to the segments of
+     *              the path.
+     * @param verb Index of the raw verb to move to, between 0 and [PathIndex.verbCount].
+     */
+    fun seek(index: PathIndex, verb: Int) {
+        checkIndex(index)
+        require(verb in 0..index.verbCount) {
+            "The verb must be between 0 and ${index.verbCount}, was $verb"
+        }
+        internalPathIteratorSeek(internalPathIterator, index.internalPathIndex, verb)
+    }
+
+    /**
+     * Moves this iterator to the [Move][PathSegment.Type.Move] verb that starts the
+     * specified [contour], in constant time. See [seek] for more information.
+     */
+    fun seekToContour(index: PathIndex, contour: Int) {
+        checkIndex(index)
+        require(contour in 0 until index.contourCount) {
+            "The contour must be between 0 and ${index.contourCount - 1}, was $contour"
+        }
+        internalPathIteratorSeekContour(internalPathIterator, index.internalPathIndex, contour)
+    }
+
+    private fun checkIndex(index: PathIndex) {
+        require(index.path === path) { "The index was not created for the path of this iterator" }
+        require(index.verbCount == rawSize()) { "The index is out of date, the path has changed" }
+    }
+
     protected fun finalize() {
         destroyInternalPathIterator(internalPathIterator)
     }
 }
 
 private external fun createInternalPathIterator(
-    path: Path, conicEvaluation: Int, tolerance: Float
+    path: Path,
+    conicEvaluation: Int,
+    tolerance: Float,
+    cubicEvaluation: Int,
+    cleanup: Boolean,
+    monotonic: Boolean
 ): Long
 
 @FastNative
@@ -306,6 +424,27 @@ private external fun internalPathIteratorNext(
     offset: Int
 ): Int
 
+@FastNative
+private external fun internalPathIteratorNextBatch(
+    internalPathIterator: Long,
+    types: ByteArray,
+    points: FloatArray
+): Int
+
+@FastNative
+private external fun internalPathIteratorSeek(
+    internalPathIterator: Long,
+    internalPathIndex: Long,
+    verb: Int
+)
+
+@FastNative
+private external fun internalPathIteratorSeekContour(
+    internalPathIterator: Long,
+    internalPathIndex: Long,
+    contour: Int
+)
+
 @FastNative
 private external fun internalPathIteratorPeek(internalPathIterator: Long): Int
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Rasterizer")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Path
+
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Renders the coverage of this path, filled with its fill type, in a new
+ * [Bitmap.Config.ALPHA_8] bitmap of size [width] by [height]. See the overload that takes
+ * a [Bitmap] for more information.
+ */
+fun Path.toAlphaMask(width: Int, height: Int, tolerance: Float = 0.25f): Bitmap {
+    return toAlphaMask(Bitmap.createBitmap(width, height, Bitmap.Config.ALPHA_8), tolerance)
+}
+
+/**
+ * Renders the coverage of this path, filled with its fill type, in [bitmap]. The bitmap
+ * must be mutable and its configuration must be [Bitmap.Config.ALPHA_8]. Every pixel of
+ * the bitmap is written.
+ *
+ * The pixel at (x, y) receives the exact fraction of the area (x, y, x + 1, y + 1) covered
+ * by the path, computed analytically instead of by sampling, which gives anti-aliasing
+ * equivalent to an infinite number of samples per pixel. Curves are first approximated
+ * with lines within [tolerance]. Only pixels where the outline crosses itself are
+ * approximated. This is typically much faster than drawing the path with a software
+ * [android.graphics.Canvas], and can be called from any thread. Transform the path before
+ * calling this method to choose the area and scale of the mask.
+ *
+ * @param bitmap The bitmap to write the coverage to.
+ * @param tolerance Maximum distance in pixels between the curves and the lines
+ * approximating them.
+ *
+ * @return The [bitmap] passed as a parameter.
+ */
+fun Path.toAlphaMask(bitmap: Bitmap, tolerance: Float = 0.25f): Bitmap {
+    require(bitmap.isMutable) { "The bitmap must be mutable" }
+    require(bitmap.config == Bitmap.Config.ALPHA_8) { "The bitmap must be ALPHA_8" }
+
+    check(internalPathToAlphaMask(this, fillType.ordinal, bitmap, tolerance)) {
+        "The pixels of the bitmap could not be written"
+    }
+
+    return bitmap
+}
+
+/**
+ * Renders the coverage of this path, filled with its fill type, in [pixels], a buffer of
+ * 8 bit coverage values. The pixel at (x, y) is stored at the index `y * stride + x`. See
+ * the overload that takes a [Bitmap] for more information.
+ *
+ * @param pixels The array to write the coverage to, of at least
+ * `(height - 1) * stride + width` entries.
+ * @param width Width of the mask in pixels.
+ * @param height Height of the mask in pixels.
+ * @param stride Number of entries between the start of two rows, `width` by default.
+ * @param tolerance Maximum distance in pixels between the curves and the lines
+ * approximating them.
+ *
+ * @return The [pixels] array passed as a parameter.
+ */
+fun Path.toAlphaMask(
+    pixels: ByteArray,
+    width: Int,
+    height: Int,
+    stride: Int = width,
+    tolerance: Float = 0.25f
+): ByteArray {
+    require(width >= 0 && height >= 0) { "The size of the mask cannot be negative" }
+    require(stride >= width) { "The stride must be greater than or equal to the width" }
+    require(height == 0 || (height - 1).toLong() * stride + width <= pixels.size) {
+        "The array is too small for a ${width}x$height mask with a stride of $stride"
+    }
+
+    if (width > 0 && height > 0) {
+        internalPathToAlphaMaskArray(
+            this, fillType.ordinal, pixels, width, height, stride, tolerance
+        )
+    }
+
+    return pixels
+}
+
+private external fun internalPathToAlphaMask(
+    path: Path,
+    fillType: Int,
+    bitmap: Bitmap,
+    tolerance: Float
+): Boolean
+
+private external fun internalPathToAlphaMaskArray(
+    path: Path,
+    fillType: Int,
+    pixels: ByteArray,
+    width: Int,
+    height: Int,
+    stride: Int,
+    tolerance: Float
+)
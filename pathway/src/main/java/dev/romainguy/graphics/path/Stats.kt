@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Stats")
+
+package dev.romainguy.graphics.path
+
+import dalvik.annotation.optimization.FastNative
+
+/**
+ * Performance counters of the native code of the library. The counters are disabled by
+ * default, and only count work performed while [enabled] is true. They are shared by all
+ * the threads of the process and are not reset when they are disabled.
+ *
+ * The native hot paths also emit trace sections (`pathway::traceBitmap` for instance),
+ * visible in system traces captured with Perfetto or systrace on API 23 and above.
+ *
+ * Counters and trace sections can be removed entirely from the native library by
+ * building it with the CMake option `PATHWAY_STATS` set to `OFF`, in which case
+ * [isAvailable] returns false.
+ */
+object PathwayStats {
+    init {
+        System.loadLibrary("pathway")
+    }
+
+    /**
+     * Indicates whether the native library was built with support for performance
+     * counters.
+     */
+    val isAvailable: Boolean
+        get() = statsAvailable()
+
+    /**
+     * Enables or disables the performance counters. Has no effect if [isAvailable]
+     * is false.
+     */
+    var enabled: Boolean
+        get() = statsIsEnabled()
+        set(value) = statsSetEnabled(value)
+
+    /**
+     * Returns the current value of all the counters.
+     */
+    fun snapshot(): StatsSnapshot {
+        val values = LongArray(StatCount)
+        statsSnapshot(values)
+        return StatsSnapshot(values)
+    }
+
+    /**
+     * Sets all the counters to 0.
+     */
+    fun reset() = statsReset()
+}
+
+/**
+ * Values of the performance counters at the time [PathwayStats.snapshot] was invoked.
+ * Durations are expressed in nanoseconds.
+ */
+class StatsSnapshot internal constructor(private val values: LongArray) {
+    /** Number of segments returned by path iterators. */
+    val segmentsIterated: Long get() = values[0]
+
+    /** Number of conics converted to quadratics or cubics. */
+    val conicsConverted: Long get() = values[1]
+
+    /** Number of quadratics produced by the conversion of conics. */
+    val quadraticsFromConics: Long get() = values[2]
+
+    /**
+     * Distribution of the number of quadratics produced per conic. The entry at index `i`
+     * is the number of conics converted into `2^i` quadratics, from 1 to 32 quadratics.
+     */
+    val quadraticsPerConic: LongArray get() = values.copyOfRange(3, 9)
+
+    /** Number of bitmaps, or images provided by a [RowProvider], traced. */
+    val bitmapsTraced: Long get() = values[9]
+
+    /** Time spent reading and classifying pixels when tracing bitmaps. */
+    val traceReadNanos: Long get() = values[10]
+
+    /** Time spent running marching squares when tracing bitmaps. */
+    val traceMarchNanos: Long get() = values[11]
+
+    /** Time spent assembling contours when tracing bitmaps. */
+    val traceBuildNanos: Long get() = values[12]
+
+    /** Time spent simplifying contours and copying them to the Java heap. */
+    val traceOutputNanos: Long get() = values[13]
+
+    /** Number of cubics produced by the conversion of conics. */
+    val cubicsFromConics: Long get() = values[14]
+
+    /** Number of cubics converted to quadratics. */
+    val cubicsConverted: Long get() = values[15]
+
+    /** Number of quadratics produced by the conversion of cubics. */
+    val quadraticsFromCubics: Long get() = values[16]
+
+    /**
+     * Number of segments removed, or merged with other segments, by path iterators
+     * created with `cleanup` set to `true`.
+     */
+    val segmentsDropped: Long get() = values[17]
+
+    /**
+     * Number of curves split at their extrema by path iterators created with `monotonic`
+     * set to `true`.
+     */
+    val monotonicSplits: Long get() = values[18]
+
+    /**
+     * Time spent following borders when tracing bitmaps with
+     * [TracingMethod.BorderFollowing].
+     */
+    val traceFollowNanos: Long get() = values[19]
+
+    override fun toString(): String {
+        return "StatsSnapshot(segmentsIterated=$segmentsIterated, " +
+            "conicsConverted=$conicsConverted, " +
+            "quadraticsFromConics=$quadraticsFromConics, " +
+            "quadraticsPerConic=${quadraticsPerConic.contentToString()}, " +
+            "cubicsFromConics=$cubicsFromConics, " +
+            "cubicsConverted=$cubicsConverted, " +
+            "quadraticsFromCubics=$quadraticsFromCubics, " +
+            "segmentsDropped=$segmentsDropped, " +
+            "monotonicSplits=$monotonicSplits, " +
+            "bitmapsTraced=$bitmapsTraced, " +
+            "traceReadNanos=$traceReadNanos, " +
+            "traceMarchNanos=$traceMarchNanos, " +
+            "traceBuildNanos=$traceBuildNanos, " +
+            "traceFollowNanos=$traceFollowNanos, " +
+            "traceOutputNanos=$traceOutputNanos)"
+    }
+}
+
+// Must match Stat::Count in Stats.h
+private const val StatCount = 20
+
+@FastNative
+private external fun statsAvailable(): Boolean
+
+@FastNative
+private external fun statsIsEnabled(): Boolean
+
+@FastNative
+private external fun statsSetEnabled(enabled: Boolean)
+
+@FastNative
+private external fun statsReset()
+
+@FastNative
+private external fun statsSnapshot(values: LongArray)
@@ -21,63 +21,190 @@ package dev.romainguy.graphics.path
 import android.graphics.Path
 import android.graphics.RectF
 import dev.romainguy.graphics.path.PathSegment.Type
+import java.io.FileDescriptor
+import java.io.FileOutputStream
+import java.io.OutputStream
 
-fun Path.toSvg(document: Boolean = true) = buildString {
+@Suppress("unused")
+private val nativeLibrary = System.loadLibrary("pathway")
+
+/**
+ * Converts this path to SVG. When [document] is true, the result is a complete SVG document,
+ * otherwise it only contains the path data, suitable for the `d` attribute of an SVG `path`
+ * element. SVG does not support conic segments, they are approximated as defined by
+ * [conicEvaluation] and [tolerance]. [AsCubics][PathIterator.ConicEvaluation.AsCubics]
+ * produces much fewer segments than the default, at the same tolerance.
+ *
+ * To write very large paths to a file or a stream without holding the entire document in
+ * memory, use one of the overloads that take an output.
+ */
+fun Path.toSvg(
+    document: Boolean = true,
+    conicEvaluation: PathIterator.ConicEvaluation = PathIterator.ConicEvaluation.AsQuadratics,
+    tolerance: Float = 0.25f
+) = buildString { toSvg(this, document, conicEvaluation, tolerance) }
+
+/**
+ * Converts this path to SVG, see [Path.toSvg], and appends the result to [output] as it is
+ * produced. The segments of the path are read in batches, which keeps the memory required
+ * by the conversion constant regardless of the size of the path.
+ */
+fun Path.toSvg(
+    output: Appendable,
+    document: Boolean = true,
+    conicEvaluation: PathIterator.ConicEvaluation = PathIterator.ConicEvaluation.AsQuadratics,
+    tolerance: Float = 0.25f
+) {
     val bounds = RectF()
     this@toSvg.computeBounds(bounds, true)
 
     if (document) {
-        append("""<svg xmlns="http://www.w3.org/2000/svg" """)
-        appendLine("""viewBox="${bounds.left} ${bounds.top} ${bounds.width()} ${bounds.height()}">""")
+        output.append("""<svg xmlns="http://www.w3.org/2000/svg" """)
+        output.appendLine(
+            """viewBox="${bounds.left} ${bounds.top} ${bounds.width()} ${bounds.height()}">"""
+        )
     }
 
-    val iterator = this@toSvg.iterator()
-    val points = FloatArray(8)
+    require(conicEvaluation != PathIterator.ConicEvaluation.AsConic) {
+        "SVG does not support conic segments"
+    }
+    val iterator = this@toSvg.iterator(conicEvaluation, tolerance)
+    val types = ByteArray(SvgBatchSize)
+    val points = FloatArray(SvgBatchSize * 8)
     var lastType = Type.Done
 
     if (iterator.hasNext()) {
         if (document) {
             if (this@toSvg.fillType == Path.FillType.EVEN_ODD) {
-                append("""  <path fill-rule="evenodd" d="""")
+                output.append("""  <path fill-rule="evenodd" d="""")
             } else {
-                append("""  <path d="""")
+                output.append("""  <path d="""")
             }
         }
 
-        while (iterator.hasNext()) {
-            val type = iterator.next(points)
-            when (type) {
-                Type.Move -> {
-                    append("${command(Type.Move, lastType)}${points[0]} ${points[1]}")
-                }
-                Type.Line -> {
-                    append("${command(Type.Line, lastType)}${points[2]} ${points[3]}")
-                }
-                Type.Quadratic -> {
-                    append(command(Type.Quadratic, lastType))
-                    append("${points[2]} ${points[3]} ${points[4]} ${points[5]}")
-                }
-                Type.Conic -> continue // We convert conics to quadratics
-                Type.Cubic -> {
-                    append(command(Type.Cubic, lastType))
-                    append("${points[2]} ${points[3]} ")
-                    append("${points[4]} ${points[5]} ")
-                    append("${points[6]} ${points[7]}")
-                }
-                Type.Close -> {
-                    append(command(Type.Close, lastType))
+        while (true) {
+            val count = iterator.next(types, points)
+            if (count == 0) break
+
+            for (i in 0 until count) {
+                val type = Type.entries[types[i].toInt()]
+                val p = i * 8
+                when (type) {
+                    Type.Move -> {
+                        output.append(command(Type.Move, lastType))
+                        output.appendPoints(points, p, 1)
+                    }
+                    Type.Line -> {
+                        output.append(command(Type.Line, lastType))
+                        output.appendPoints(points, p + 2, 1)
+                    }
+                    Type.Quadratic -> {
+                        output.append(command(Type.Quadratic, lastType))
+                        output.appendPoints(points, p + 2, 2)
+                    }
+                    Type.Conic -> continue // We convert conics to quadratics or cubics
+                    Type.Cubic -> {
+                        output.append(command(Type.Cubic, lastType))
+                        output.appendPoints(points, p + 2, 3)
+                    }
+                    Type.Close -> {
+                        output.append(command(Type.Close, lastType))
+                    }
+                    Type.Done -> continue // Won't happen inside this loop
                 }
-                Type.Done -> continue // Won't happen inside this loop
+                lastType = type
             }
-            lastType = type
         }
 
         if (document) {
-            appendLine(""""/>""")
+            output.appendLine(""""/>""")
         }
     }
     if (document) {
-        appendLine("""</svg>""")
+        output.appendLine("""</svg>""")
+    }
+}
+
+/**
+ * Converts this path to SVG, see [Path.toSvg], and writes the result to [output] as it is
+ * produced, encoded in UTF-8. The data is written in chunks of a fixed size, and [output]
+ * is flushed but not closed.
+ */
+fun Path.toSvg(
+    output: OutputStream,
+    document: Boolean = true,
+    conicEvaluation: PathIterator.ConicEvaluation = PathIterator.ConicEvaluation.AsQuadratics,
+    tolerance: Float = 0.25f
+) {
+    val writer = AsciiWriter(output)
+    toSvg(writer, document, conicEvaluation, tolerance)
+    writer.flush()
+}
+
+/**
+ * Converts this path to SVG, see [Path.toSvg], and writes the result to the file or socket
+ * referred to by [output] as it is produced. The file descriptor is not closed.
+ */
+fun Path.toSvg(
+    output: FileDescriptor,
+    document: Boolean = true,
+    conicEvaluation: PathIterator.ConicEvaluation = PathIterator.ConicEvaluation.AsQuadratics,
+    tolerance: Float = 0.25f
+) = toSvg(FileOutputStream(output), document, conicEvaluation, tolerance)
+
+/**
+ * Parses SVG path data, as found in the `d` attribute of an SVG `path` element, into a
+ * [PackedPath]. This is the inverse of [Path.toSvg] with `document` set to false. The
+ * complete path data grammar is supported, including relative commands, shorthand curves
+ * and elliptical arcs. The data is parsed natively in a single pass, which is much faster
+ * than building a [Path] with `PathParser`.
+ *
+ * Elliptical arcs are converted to conics, at most one per quarter of ellipse. Conics are
+ * kept as such with [AsConic][PathIterator.ConicEvaluation.AsConic], or approximated as
+ * defined by [conicEvaluation] and [tolerance] otherwise.
+ *
+ * Invalid data does not throw, the returned path contains the segments found before the
+ * first error, whose position is given by [PackedPath.errorIndex].
+ */
+fun parseSvgPathData(
+    pathData: String,
+    conicEvaluation: PathIterator.ConicEvaluation = PathIterator.ConicEvaluation.AsQuadratics,
+    tolerance: Float = 0.25f
+): PackedPath = parseInternalSvgPathData(pathData, conicEvaluation.ordinal, tolerance)
+
+// Number of segments read from the path iterator at once
+private const val SvgBatchSize = 64
+
+private fun Appendable.appendPoints(points: FloatArray, offset: Int, count: Int) {
+    for (i in 0 until count * 2) {
+        if (i > 0) append(' ')
+        append(points[offset + i].toString())
+    }
+}
+
+// Buffers the characters of the SVG output, which are all ASCII, before writing them
+private class AsciiWriter(private val output: OutputStream) : Appendable {
+    private val buffer = ByteArray(8192)
+    private var size = 0
+
+    override fun append(c: Char): Appendable {
+        if (size == buffer.size) flush()
+        buffer[size++] = c.code.toByte()
+        return this
+    }
+
+    override fun append(csq: CharSequence?): Appendable = append(csq, 0, csq?.length ?: 4)
+
+    override fun append(csq: CharSequence?, start: Int, end: Int): Appendable {
+        val s = csq ?: "null"
+        for (i in start until end) append(s[i])
+        return this
+    }
+
+    fun flush() {
+        output.write(buffer, 0, size)
+        output.flush()
+        size = 0
     }
 }
 
@@ -92,3 +219,9 @@ private fun command(type: Type, lastType: Type) =
             else -> ""
         }
     } else " "
+
+private external fun parseInternalSvgPathData(
+    pathData: String,
+    conicEvaluation: Int,
+    tolerance: Float
+): PackedPath
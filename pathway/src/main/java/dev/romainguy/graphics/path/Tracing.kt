@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2026 Romain Guy
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+@file:JvmName("Tracing")
+
+package dev.romainguy.graphics.path
+
+import android.graphics.Bitmap
+import android.graphics.Path
+import android.graphics.Rect
+import dalvik.annotation.optimization.FastNative
+
+/**
+ * A tracing session extracts the contours of a [Bitmap] that changes over time, for instance
+ * a bitmap modified by a drawing or erasing tool. The bitmap is split in square tiles of
+ * [tileSize] pixels, and the contours found in each tile are kept by the session. When a
+ * region of the bitmap changes, [update] only traces the tiles intersecting that region
+ * again, and stitches the pieces of contours back together.
+ *
+ * The contours produced by a session describe the same shapes as the contours produced by
+ * [Bitmap.toPath] and [Bitmap.toPaths], but they may be ordered differently or start at
+ * different points.
+ *
+ * @param bitmap The bitmap to trace, its configuration must be [Bitmap.Config.ARGB_8888].
+ * @param alphaThreshold Maximum alpha channel value a pixel might have before being considered
+ * opaque. This value is between 0.0 and 1.0.
+ * @param minAngle Minimum angle in degrees between two segments in the contour before they are
+ * collapsed to simplify the final geometry.
+ * @param tileSize Size in pixels of the tiles the bitmap is split into. Smaller tiles make
+ * small updates faster, but increase the cost of stitching the contours.
+ */
+class TracingSession(
+    val bitmap: Bitmap,
+    val alphaThreshold: Float = 0.0f,
+    val minAngle: Float = 15.0f,
+    val tileSize: Int = 64
+) {
+    private companion object {
+        init {
+            System.loadLibrary("pathway")
+        }
+    }
+
+    private val internalTracingSession: Long
+
+    init {
+        require(bitmap.config == Bitmap.Config.ARGB_8888) {
+            "The bitmap configuration must be ARGB_8888"
+        }
+        require(tileSize > 0) { "The tile size must be > 0: $tileSize" }
+
+        internalTracingSession = createInternalTracingSession(bitmap.width, bitmap.height, tileSize)
+        internalTracingSessionUpdate(
+            internalTracingSession, bitmap, alphaThreshold, 0, 0, bitmap.width, bitmap.height
+        )
+    }
+
+    /**
+     * Traces again the region of the bitmap defined by [left], [top], [right] (exclusive)
+     * and [bottom] (exclusive), after its pixels were modified, and returns the updated
+     * contours as a [Path].
+     */
+    fun update(left: Int, top: Int, right: Int, bottom: Int): Path {
+        check(
+            internalTracingSessionUpdate(
+                internalTracingSession, bitmap, alphaThreshold, left, top, right, bottom
+            )
+        ) { "The bitmap cannot be read, or its size or configuration changed" }
+        return toPath()
+    }
+
+    /**
+     * Traces again the region of the bitmap defined by [dirty], after its pixels were
+     * modified, and returns the updated contours as a [Path].
+     */
+    fun update(dirty: Rect): Path = update(dirty.left, dirty.top, dirty.right, dirty.bottom)
+
+    /**
+     * Returns the current contours of the bitmap as a [Path], see [Bitmap.toPath].
+     */
+    fun toPath(): Path = internalTracingSessionContours(internalTracingSession, minAngle).toPath()
+
+    /**
+     * Returns the current contours of the bitmap as a list of [Path], see [Bitmap.toPaths].
+     */
+    fun toPaths(): List<Path> =
+        internalTracingSessionContours(internalTracingSession, minAngle).toPaths()
+
+    protected fun finalize() {
+        if (internalTracingSession != 0L) destroyInternalTracingSession(internalTracingSession)
+    }
+}
+
+@FastNative
+private external fun createInternalTracingSession(width: Int, height: Int, tileSize: Int): Long
+
+@FastNative
+private external fun destroyInternalTracingSession(internalTracingSession: Long)
+
+private external fun internalTracingSessionUpdate(
+    internalTracingSession: Long,
+    bitmap: Bitmap,
+    alphaThreshold: Float,
+    left: Int,
+    top: Int,
+    right: Int,
+    bottom: Int
+): Boolean
+
+private external fun internalTracingSessionContours(
+    internalTracingSession: Long,
+    minAngle: Float
+): TracedContours